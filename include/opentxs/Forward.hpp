@@ -99,6 +99,7 @@ namespace network
 namespace zeromq
 {
 class Context;
+class DealerSocket;
 class ListenCallback;
 class Message;
 class PairSocket;
@@ -109,6 +110,7 @@ class PushSocket;
 class ReplyCallback;
 class ReplySocket;
 class RequestSocket;
+class RouterSocket;
 class Socket;
 class SubscribeSocket;
 }  // namespace opentxs::network::zeromq
@@ -121,6 +123,8 @@ class ZMQ;
 
 namespace server
 {
+class DividendCheckpoint;
+class DividendPayout;
 class MessageProcessor;
 class Server;
 }  // namespace opentxs::server
@@ -138,6 +142,7 @@ class MessagableList;
 }  // namespace opentxs::ui
 
 class Account;
+class AccountRegistry;
 class AccountVisitor;
 class AsymmetricKeyEC;
 class Basket;
@@ -162,6 +167,7 @@ class Data;
 class Ecdsa;
 class Flag;
 class Identifier;
+class IntervalSet;
 class Item;
 class Ledger;
 class Letter;
@@ -203,13 +209,16 @@ class OTSmartContract;
 class OTSymmetricKey;
 class OTTransaction;
 class OTWallet;
-class PayDividendVisitor;
 class PaymentCode;
 class PeerObject;
+class PrivateKeyCache;
 class Purse;
 class ServerContext;
 class ServerContract;
 class Signals;
+#if OT_CASH
+class SpentTokens;
+#endif  // OT_CASH
 class StorageDriver;
 class StoragePlugin;
 class String;
@@ -220,6 +229,8 @@ class Token;
 class TransactionStatement;
 class UnitDefinition;
 
+struct SignatureCheck;
+
 using OTData = Pimpl<Data>;
 using OTFlag = Pimpl<Flag>;
 using OTPaymentCode = Pimpl<PaymentCode>;
@@ -232,6 +243,7 @@ using OTUIContactList = Pimpl<ui::ContactList>;
 using OTUIContactListItem = Pimpl<ui::ContactListItem>;
 using OTUIMessagableList = Pimpl<ui::MessagableList>;
 using OTZMQContext = Pimpl<network::zeromq::Context>;
+using OTZMQDealerSocket = Pimpl<network::zeromq::DealerSocket>;
 using OTZMQListenCallback = Pimpl<network::zeromq::ListenCallback>;
 using OTZMQMessage = Pimpl<network::zeromq::Message>;
 using OTZMQPairSocket = Pimpl<network::zeromq::PairSocket>;
@@ -242,6 +254,7 @@ using OTZMQPushSocket = Pimpl<network::zeromq::PushSocket>;
 using OTZMQReplyCallback = Pimpl<network::zeromq::ReplyCallback>;
 using OTZMQReplySocket = Pimpl<network::zeromq::ReplySocket>;
 using OTZMQRequestSocket = Pimpl<network::zeromq::RequestSocket>;
+using OTZMQRouterSocket = Pimpl<network::zeromq::RouterSocket>;
 using OTZMQSubscribeSocket = Pimpl<network::zeromq::SubscribeSocket>;
 }  // namespace opentxs
 #endif  // OPENTXS_FORWARD_HPP
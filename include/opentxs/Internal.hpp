@@ -113,6 +113,7 @@ class OpenSSL;
 #endif
 class StorageConfig;
 class StorageMultiplex;
+class StorageThrottle;
 #if OT_CRYPTO_USING_TREZOR
 class TrezorCrypto;
 #endif
@@ -467,6 +467,8 @@ enum class SocketType : std::uint8_t {
     Push = 5,
     Pull = 6,
     Pair = 7,
+    Router = 8,
+    Dealer = 9,
 };
 
 enum class RemoteBoxType : std::int8_t {
@@ -475,6 +477,15 @@ enum class RemoteBoxType : std::int8_t {
     Inbox = 1,
     Outbox = 2,
 };
+
+// Values other than Automatic are zlib compression levels. Every level
+// produces a standard zlib stream which any version of OTASCIIArmor can read.
+enum class ArmorCompression : std::int8_t {
+    Automatic = -1,
+    Raw = 0,
+    Fast = 1,
+    Best = 9,
+};
 }  // namespace opentxs
 
 #endif  // OPENTXS_CORE_TYPES_HPP
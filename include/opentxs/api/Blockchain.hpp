@@ -50,6 +50,9 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -74,6 +77,15 @@ public:
         const Identifier& accountID,
         const std::string& label = "",
         const BIP44Chain chain = EXTERNAL_CHAIN) const;
+    /** Allocates count consecutive addresses on one chain of an account, for
+     *  example a gap limit window, and saves the account once. Returns an
+     *  empty vector if any of them can not be allocated. */
+    std::vector<proto::Bip44Address> AllocateAddresses(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const std::uint32_t count,
+        const std::string& label = "",
+        const BIP44Chain chain = EXTERNAL_CHAIN) const;
     bool AssignAddress(
         const Identifier& nymID,
         const Identifier& accountID,
@@ -107,6 +119,9 @@ public:
 
 private:
     typedef std::map<Identifier, std::mutex> IDLock;
+    /** Extended public key of one chain of an account */
+    struct ChainKey;
+    typedef std::pair<std::string, BIP44Chain> ChainKeyID;
 
     friend class implementation::Native;
 
@@ -117,17 +132,33 @@ private:
     mutable std::mutex lock_;
     mutable IDLock nym_lock_;
     mutable IDLock account_lock_;
+    mutable std::mutex chain_key_lock_;
+    mutable std::map<ChainKeyID, std::shared_ptr<const ChainKey>> chain_keys_;
+
     proto::Bip44Address& add_address(
         const std::uint32_t index,
         proto::Bip44Account& account,
         const BIP44Chain chain) const;
     std::uint8_t address_prefix(const proto::ContactItemType type) const;
-
+    bool allocate_addresses(
+        const Lock& lock,
+        proto::Bip44Account& account,
+        const std::uint32_t count,
+        const std::string& label,
+        const BIP44Chain chain,
+        std::vector<proto::Bip44Address>& output) const;
     Bip44Type bip44_type(const proto::ContactItemType type) const;
     std::string calculate_address(
+        const proto::ContactItemType type,
+        const Data& pubkey) const;
+    std::vector<std::string> calculate_addresses(
         const proto::Bip44Account& account,
         const BIP44Chain chain,
-        const std::uint32_t index) const;
+        const std::uint32_t first,
+        const std::uint32_t count) const;
+    std::shared_ptr<const ChainKey> chain_key(
+        const proto::Bip44Account& account,
+        const BIP44Chain chain) const;
     proto::Bip44Address& find_address(
         const std::uint32_t index,
         const BIP44Chain chain,
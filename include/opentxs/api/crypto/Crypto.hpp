@@ -48,6 +48,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace opentxs
 {
@@ -64,6 +65,8 @@ public:
         const OTCachedKey& source) const = 0;
     EXPORT virtual const OTCachedKey& LoadDefaultKey(
         const OTASCIIArmor& serialized) const = 0;
+    /** Decrypted private keys, which expire along with the master password */
+    EXPORT virtual const PrivateKeyCache& KeyCache() const = 0;
     EXPORT virtual void SetTimeout(
         const std::chrono::seconds& timeout) const = 0;
     EXPORT virtual void SetSystemKeyring(const bool useKeyring) const = 0;
@@ -101,6 +104,11 @@ public:
 
     EXPORT virtual std::unique_ptr<SymmetricKey> GetStorageKey(
         std::string& seed) const = 0;
+    /** Checks many signatures at once, spreading them across all cores. Each
+     *  item is verified by the engine of its key, so a batch may mix key
+     *  types. Returns one result per item, in order. */
+    EXPORT virtual std::vector<bool> VerifyBatch(
+        const std::vector<SignatureCheck>& batch) const = 0;
 
     EXPORT virtual ~Crypto() = default;
 
@@ -47,6 +47,11 @@
 
 namespace opentxs
 {
+namespace storage
+{
+class ObjectCache;
+}  // namespace storage
+
 namespace api
 {
 namespace storage
@@ -88,6 +93,24 @@ public:
     virtual bool StoreRoot(const bool commit, const std::string& hash)
         const = 0;
 
+    // Cache used by LoadProto, if any
+    virtual const opentxs::storage::ObjectCache* Cache() const
+    {
+        return nullptr;
+    }
+
+    // Index nodes are written through this method so that drivers which
+    // support write batches can hold superseded versions back
+    virtual bool StoreNode(const std::string& value, std::string& key) const
+    {
+        return Store(true, value, key);
+    }
+
+    // The driver which holds the data. Wrappers return the driver they
+    // forward to, so that Migrate can tell when it is copying an object
+    // between the buckets of a single driver
+    virtual const Driver& Target() const { return *this; }
+
     virtual ~Driver() = default;
 
     template <class T>
@@ -66,6 +66,14 @@ namespace storage
 class Storage
 {
 public:
+    /** Starts a write batch
+     *
+     *  Until the matching EndBatch call, index nodes which are modified
+     *  several times are only written in their final form and the root is
+     *  not committed. Batches may be nested, in which case the outermost
+     *  EndBatch commits.
+     */
+    virtual void BeginBatch() const = 0;
     virtual std::set<std::string> BlockchainAccountList(
         const std::string& nymID,
         const proto::ContactItemType type) const = 0;
@@ -85,6 +93,7 @@ public:
         const std::set<std::string>& participants) const = 0;
     virtual std::string DefaultSeed() const = 0;
     virtual bool DeleteContact(const std::string& id) const = 0;
+    virtual bool EndBatch() const = 0;
     virtual std::uint32_t HashType() const = 0;
     virtual ObjectList IssuerList(const std::string& nymID) const = 0;
     virtual bool Load(
@@ -191,6 +200,8 @@ public:
         const std::string& nymID,
         const StorageBox box) const = 0;
     virtual ObjectList NymList() const = 0;
+    virtual std::uint64_t ObjectCacheHits() const = 0;
+    virtual std::uint64_t ObjectCacheMisses() const = 0;
     virtual bool RelabelThread(
         const std::string& threadID,
         const std::string& label) const = 0;
@@ -295,6 +306,28 @@ private:
     Storage& operator=(const Storage&) = delete;
     Storage& operator=(Storage&&) = delete;
 };
+
+/** Keeps a write batch open for the lifetime of the object */
+class Batch
+{
+public:
+    explicit Batch(const Storage& storage)
+        : storage_(storage)
+    {
+        storage_.BeginBatch();
+    }
+
+    ~Batch() { storage_.EndBatch(); }
+
+private:
+    const Storage& storage_;
+
+    Batch() = delete;
+    Batch(const Batch&) = delete;
+    Batch(Batch&&) = delete;
+    Batch& operator=(const Batch&) = delete;
+    Batch& operator=(Batch&&) = delete;
+};
 }  // namespace storage
 }  // namespace api
 }  // namespace opentxs
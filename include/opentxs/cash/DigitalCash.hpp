@@ -78,6 +78,11 @@ public:
     ~LucreDumper();
 };
 
+/** Lucre writes its debug output to a single global BIO. It is set up once
+ *  per process, so that tokens can be signed and verified on several threads
+ *  without one thread replacing the BIO another is writing to. */
+void InstallLucreDumper();
+
 #endif
 
 #if OT_CASH_USING_MAGIC_MONEY
@@ -47,6 +47,9 @@
 #include <cstdint>
 #include <ctime>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace opentxs
 {
@@ -56,6 +59,9 @@ class OTASCIIArmor;
 class Token;
 
 typedef std::map<int64_t, OTASCIIArmor*> mapOfArmor;
+// An opened private mint, split across as many OTPassword buffers as it
+// takes to hold it.
+typedef std::vector<std::unique_ptr<OTPassword>> OTOpenedMint;
 
 class Mint : public Contract
 {
@@ -73,6 +79,11 @@ protected:
     // Encrypted.
     mapOfArmor m_mapPublic;  // An Ascii-armored string of the mint Public
                              // information. Base64-encoded only.
+    // The opened contents of m_mapPrivate. Each envelope is opened the first
+    // time its denomination is used, and kept until the denominations are
+    // released.
+    std::map<int64_t, std::shared_ptr<const OTOpenedMint>> m_mapOpened;
+    std::mutex m_lockOpened;
 
     Identifier m_NotaryID;     // The Notary ID, (a hash of the server contract
                                // whose public key is m_keyPublic)
@@ -187,6 +198,11 @@ public:
     // The denomination indicated here is the actual denomination...1, 5, 20,
     // 50, 100, etc
     bool GetPrivate(OTASCIIArmor& theArmor, int64_t lDenomination);
+    // Returns nullptr if the private mint for the denomination is missing or
+    // can not be opened by theNotary. Safe to call from several threads.
+    std::shared_ptr<const OTOpenedMint> GetOpenedPrivate(
+        const Nym& theNotary,
+        int64_t lDenomination);
     bool GetPublic(OTASCIIArmor& theArmor, int64_t lDenomination);
 
     int64_t GetDenomination(int32_t nIndex);
@@ -240,6 +256,15 @@ public:
         String& theOutput,
         int32_t nTokenIndex) = 0;
 
+    // Calls SignToken for every token, spread across several threads.
+    // theOutput receives one signature per token, and the return value
+    // reports which tokens were signed.
+    EXPORT std::vector<bool> SignTokens(
+        const Nym& theNotary,
+        const std::vector<Token*>& theTokens,
+        std::vector<String>& theOutput,
+        int32_t nTokenIndex);
+
     // step 4: (unblind coin is in Token)
 
     // Lucre step 5: mint verifies token when it is redeemed by merchant.
@@ -247,6 +272,13 @@ public:
         const Nym& theNotary,
         String& theCleartextToken,
         int64_t lDenomination) = 0;
+
+    // Calls VerifyToken for every token, spread across several threads.
+    // The return value reports which tokens verified.
+    EXPORT std::vector<bool> VerifyTokens(
+        const Nym& theNotary,
+        std::vector<String>& theCleartextTokens,
+        const std::vector<int64_t>& theDenominations);
 };
 }  // namespace opentxs
 #endif  // OT_CASH
@@ -0,0 +1,90 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CASH_SPENTTOKENS_HPP
+#define OPENTXS_CASH_SPENTTOKENS_HPP
+
+#include "opentxs/Forward.hpp"
+
+#if OT_CASH
+
+#include <cstdint>
+
+namespace opentxs
+{
+/** Persistent record of the cash tokens which have been deposited, kept
+ *  separately for each mint series.
+ *
+ *  Each series has a sorted index file of token hashes plus an append-only
+ *  log of the hashes recorded since the index was last rewritten. The log is
+ *  merged into the index once it grows past a threshold. An in-memory Bloom
+ *  filter covers both, so checking a token which was never spent normally
+ *  does not read either file.
+ *
+ *  Series which still have spent tokens stored as one file per token are
+ *  checked against those files too. */
+class SpentTokens
+{
+public:
+    /** Returns true if the token is recorded as spent. Also returns true if
+     *  the store for the series can not be read, since a false return means
+     *  the token may be accepted. */
+    EXPORT static bool Contains(
+        const Identifier& unitID,
+        const std::int32_t series,
+        const Identifier& token);
+    /** Deletes the store for a series. Only call this once every token of
+     *  the series has expired. Returns false if there was nothing to delete */
+    EXPORT static bool Expire(
+        const Identifier& unitID,
+        const std::int32_t series);
+    /** Records the token as spent. Checking and recording happen under one
+     *  lock, so exactly one of several concurrent calls for the same token
+     *  succeeds. Returns false if the token was already recorded or if it
+     *  could not be saved. */
+    EXPORT static bool Insert(
+        const Identifier& unitID,
+        const std::int32_t series,
+        const Identifier& token);
+
+private:
+    SpentTokens() = delete;
+};
+}  // namespace opentxs
+#endif  // OT_CASH
+#endif  // OPENTXS_CASH_SPENTTOKENS_HPP
@@ -83,7 +83,7 @@ public:
 
     bool AcceptIssuedNumbers(std::set<TransactionNumber>& newNumbers);
     bool CloseCronItem(const TransactionNumber number) override;
-    void FinishAcknowledgements(const std::set<RequestNumber>& req);
+    void FinishAcknowledgements(const IntervalSet& req);
     bool IssueNumber(const TransactionNumber& number);
     bool OpenCronItem(const TransactionNumber number) override;
 
@@ -44,6 +44,7 @@
 #include "opentxs/api/Editor.hpp"
 #include "opentxs/core/contract/Signable.hpp"
 #include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/IntervalSet.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
@@ -109,8 +110,8 @@ protected:
     std::mutex& nymfile_lock_;
     const Identifier server_id_{};
     std::shared_ptr<const class Nym> remote_nym_{};
-    std::set<TransactionNumber> available_transaction_numbers_{};
-    std::set<TransactionNumber> issued_transaction_numbers_{};
+    IntervalSet available_transaction_numbers_{};
+    IntervalSet issued_transaction_numbers_{};
     std::atomic<RequestNumber> request_number_{0};
     std::set<RequestNumber> acknowledged_request_numbers_{};
     Identifier local_nymbox_hash_{};
@@ -124,9 +125,7 @@ protected:
     virtual proto::Context serialize(const Lock& lock) const = 0;
 
     bool add_acknowledged_number(const Lock& lock, const RequestNumber req);
-    void finish_acknowledgements(
-        const Lock& lock,
-        const std::set<RequestNumber>& req);
+    void finish_acknowledgements(const Lock& lock, const IntervalSet& req);
     bool issue_number(const Lock& lock, const TransactionNumber& number);
     bool remove_acknowledged_number(
         const Lock& lock,
@@ -41,6 +41,7 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/IntervalSet.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/Types.hpp"
 
@@ -56,8 +57,9 @@ private:
     std::string version_;
     std::string nym_id_;
     std::string notary_;
-    std::set<TransactionNumber> available_;
-    std::set<TransactionNumber> issued_;
+    IntervalSet available_;
+    IntervalSet issued_;
+    bool valid_{true};
 
     TransactionStatement() = delete;
     TransactionStatement(const TransactionStatement& rhs) = delete;
@@ -74,8 +76,11 @@ public:
 
     explicit operator String() const;
 
-    const std::set<TransactionNumber>& Issued() const;
+    const IntervalSet& Issued() const;
     const std::string& Notary() const;
+    /** False if a number list in the serialized statement could not be
+     *  parsed */
+    bool Valid() const { return valid_; }
 
     void Remove(const TransactionNumber& number);
 
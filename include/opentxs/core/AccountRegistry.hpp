@@ -0,0 +1,113 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_ACCOUNTREGISTRY_HPP
+#define OPENTXS_CORE_ACCOUNTREGISTRY_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace opentxs
+{
+/** Persistent index of the accounts which exist for each unit definition.
+ *
+ *  The accounts of a unit are spread over a fixed number of string maps,
+ *  chosen by a hash of the account ID, so adding, removing or updating an
+ *  account rewrites one small bucket instead of the whole list. A second set
+ *  of buckets maps each account back to its unit.
+ *
+ *  The account count and total balance of a unit are calculated the first
+ *  time they are needed and then kept up to date as accounts change. Issuer
+ *  accounts are counted, but their (negative) balance is not included in the
+ *  total, so the total is the amount of the unit in circulation.
+ *
+ *  Balance updates are queued and written in batches, so saving an account
+ *  does not touch the registry files. Reads write the queue first. Up to one
+ *  batch of balances can be lost if the process stops without calling
+ *  Flush(), so the balances in the registry are a hint. Counts are always
+ *  exact, since adding and erasing accounts are written immediately.
+ *
+ *  A unit which still has an old style "<unit>.a" account list is imported
+ *  the first time it is used.
+ *
+ *  The registry keeps separate state for each data folder. */
+class AccountRegistry
+{
+public:
+    /** Called once for each account. Return false to stop visiting. */
+    using Visitor = std::function<
+        bool(const std::string& accountID, const std::int64_t balance)>;
+
+    EXPORT static bool Add(const Account& account);
+    EXPORT static bool Add(
+        const Identifier& unitID,
+        const Identifier& accountID,
+        const bool issuer,
+        const std::int64_t balance);
+    EXPORT static std::size_t Count(const Identifier& unitID);
+    EXPORT static bool Erase(
+        const Identifier& unitID,
+        const Identifier& accountID);
+    EXPORT static bool Exists(
+        const Identifier& unitID,
+        const Identifier& accountID);
+    /** Writes the queued balance updates */
+    EXPORT static bool Flush();
+    EXPORT static std::int64_t TotalBalance(const Identifier& unitID);
+    EXPORT static bool Unit(const Identifier& accountID, Identifier& unitID);
+    /** Queues the current balance of an account. Accounts which are not
+     *  registered are ignored when the queue is written. */
+    EXPORT static bool Update(const Account& account);
+    EXPORT static bool Update(
+        const Identifier& unitID,
+        const Identifier& accountID,
+        const bool issuer,
+        const std::int64_t balance);
+    /** Streams every account of the unit, one bucket at a time. The visitor
+     *  may add, update or erase accounts. */
+    EXPORT static bool Visit(const Identifier& unitID, const Visitor& visitor);
+
+private:
+    AccountRegistry() = delete;
+};
+}  // namespace opentxs
+
+#endif  // OPENTXS_CORE_ACCOUNTREGISTRY_HPP
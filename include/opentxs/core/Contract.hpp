@@ -54,6 +54,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace irr
 {
@@ -385,6 +386,12 @@ public:
     EXPORT virtual void CalculateContractID(Identifier& newID) const;
     EXPORT virtual void CalculateAndSetContractID(Identifier& newID);
 
+    /** Checks theNym's signature on every contract with one
+     *  api::Crypto::VerifyBatch() call. Returns one result per contract, the
+     *  same as calling VerifySignature(theNym) on each of them. */
+    EXPORT static std::vector<bool> VerifySignatures(
+        const std::vector<const Contract*>& contracts,
+        const Nym& theNym);
     /** So far not overridden anywhere (used to be OTTrade.) */
     EXPORT virtual bool VerifySignature(
         const Nym& theNym,
@@ -45,6 +45,7 @@
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 
@@ -67,6 +68,10 @@ private:
         const proto::ContactItemType type,
         const proto::HDPath& path);
 
+    /** Orders by type, then by digest bytes. Empty identifiers are equal
+     *  regardless of type, matching their (empty) encoded form. */
+    int compare(const Identifier& rhs) const;
+
 public:
     EXPORT friend std::ostream& operator<<(std::ostream& os, const String& obj);
     EXPORT static bool validateID(const std::string& strPurportedID);
@@ -118,4 +123,12 @@ public:
     EXPORT virtual ~Identifier() = default;
 };
 }  // namespace opentxs
+
+namespace std
+{
+template <>
+struct hash<opentxs::Identifier> {
+    EXPORT std::size_t operator()(const opentxs::Identifier& id) const;
+};
+}  // namespace std
 #endif  // OPENTXS_CORE_OTIDENTIFIER_HPP
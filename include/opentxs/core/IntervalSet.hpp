@@ -0,0 +1,153 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_INTERVALSET_HPP
+#define OPENTXS_CORE_INTERVALSET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace opentxs
+{
+/** A set of integers stored as disjoint, non-adjacent closed ranges.
+ *
+ *  Mostly contiguous sets, such as the transaction numbers issued to a Nym,
+ *  take space proportional to the number of gaps instead of the number of
+ *  elements. The lower case methods follow std::set so that an IntervalSet
+ *  can be used in its place. */
+class IntervalSet
+{
+public:
+    using value_type = std::int64_t;
+    /** Maps the first element of each range to its last element */
+    using Map = std::map<value_type, value_type>;
+
+    /** Visits each element in ascending order */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = IntervalSet::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        reference operator*() const { return value_; }
+        pointer operator->() const { return &value_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator& rhs) const;
+        bool operator!=(const const_iterator& rhs) const;
+
+        const_iterator() = default;
+
+    private:
+        friend class IntervalSet;
+
+        const Map* ranges_{nullptr};
+        Map::const_iterator range_{};
+        value_type value_{0};
+
+        const_iterator(
+            const Map* ranges,
+            const Map::const_iterator range,
+            const value_type value);
+    };
+
+    using iterator = const_iterator;
+
+    /** Parses a comma or whitespace separated list of numbers and ranges in
+     *  the form "first-last", as produced by Encode(). Plain lists of numbers
+     *  written by older versions are accepted unchanged.
+     *
+     *  Lists received from a peer should be decoded with allowRanges set to
+     *  false, so that a few bytes of input can not describe an arbitrarily
+     *  large set. */
+    EXPORT static bool Decode(
+        const std::string& encoded,
+        IntervalSet& output,
+        const bool allowRanges = true);
+
+    EXPORT const_iterator begin() const;
+    EXPORT void clear();
+    EXPORT std::size_t count(const value_type value) const;
+    EXPORT bool empty() const { return ranges_.empty(); }
+    EXPORT const_iterator end() const;
+    EXPORT std::size_t erase(const value_type value);
+    EXPORT const_iterator find(const value_type value) const;
+    EXPORT std::pair<const_iterator, bool> insert(const value_type value);
+    EXPORT std::size_t size() const { return size_; }
+
+    /** Comma-separated list of ranges, for example "5-1000,1003" */
+    EXPORT std::string Encode() const;
+    /** Adds every element of [first, last]. Returns how many were new. */
+    EXPORT std::size_t InsertRange(
+        const value_type first,
+        const value_type last);
+    EXPORT const Map& Ranges() const { return ranges_; }
+    EXPORT std::set<value_type> Set() const;
+
+    EXPORT bool operator==(const IntervalSet& rhs) const;
+    EXPORT bool operator!=(const IntervalSet& rhs) const;
+
+    EXPORT IntervalSet() = default;
+    EXPORT explicit IntervalSet(const std::set<value_type>& values);
+    EXPORT IntervalSet(const IntervalSet&) = default;
+    EXPORT IntervalSet(IntervalSet&&) = default;
+    EXPORT IntervalSet& operator=(const IntervalSet&) = default;
+    EXPORT IntervalSet& operator=(IntervalSet&&) = default;
+
+    EXPORT ~IntervalSet() = default;
+
+private:
+    Map ranges_{};
+    std::size_t size_{0};
+
+    Map::iterator containing(const value_type value);
+    Map::const_iterator containing(const value_type value) const;
+};
+}  // namespace opentxs
+
+#endif  // OPENTXS_CORE_INTERVALSET_HPP
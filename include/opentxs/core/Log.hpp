@@ -48,7 +48,10 @@
 #include <cstdint>
 #include <deque>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 #if defined(unix) || defined(__unix__) || defined(__unix) ||                   \
@@ -96,24 +99,36 @@ OTLOG_IMPORT extern OTLogStream otLog3;  // logs using OTLog::vOutput(3)
 OTLOG_IMPORT extern OTLogStream otLog4;  // logs using OTLog::vOutput(4)
 OTLOG_IMPORT extern OTLogStream otLog5;  // logs using OTLog::vOutput(5)
 
+/** Each thread accumulates its own partial line for every stream, so
+ * concurrent writers never contend until a complete line is handed to the
+ * background writer. A stream whose level is above the current log level is
+ * placed in the bad state, which causes the ostream operators to skip
+ * formatting entirely. */
 class OTLogStream : public std::ostream, std::streambuf
 {
 private:
+    friend class Log;
+
     int logLevel{0};
-    int next{0};
-    char* pBuffer{nullptr};
-    std::recursive_mutex lock_;
+
+    bool enabled(const std::int32_t level) const;
+    void emit(std::string& line) const;
+    void update(const std::int32_t level);
 
 public:
     explicit OTLogStream(int _logLevel);
-    ~OTLogStream();
+    ~OTLogStream() = default;
 
     virtual int overflow(int c) override;
+    virtual std::streamsize xsputn(const char* s, std::streamsize count)
+        override;
 };
 
 class Log
 {
 private:
+    class Writer;
+
     static Log* pLogger;
     static const String m_strVersion;
     static const String m_strPathSeparator;
@@ -122,11 +137,19 @@ private:
     std::int32_t m_nLogLevel{0};
     bool m_bInitialized{false};
     bool write_log_file_{false};
+    bool write_json_{false};
     String m_strThreadContext{""};
     String m_strLogFileName{""};
     String m_strLogFilePath{""};
     dequeOfStrings logDeque{};
     std::recursive_mutex lock_;
+    std::unique_ptr<Writer> writer_;
+
+    static std::string format_record(
+        const std::int32_t nVerbosity,
+        const std::string& event,
+        const std::map<std::string, std::string>& fields);
+    static void update_streams(const std::int32_t nLogLevel);
 
     /** For things that represent internal inconsistency in the code. Normally
      * should NEVER happen even with bad input from user. (Don't call this
@@ -140,6 +163,7 @@ private:
     Log(Log&&) = delete;
     Log& operator=(const Log&) = delete;
     Log& operator=(Log&&) = delete;
+    ~Log();
 
 public:
     /** now the logger checks the global config file itself for the
@@ -206,6 +230,16 @@ public:
     EXPORT static void vOutput(int32_t nVerbosity, const char* szOutput, ...)
         ATTR_PRINTF(2, 3);
 
+    /** Record() logs a structured event at the given verbosity. The fields are
+     * written as key=value pairs, or as a single JSON object if log_json is
+     * enabled in the logging section of the config file. Nothing is formatted
+     * unless the verbosity passes the current log level. Negative verbosity
+     * logs as an error. */
+    EXPORT static void Record(
+        const std::int32_t nVerbosity,
+        const std::string& event,
+        const std::map<std::string, std::string>& fields);
+
     /** This logs an error condition, which usually means bad input from the
      * user, or a file wouldn't open, or something like that. This contrasted
      * with Assert() which should NEVER actually happen. The software expects
@@ -41,6 +41,8 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/IntervalSet.hpp"
+
 #include <cstdint>
 #include <set>
 #include <string>
@@ -52,23 +54,30 @@ class OTAsymmetricKey;
 class OTPasswordData;
 class String;
 
-/** Useful for storing a std::set of longs, serializing to/from comma-separated
+/** Useful for storing a set of longs, serializing to/from comma-separated
  * string, And easily being able to add/remove/verify the individual transaction
  * numbers that are there. (Used by OTTransaction::blank and
  * OTTransaction::successNotice.) Also used in OTMessage, for storing lists of
- * acknowledged request numbers. */
+ * acknowledged request numbers. Contiguous runs of numbers are stored as
+ * ranges.
+ *
+ * Add() and Output() use a plain list, which is what goes over the wire: a
+ * peer could otherwise send "1-9223372036854775806". The range form
+ * ("5-1000,1003") is only read and written by AddRanges() and OutputRanges(),
+ * for lists that never leave local storage. */
 class NumList
 {
-    std::set<int64_t> m_setData;
+    IntervalSet m_setData;
 
     /** private for security reasons, used internally only by a function that
      * knows the string length already. if false, means the numbers were already
      * there. (At least one of them.) */
-    bool Add(const char* szfNumbers);
+    bool Add(const char* szfNumbers, const bool allowRanges);
 
 public:
     explicit EXPORT NumList(const std::set<int64_t>& theNumbers);
     explicit EXPORT NumList(std::set<int64_t>&& theNumbers);
+    explicit EXPORT NumList(const IntervalSet& theNumbers);
     explicit EXPORT NumList(const String& strNumbers);
     explicit EXPORT NumList(const std::string& strNumbers);
     explicit EXPORT NumList(int64_t lInput);
@@ -83,6 +92,10 @@ public:
      */
     EXPORT bool Add(const std::string& strNumbers);
 
+    /** Same as Add(), but also accepts ranges. Only for lists written by
+     * OutputRanges(). */
+    EXPORT bool AddRanges(const String& strNumbers);
+
     /** if false, means the value was already there. */
     EXPORT bool Add(const int64_t& theValue);
 
@@ -117,7 +130,7 @@ public:
 
     /** Verify whether ANY of the numbers on *this are found in setData. */
     EXPORT bool VerifyAny(const std::set<int64_t>& setData) const;
-    EXPORT int32_t Count() const;
+    EXPORT int64_t Count() const;
     EXPORT bool Peek(int64_t& lPeek) const;
     EXPORT bool Pop();
 
@@ -128,6 +141,11 @@ public:
     /** Outputs the numlist as a comma-separated string (for serialization,
      * usually.) returns false if the numlist was empty. */
     EXPORT bool Output(String& strOutput) const;
+
+    /** Outputs the numlist with contiguous numbers collapsed into ranges, for
+     * local storage. returns false if the numlist was empty. */
+    EXPORT bool OutputRanges(String& strOutput) const;
+    EXPORT const IntervalSet& Numbers() const { return m_setData; }
     EXPORT void Release();
 };
 
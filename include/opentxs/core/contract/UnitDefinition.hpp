@@ -42,6 +42,7 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/core/contract/Signable.hpp"
+#include "opentxs/core/AccountRegistry.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/String.hpp"
@@ -127,6 +128,9 @@ public:
     EXPORT bool EraseAccountRecord(const Identifier& theAcctID) const;
 
     EXPORT bool VisitAccountRecords(AccountVisitor& visitor) const;
+    // Streams the ID and balance of every account on the list.
+    EXPORT bool VisitAccountRecords(
+        const AccountRegistry::Visitor& visitor) const;
 
     EXPORT static std::string formatLongAmount(
         int64_t lValue,
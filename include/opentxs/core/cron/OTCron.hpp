@@ -46,6 +46,8 @@
 #include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
 
+#include <mutex>
+
 namespace opentxs
 {
 
@@ -57,6 +59,8 @@ class Nym;
 typedef std::map<int64_t, OTCronItem*> mapOfCronItems;
 /** multimapOfCronItems: Mapped to date the item was added to Cron. */
 typedef std::multimap<time64_t, OTCronItem*> multimapOfCronItems;
+/** Transaction numbers of cron items, mapped to the time each is next due. */
+typedef std::multimap<time64_t, int64_t> multimapOfCronSchedule;
 /** Mapped (uniquely) to market ID. */
 typedef std::map<std::string, OTMarket*> mapOfMarkets;
 /** Cron stores a bunch of these on this list, which the server refreshes from
@@ -76,6 +80,11 @@ private:
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
+    // Only the items at the front of the schedule are visited by each call to
+    // ProcessCronItems. Entries belonging to removed items are discarded when
+    // they come due.
+    multimapOfCronSchedule m_multimapSchedule;
+    mutable std::mutex m_lockSchedule;
     // Always store this in any object that's associated with a specific server.
     Identifier m_NOTARY_ID;
     // I can't put receipts in people's inboxes without a supply of these.
@@ -96,6 +105,10 @@ private:
 
     static Timer tCron;
 
+    time64_t next_due(const OTCronItem& item, const time64_t now) const;
+    void schedule(const int64_t lTransactionNum, const time64_t due);
+    int64_t take_due_item(const time64_t now);
+
 public:
     static int32_t GetCronMsBetweenProcess()
     {
@@ -173,6 +186,9 @@ public:
      * finished.) */
     EXPORT void ProcessCronItems();
 
+    /** Milliseconds until the next cron item is due to be processed,
+     * respecting the minimum interval between rounds. Returns a value <= 0 if
+     * ProcessCronItems should be called now. */
     int64_t computeTimeout();
 
     inline void SetNotaryID(const Identifier& NOTARY_ID)
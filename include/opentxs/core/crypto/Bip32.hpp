@@ -73,7 +73,30 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         proto::HDPath& path) const = 0;
+    /** Derives the node at path and returns only its public half: the public
+     *  key and the chain code. */
+    virtual bool GetHDPublicNode(
+        const EcdsaCurve& curve,
+        const OTPassword& seed,
+        proto::HDPath& path,
+        Data& publicKey,
+        OTPassword& chainCode) const = 0;
+    /** Derives a child public key from a parent public key and chain code,
+     *  without any private key. Fails for hardened indices. */
+    virtual bool GetPublicChild(
+        const EcdsaCurve& curve,
+        const Data& parentKey,
+        const OTPassword& parentChainCode,
+        const std::uint32_t index,
+        Data& childKey) const = 0;
 
+    /** Public key and chain code of the internal or external chain of an
+     *  account. Every address key on that chain can be derived from them. */
+    bool AccountChainKey(
+        const proto::HDPath& path,
+        const BIP44Chain internal,
+        Data& publicKey,
+        OTPassword& chainCode) const;
     serializedAsymmetricKey AccountChildKey(
         const proto::HDPath& path,
         const BIP44Chain internal,
@@ -58,6 +58,15 @@ class OTSignature;
 
 typedef std::multimap<std::string, OTAsymmetricKey*> mapOfAsymmetricKeys;
 
+/** One signature to be checked by api::Crypto::VerifyBatch(). The referenced
+ *  objects must outlive the call. */
+struct SignatureCheck {
+    const Data* plaintext_{nullptr};
+    const OTAsymmetricKey* key_{nullptr};
+    const Data* signature_{nullptr};
+    proto::HashType hash_type_{proto::HASHTYPE_ERROR};
+};
+
 class CryptoAsymmetric
 {
 
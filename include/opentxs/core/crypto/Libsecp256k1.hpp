@@ -51,6 +51,10 @@
 #include "opentxs/core/crypto/OTPasswordData.hpp"
 #include "opentxs/Proto.hpp"
 
+#include <map>
+#include <mutex>
+#include <string>
+
 extern "C" {
 #include "secp256k1.h"
 }
@@ -88,6 +92,9 @@ private:
     secp256k1_context* context_{nullptr};
     Ecdsa& ecdsa_;
     api::crypto::Util& ssl_;
+    mutable std::mutex pubkey_lock_;
+    // Parsed public keys, indexed by their serialized form
+    mutable std::map<std::string, secp256k1_pubkey> pubkeys_;
 
     bool ParsePublicKey(const Data& input, secp256k1_pubkey& output) const;
     void Init_Override() const override;
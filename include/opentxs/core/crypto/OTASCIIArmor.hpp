@@ -42,6 +42,7 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/core/String.hpp"
+#include "opentxs/Types.hpp"
 
 #include <stdint.h>
 #include <iosfwd>
@@ -49,6 +50,9 @@
 #include <memory>
 #include <string>
 
+// Below this size deflate costs more than it saves
+#define OT_ARMOR_RAW_THRESHOLD 128
+
 namespace opentxs
 {
 
@@ -175,12 +179,18 @@ public:
     EXPORT bool SetData(const Data& theData, bool bLineBreaks = true);
 
     EXPORT bool GetString(String& theData, bool bLineBreaks = true) const;
-    EXPORT bool SetString(const String& theData, bool bLineBreaks = true);
+    /** Automatic compression stores payloads smaller than
+     * OT_ARMOR_RAW_THRESHOLD without deflating them, and uses the best
+     * compression otherwise. */
+    EXPORT bool SetString(
+        const String& theData,
+        bool bLineBreaks = true,
+        ArmorCompression compression = ArmorCompression::Automatic);
 
 private:
     std::string compress_string(
         const std::string& str,
-        int32_t compressionlevel) const;
+        ArmorCompression compression) const;
     std::string decompress_string(const std::string& str) const;
 
     static std::unique_ptr<OTDB::OTPacker> s_pPacker;
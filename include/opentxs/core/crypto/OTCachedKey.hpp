@@ -247,7 +247,13 @@ private:
     /** Encrypted form of the master key. Serialized by OTWallet or Server. */
     mutable std::unique_ptr<OTSymmetricKey> key_;
     mutable String secret_id_{""};
+    /** Decrypted private keys, cleared along with the master password. Only
+     * set on the default key, by api::Crypto, which outlives it. */
+    const PrivateKeyCache* private_keys_{nullptr};
 
+    /** Destroys the cleartext master password, if present, and with it every
+     * private key that was decrypted while it was available. */
+    void clear_master_password(const Lock& lock) const;
     void release_thread() const;
     /** The cleartext version (m_pMasterPassword) is deleted and set nullptr
      * after a Timer of X seconds. (Timer thread calls this.) The INSTANCE that
@@ -0,0 +1,114 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_PRIVATEKEYCACHE_HPP
+#define OPENTXS_CORE_CRYPTO_PRIVATEKEYCACHE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace opentxs
+{
+// Size bounded cache of decrypted private keys
+//
+// Decrypting a private key derives its symmetric key from the master password
+// with a deliberately slow KDF, which dominates the cost of signing. Entries
+// are keyed by the encrypted form of the key and held in OTPassword instances,
+// so the plaintext lives in locked memory and is zeroed when an entry is
+// evicted, expires, or the cache is cleared.
+//
+// Entries expire after the same period of disuse as the master password. A
+// timeout of -1 never expires entries and a timeout of 0 disables caching.
+// The default OTCachedKey also clears the cache whenever it destroys the
+// master password, so no key stays usable after the wallet is locked.
+class PrivateKeyCache
+{
+public:
+    std::uint64_t Hits() const { return hits_.load(); }
+    std::uint64_t Misses() const { return misses_.load(); }
+
+    void Add(const proto::Ciphertext& encrypted, const OTPassword& plaintext)
+        const;
+    void Clear() const;
+    bool Get(const proto::Ciphertext& encrypted, OTPassword& plaintext) const;
+    void SetTimeout(const std::chrono::seconds& timeout) const;
+
+    PrivateKeyCache(
+        const std::size_t limit,
+        const std::chrono::seconds& timeout);
+
+    ~PrivateKeyCache();
+
+private:
+    typedef std::chrono::steady_clock::time_point Time;
+    typedef std::tuple<std::string, std::unique_ptr<OTPassword>, Time> Entry;
+    typedef std::list<Entry> LRU;
+
+    const std::size_t limit_{0};
+    mutable std::atomic<std::int64_t> timeout_{0};
+    mutable std::mutex lock_;
+    mutable LRU lru_;
+    mutable std::map<std::string, LRU::iterator> index_;
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+
+    static std::string key(const proto::Ciphertext& encrypted);
+
+    bool expired(const Time& used, const Time& now) const;
+    void trim(const Lock& lock, const Time& now) const;
+
+    PrivateKeyCache() = delete;
+    PrivateKeyCache(const PrivateKeyCache&) = delete;
+    PrivateKeyCache(PrivateKeyCache&&) = delete;
+    PrivateKeyCache& operator=(const PrivateKeyCache&) = delete;
+    PrivateKeyCache& operator=(PrivateKeyCache&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_PRIVATEKEYCACHE_HPP
@@ -169,6 +169,18 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         proto::HDPath& path) const override;
+    bool GetHDPublicNode(
+        const EcdsaCurve& curve,
+        const OTPassword& seed,
+        proto::HDPath& path,
+        Data& publicKey,
+        OTPassword& chainCode) const override;
+    bool GetPublicChild(
+        const EcdsaCurve& curve,
+        const Data& parentKey,
+        const OTPassword& parentChainCode,
+        const std::uint32_t index,
+        Data& childKey) const override;
     bool RandomKeypair(OTPassword& privateKey, Data& publicKey) const override;
     std::string SeedToFingerprint(
         const EcdsaCurve& curve,
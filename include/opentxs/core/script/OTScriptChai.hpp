@@ -44,6 +44,9 @@
 #if OT_SCRIPT_CHAI
 #include "opentxs/core/script/OTScript.hpp"
 
+#include <cstddef>
+#include <memory>
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4702)  // warning C4702: unreachable code
@@ -63,9 +66,25 @@ class ChaiScript;
 namespace opentxs
 {
 
+class ChaiEngine;
+class OTScriptable;
+class OTSmartContract;
+
+/** Engines are borrowed from a pool rather than constructed per script.
+ *  Each pooled engine has the ChaiScript prelude loaded, the OTParty type
+ *  and the OT native calls registered; the native calls act on whichever objects were bound
+ *  with SetScriptable / SetSmartContract. When the script is destroyed the
+ *  engine is returned to the pool with its variables and globals reset. */
 class OTScriptChai : public OTScript
 {
+private:
+    std::unique_ptr<ChaiEngine> engine_;
+
 public:
+    /** Creates engines in advance so that the first clauses executed do not
+     *  pay for engine construction */
+    EXPORT static void Preload(const std::size_t count);
+
     OTScriptChai();
     OTScriptChai(const String& strValue);
     OTScriptChai(const char* new_string);
@@ -75,6 +94,9 @@ public:
     virtual ~OTScriptChai();
 
     bool ExecuteScript(OTVariable* pReturnVar = nullptr) override;
+    void SetScriptable(OTScriptable& scriptable);
+    void SetSmartContract(OTSmartContract& contract);
+
     chaiscript::ChaiScript* const chai_{nullptr};
 };
 }  // namespace opentxs
@@ -0,0 +1,61 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_UTIL_PARALLEL_HPP
+#define OPENTXS_CORE_UTIL_PARALLEL_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace opentxs
+{
+/** Calls job(i) for every i in [0, count)
+ *
+ *  The indices are shared out between the calling thread and up to one
+ *  worker thread per additional core, with one thread per perThread indices.
+ *  Returns once every job has finished. Jobs run concurrently, so each must
+ *  only write to state belonging to its own index.
+ */
+EXPORT void Parallel(
+    const std::size_t count,
+    const std::size_t perThread,
+    const std::function<void(const std::size_t)>& job);
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_UTIL_PARALLEL_HPP
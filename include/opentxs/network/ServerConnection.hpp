@@ -44,6 +44,7 @@
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
+#include <future>
 #include <string>
 
 namespace opentxs::network
@@ -61,6 +62,13 @@ public:
     EXPORT virtual NetworkReplyRaw Send(const std::string& message) = 0;
     EXPORT virtual NetworkReplyString Send(const String& message) = 0;
     EXPORT virtual NetworkReplyMessage Send(const Message& message) = 0;
+    /** Queues a request without waiting for the previous one to be answered.
+     *  Up to a fixed number of requests are in flight at once and the rest
+     *  are sent in order as replies arrive. */
+    EXPORT virtual std::future<NetworkReplyRaw> SendAsync(
+        const std::string& message) = 0;
+    EXPORT virtual std::future<NetworkReplyMessage> SendAsync(
+        const Message& message) = 0;
     EXPORT virtual bool Status() const = 0;
 
     virtual ~ServerConnection() = default;
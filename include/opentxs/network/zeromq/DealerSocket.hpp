@@ -0,0 +1,112 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
+#define OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/network/zeromq/Socket.hpp"
+
+#ifdef SWIG
+// clang-format off
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator+=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator==;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator!=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator<;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator<=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator>;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator>=;
+%template(OTZMQDealerSocket) opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>;
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::Factory.*";
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::ReceiveReply.*";
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::SetCurve.*";
+%rename(ZMQDealerSocket) opentxs::network::zeromq::DealerSocket;
+// clang-format on
+#endif  // SWIG
+
+namespace opentxs
+{
+namespace network
+{
+namespace zeromq
+{
+/** Asynchronous request socket. When client is true every call to Start()
+ *  connects to an additional endpoint and outgoing messages are distributed
+ *  round-robin among the connected peers. */
+class DealerSocket : virtual public Socket
+{
+public:
+    EXPORT static OTZMQDealerSocket Factory(
+        const class Context& context,
+        const bool client);
+
+    /** Waits up to timeout for a reply to a message sent via SendRequest().
+     *  Returns false if nothing arrived or the reply was not enveloped. */
+    EXPORT virtual bool ReceiveReply(
+        const std::chrono::milliseconds& timeout,
+        std::string& id,
+        std::string& reply) const = 0;
+    /** Sends [id][empty delimiter][message]. A REP peer strips the envelope
+     *  and returns it around the reply, so many requests may be in flight
+     *  at once and replies are matched to them by id. */
+    EXPORT virtual bool SendRequest(
+        const std::string& id,
+        const std::string& message) const = 0;
+    EXPORT virtual bool SetCurve(const ServerContract& contract) const = 0;
+    EXPORT virtual bool SetSocksProxy(const std::string& proxy) const = 0;
+
+    EXPORT virtual ~DealerSocket() = default;
+
+protected:
+    EXPORT DealerSocket() = default;
+
+private:
+    friend OTZMQDealerSocket;
+
+    virtual DealerSocket* clone() const = 0;
+
+    DealerSocket(const DealerSocket&) = delete;
+    DealerSocket(DealerSocket&&) = default;
+    DealerSocket& operator=(const DealerSocket&) = delete;
+    DealerSocket& operator=(DealerSocket&&) = default;
+};
+}  // namespace zeromq
+}  // namespace network
+}  // namespace opentxs
+#endif  // OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
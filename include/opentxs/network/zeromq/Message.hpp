@@ -48,6 +48,7 @@ struct zmq_msg_t;
 #ifdef SWIG
 // clang-format off
 %ignore opentxs::network::zeromq::Message::operator zmq_msg_t*();
+%ignore opentxs::network::zeromq::Message::Factory(std::string&&);
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::operator+=;
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::operator==;
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::operator!=;
@@ -75,6 +76,9 @@ public:
         const opentxs::Data& input);
     EXPORT static Pimpl<opentxs::network::zeromq::Message> Factory(
         const std::string& input);
+    /** Takes ownership of the string's buffer instead of copying it */
+    EXPORT static Pimpl<opentxs::network::zeromq::Message> Factory(
+        std::string&& input);
 
     EXPORT virtual operator std::string() const = 0;
 
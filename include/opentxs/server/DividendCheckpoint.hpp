@@ -0,0 +1,158 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_DIVIDENDCHECKPOINT_HPP
+#define OPENTXS_SERVER_DIVIDENDCHECKPOINT_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+namespace server
+{
+/** The stored progress of one dividend payout.
+ *
+ *  A checkpoint is kept in three parts, so that saving progress costs the
+ *  size of one batch rather than the size of the whole payout:
+ *
+ *  - A header with the parameters of the payout, whether it has been
+ *    planned, and the leftover payment. It is small and rarely rewritten.
+ *  - The plan, which lists the amount owed to each recipient. It is written
+ *    once, when planning is finished.
+ *  - One file per batch of payments, holding the voucher number and state of
+ *    each payment in that batch. Only the batch being paid is rewritten.
+ *
+ *  Batches are cut from the plan in recipient order, so the same payments
+ *  fall in the same batch after a restart.
+ *
+ *  Every payout which has been started is listed in an index, so it can be
+ *  resumed after a restart. */
+class DividendCheckpoint
+{
+public:
+    enum class State : char {
+        Planned = 'n',
+        Pending = 'p',
+        Paid = 's',
+        Undelivered = 'u',
+        Returned = 'r',
+    };
+
+    struct Payment {
+        std::int64_t amount_{0};
+        TransactionNumber number_{0};
+        State state_{State::Planned};
+    };
+
+    /** Keyed by recipient Nym ID */
+    using Plan = std::map<std::string, Payment>;
+    using Batch = std::vector<Plan::value_type*>;
+    using Parameters = std::map<std::string, std::string>;
+
+    /** Returns the payouts in the index, mapped to their share unit */
+    EXPORT static std::map<TransactionNumber, std::string> List(
+        const Identifier& notaryID);
+
+    /** Available after SavePlan or a Load of a planned payout */
+    EXPORT const std::vector<Batch>& Batches() const { return batches_; }
+    EXPORT const Payment& Leftover() const { return leftover_; }
+    EXPORT Payment& Leftover() { return leftover_; }
+    EXPORT const Parameters& Params() const { return parameters_; }
+    EXPORT const Plan& Payments() const { return plan_; }
+    EXPORT Plan& Payments() { return plan_; }
+    EXPORT bool Planned() const { return planned_; }
+
+    /** Removes every part of the checkpoint and its index entry */
+    EXPORT bool Erase() const;
+    /** Returns true if a header was saved for the payout */
+    EXPORT bool Exists() const;
+    /** Adds the payout to the index */
+    EXPORT bool Index(const Identifier& sharesUnitID) const;
+    /** Loads the header, the plan and every batch which has been started */
+    EXPORT bool Load();
+    /** Loads only the parameters, the planned flag and the leftover */
+    EXPORT bool LoadHeader();
+    EXPORT bool SaveBatch(const std::size_t index) const;
+    EXPORT bool SaveHeader() const;
+    /** Marks the payout as planned, cuts the plan into batches and saves the
+     *  plan and header */
+    EXPORT bool SavePlan();
+
+    EXPORT DividendCheckpoint(
+        const Identifier& notaryID,
+        const TransactionNumber number,
+        const Parameters& parameters = {});
+
+    EXPORT ~DividendCheckpoint() = default;
+
+private:
+    const std::string notary_id_;
+    const TransactionNumber number_{0};
+    Parameters parameters_{};
+    bool planned_{false};
+    Plan plan_{};
+    std::vector<Batch> batches_{};
+    Payment leftover_{};
+
+    static bool decode(const std::string& input, Payment& payment);
+    static std::string encode(const Payment& payment);
+
+    std::string batch_name(const std::size_t index) const;
+    bool erase(const std::string& name) const;
+    bool exists(const std::string& name) const;
+    std::string header_name() const;
+    std::string plan_name() const;
+    void make_batches();
+
+    DividendCheckpoint() = delete;
+    DividendCheckpoint(const DividendCheckpoint&) = delete;
+    DividendCheckpoint(DividendCheckpoint&&) = delete;
+    DividendCheckpoint& operator=(const DividendCheckpoint&) = delete;
+    DividendCheckpoint& operator=(DividendCheckpoint&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+
+#endif  // OPENTXS_SERVER_DIVIDENDCHECKPOINT_HPP
@@ -0,0 +1,207 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_DIVIDENDPAYOUT_HPP
+#define OPENTXS_SERVER_DIVIDENDPAYOUT_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/AccountVisitor.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/DividendCheckpoint.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+namespace server
+{
+/** Pays a dividend to every owner of a share unit.
+ *
+ *  Shareholder accounts are loaded in parallel. The shares of every account
+ *  owned by the same Nym are added up, and that Nym receives one voucher
+ *  for all of them, rather than one voucher per account.
+ *
+ *  Payments are made in batches. The voucher numbers of a batch are
+ *  checkpointed before any voucher in it is sent, and the outcome is
+ *  checkpointed after. If the server stops part way through, Resume()
+ *  finishes the payout from the checkpoint. A voucher which is sent again
+ *  carries the same transaction number, which can only be deposited once,
+ *  so nobody is paid twice.
+ *
+ *  Vouchers are signed and delivered one at a time, since they are all
+ *  signed by the server nym.
+ *
+ *  The payer receives a message in their nymbox each time another quarter
+ *  of the shareholders has been paid, and a summary when the payout is
+ *  finished. */
+class DividendPayout
+{
+public:
+    /** Called after each batch with the number of shareholders handled so
+     *  far and the total number of shareholders */
+    using Progress =
+        std::function<void(const std::size_t done, const std::size_t total)>;
+
+    /** The notary operations a payout uses. Constructing a payout from a
+     *  Server uses the server's own. */
+    class Services
+    {
+    public:
+        virtual const Identifier& NotaryID() const = 0;
+        /** Issues a transaction number to the server nym */
+        virtual bool IssueNumber(TransactionNumber& number) const = 0;
+        /** Sends a message to the nymbox of nymID */
+        virtual void Notify(const Identifier& nymID, const std::string& text)
+            const = 0;
+        /** Issues a voucher drawn on voucherAccountID and delivers it to
+         *  recipient */
+        virtual bool Pay(
+            const Identifier& recipient,
+            const Identifier& unitID,
+            const Identifier& voucherAccountID,
+            const String& memo,
+            const std::int64_t amount,
+            const TransactionNumber number) const = 0;
+        virtual std::shared_ptr<const UnitDefinition> Unit(
+            const Identifier& unitID) const = 0;
+
+        virtual ~Services() = default;
+    };
+
+    /** Finishes any payouts interrupted by a restart */
+    static void Resume(Server& server);
+    EXPORT static void Resume(const Services& services);
+
+    std::int64_t AmountPaidOut() const;
+    std::int64_t AmountReturned() const;
+    std::int64_t AmountLeftOver() const;
+
+    /** Pays all shareholders, returns undeliverable payments and leftover
+     *  funds to the payer, and then removes the checkpoint. Returns false if
+     *  any voucher could not be issued or delivered. */
+    bool Run(
+        const UnitDefinition& shares,
+        mapOfAccounts* loadedAccounts = nullptr,
+        const Progress& progress = {});
+
+    DividendPayout(
+        Server& server,
+        const Identifier& notaryID,
+        const Identifier& payerNymID,
+        const Identifier& sharesUnitID,
+        const Identifier& payoutUnitID,
+        const Identifier& voucherAccountID,
+        const String& memo,
+        const std::int64_t payoutPerShare,
+        const std::int64_t totalCost,
+        const TransactionNumber payoutNumber);
+    EXPORT DividendPayout(
+        const Services& services,
+        const Identifier& payerNymID,
+        const Identifier& sharesUnitID,
+        const Identifier& payoutUnitID,
+        const Identifier& voucherAccountID,
+        const String& memo,
+        const std::int64_t payoutPerShare,
+        const std::int64_t totalCost,
+        const TransactionNumber payoutNumber);
+
+    ~DividendPayout() = default;
+
+private:
+    using State = DividendCheckpoint::State;
+    using Payment = DividendCheckpoint::Payment;
+
+    class ServerServices;
+
+    std::unique_ptr<const Services> server_services_{nullptr};
+    const Services& services_;
+    const Identifier notary_id_;
+    const Identifier payer_nym_id_;
+    const Identifier shares_unit_id_;
+    const Identifier payout_unit_id_;
+    const Identifier voucher_account_id_;
+    const String memo_;
+    const std::int64_t payout_per_share_{0};
+    const std::int64_t total_cost_{0};
+    const TransactionNumber payout_number_{0};
+    DividendCheckpoint checkpoint_;
+    /** Quarters of the shareholders reported to the payer so far */
+    std::size_t reported_{0};
+
+    static DividendCheckpoint::Parameters parameters(
+        const Identifier& payerNymID,
+        const Identifier& sharesUnitID,
+        const Identifier& payoutUnitID,
+        const Identifier& voucherAccountID,
+        const String& memo,
+        const std::int64_t payoutPerShare,
+        const std::int64_t totalCost);
+
+    std::int64_t amount(const State state) const;
+    bool issue_numbers(const std::vector<Payment*>& payments) const;
+    bool make_plan(
+        const UnitDefinition& shares,
+        mapOfAccounts* loadedAccounts);
+    void notify_payer(const std::string& text) const;
+    bool pay(const Identifier& recipient, const Payment& payment) const;
+    bool pay_shareholders(const Progress& progress);
+    void report_progress(const std::size_t done, const std::size_t total);
+    bool return_funds();
+    bool run(
+        const UnitDefinition* shares,
+        mapOfAccounts* loadedAccounts,
+        const Progress& progress);
+
+    DividendPayout() = delete;
+    DividendPayout(const DividendPayout&) = delete;
+    DividendPayout(DividendPayout&&) = delete;
+    DividendPayout& operator=(const DividendPayout&) = delete;
+    DividendPayout& operator=(DividendPayout&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+
+#endif  // OPENTXS_SERVER_DIVIDENDPAYOUT_HPP
@@ -45,15 +45,32 @@
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/network/zeromq/Socket.hpp"
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
+#include <vector>
+
+#define SERVER_LOCK_STRIPES 64
 
 namespace opentxs
 {
 namespace server
 {
+/** Client requests arrive on a router socket and are distributed by a proxy to
+ *  a pool of worker reply sockets, each serviced by its own thread.
+ *
+ *  Commands which only affect the sending nym run concurrently with each other
+ *  and are serialized per nym and per account via lock striping. Commands
+ *  which may modify another user's boxes or shared server state, as well as
+ *  cron, run exclusively.
+ *
+ *  The cron thread sleeps until the next cron item is due, or until an
+ *  exclusive request (which may have added a cron item) wakes it. */
 class MessageProcessor : Lockable
 {
 public:
@@ -69,16 +86,30 @@ public:
     EXPORT ~MessageProcessor();
 
 private:
+    static const std::set<MessageType> parallel_commands_;
+
     Server& server_;
     const Flag& running_;
-    [[maybe_unused]] const network::zeromq::Context& context_;
+    const network::zeromq::Context& context_;
     OTZMQReplyCallback reply_socket_callback_;
-    OTZMQReplySocket reply_socket_;
+    OTZMQRouterSocket frontend_;
+    OTZMQDealerSocket backend_;
+    // Unique to this instance, so several notaries can share a context
+    const std::string worker_endpoint_;
+    std::vector<OTZMQReplySocket> workers_;
+    std::unique_ptr<OTZMQProxy> proxy_{nullptr};
+    mutable std::array<std::mutex, SERVER_LOCK_STRIPES> stripes_;
+    std::condition_variable cron_wakeup_;
     std::unique_ptr<std::thread> thread_{nullptr};
 
-    bool processMessage(const std::string& messageString, std::string& reply);
+    std::vector<Lock> lock_stripes(const Message& request) const;
+    bool process_command(const Message& request, Message& reply);
+    bool processMessage(
+        const network::zeromq::Message& incoming,
+        std::string& reply);
     OTZMQMessage processSocket(const network::zeromq::Message& incoming);
     void run();
+    std::size_t stripe(const String& id) const;
 };
 }  // namespace server
 }  // namespace opentxs
@@ -42,6 +42,7 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/api/Editor.hpp"
+#include "opentxs/core/IntervalSet.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/Types.hpp"
 
@@ -82,7 +83,7 @@ public:
         const MessageType& type,
         Message& output);
 
-    std::set<RequestNumber> Acknowledged() const;
+    const IntervalSet& Acknowledged() const;
     bool HaveContext() const;
     const bool& Init() const;
     const Message& Original() const;
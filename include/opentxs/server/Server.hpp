@@ -75,7 +75,7 @@ class Server
     friend class MessageProcessor;
     friend class UserCommandProcessor;
     friend class MainFile;
-    friend class opentxs::PayDividendVisitor;
+    friend class DividendPayout;
     friend class Notary;
 
 public:
@@ -47,6 +47,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace opentxs
@@ -79,9 +80,16 @@ public:
 
     TransactionNumber transactionNumber() const { return transactionNumber_; }
 
+    /** The highest transaction number which has been durably reserved. This is
+     * the value persisted in the main file. */
+    TransactionNumber reservedNumber() const { return reservedNumber_; }
+
+    /** Called when the main file is loaded. Any number up to value may have
+     * been issued before the server stopped, so issuing resumes above it. */
     void transactionNumber(TransactionNumber value)
     {
         transactionNumber_ = value;
+        reservedNumber_ = value;
     }
 
     bool addBasketAccountID(
@@ -119,8 +127,13 @@ public:
 private:
     typedef std::map<std::string, std::string> BasketsMap;
 
+    // Protects transactionNumber_ when requests are processed concurrently
+    std::mutex lock_;
     // This stores the last VALID AND ISSUED transaction number.
     TransactionNumber transactionNumber_;
+    // Numbers up to this value have been reserved in the main file and can be
+    // issued without writing to storage.
+    TransactionNumber reservedNumber_;
     // maps basketId with basketAccountId
     BasketsMap idToBasketMap_;
     // basket issuer account ID, which is *different* on each server, using the
@@ -131,6 +144,8 @@ private:
     AccountList voucherAccounts_;
 
     Server* server_;  // TODO: remove later when feasible
+
+    bool reserve_numbers(const Lock& lock);
 };
 }  // namespace server
 }  // namespace opentxs
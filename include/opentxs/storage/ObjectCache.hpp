@@ -0,0 +1,135 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_STORAGE_OBJECTCACHE_HPP
+#define OPENTXS_STORAGE_OBJECTCACHE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace opentxs
+{
+namespace storage
+{
+// Size bounded LRU cache of validated protobuf objects
+//
+// Objects are stored by hash, so a cached entry never becomes stale and no
+// invalidation is required. Callers receive a copy of the cached object since
+// Driver::LoadProto returns mutable objects.
+class ObjectCache
+{
+public:
+    std::uint64_t Hits() const { return hits_.load(); }
+    std::uint64_t Misses() const { return misses_.load(); }
+
+    template <class T>
+    void Add(
+        const std::string& hash,
+        const std::shared_ptr<T>& object,
+        const std::size_t size) const
+    {
+        if (false == bool(object)) {
+
+            return;
+        }
+
+        add(Key{std::type_index(typeid(T)), hash},
+            std::make_shared<const T>(*object),
+            size);
+    }
+
+    template <class T>
+    bool Get(const std::string& hash, std::shared_ptr<T>& output) const
+    {
+        const auto object = get(Key{std::type_index(typeid(T)), hash});
+
+        if (false == bool(object)) {
+
+            return false;
+        }
+
+        output = std::make_shared<T>(*static_cast<const T*>(object.get()));
+
+        return true;
+    }
+
+    explicit ObjectCache(const std::size_t limit);
+
+    ~ObjectCache() = default;
+
+private:
+    typedef std::pair<std::type_index, std::string> Key;
+    typedef std::shared_ptr<const void> Object;
+    typedef std::tuple<Key, Object, std::size_t> Entry;
+    typedef std::list<Entry> LRU;
+
+    const std::size_t limit_{0};
+    mutable std::mutex lock_;
+    mutable LRU lru_;
+    mutable std::map<Key, LRU::iterator> index_;
+    mutable std::size_t size_{0};
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+
+    void add(const Key& key, const Object& object, const std::size_t size)
+        const;
+    Object get(const Key& key) const;
+    void trim(const Lock& lock) const;
+
+    ObjectCache() = delete;
+    ObjectCache(const ObjectCache&) = delete;
+    ObjectCache(ObjectCache&&) = delete;
+    ObjectCache& operator=(const ObjectCache&) = delete;
+    ObjectCache& operator=(ObjectCache&&) = delete;
+};
+}  // namespace storage
+}  // namespace opentxs
+#endif  // OPENTXS_STORAGE_OBJECTCACHE_HPP
@@ -44,6 +44,7 @@
 #include "opentxs/api/storage/Plugin.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/storage/ObjectCache.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
@@ -137,6 +138,13 @@ bool opentxs::api::storage::Driver::LoadProto(
     std::shared_ptr<T>& serialized,
     const bool checking) const
 {
+    const auto* cache = Cache();
+
+    if ((nullptr != cache) && cache->Get(hash, serialized)) {
+
+        return true;
+    }
+
     std::string raw;
     const bool loaded = Load(hash, checking, raw);
     bool valid = false;
@@ -147,6 +155,10 @@ bool opentxs::api::storage::Driver::LoadProto(
         valid = proto::Validate<T>(*serialized, VERBOSE);
     }
 
+    if (valid && (nullptr != cache)) {
+        cache->Add(hash, serialized, raw.size());
+    }
+
     if (!valid) {
         if (loaded) {
             otErr << "Specified object was located but could not be "
@@ -67,7 +67,12 @@ public:
     bool auto_publish_units_ = true;
     std::int64_t gc_interval_ =
         C::duration_cast<C::seconds>(C::hours(1)).count();
+    std::int64_t gc_objects_per_second_{1000};
+    std::int64_t group_commit_window_{5};
+    std::int64_t object_cache_size_{32 * 1024 * 1024};
     std::string path_{};
+    std::int64_t write_threads_{4};
+    std::int64_t write_queue_size_{1024};
     InsertCB dht_callback_{};
 
 #if OT_STORAGE_SQLITE
@@ -92,6 +97,8 @@ public:
     std::string sqlite3_control_table_ = "control";
     std::string sqlite3_root_key_ = "a";
     std::string sqlite3_db_file_ = "opentxs.sqlite3";
+    std::string sqlite3_synchronous_ = "NORMAL";
+    std::int64_t sqlite3_read_connections_ = 4;
 #endif
 };
 }  // namespace opentxs
@@ -0,0 +1,118 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_STORAGE_STORAGEWRITEQUEUE_HPP
+#define OPENTXS_STORAGE_STORAGEWRITEQUEUE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace opentxs
+{
+namespace api
+{
+namespace storage
+{
+class Plugin;
+}  // namespace storage
+}  // namespace api
+
+// Fixed size pool of threads which performs storage plugin writes
+//
+// Push() blocks while the queue is full. A write for a plugin, bucket and key
+// which is already waiting in the queue is merged with the queued write and
+// every caller's promise receives the result of the single write.
+class StorageWriteQueue
+{
+public:
+    void Push(
+        const api::storage::Plugin& plugin,
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise);
+
+    StorageWriteQueue(const std::size_t threads, const std::size_t capacity);
+
+    ~StorageWriteQueue();
+
+private:
+    struct Job {
+        const api::storage::Plugin* plugin_{nullptr};
+        bool transaction_{false};
+        std::string key_{};
+        std::string value_{};
+        bool bucket_{false};
+        std::vector<std::promise<bool>*> promises_{};
+    };
+
+    typedef std::tuple<const api::storage::Plugin*, bool, bool, std::string>
+        JobKey;
+
+    const std::size_t capacity_{0};
+    std::mutex lock_;
+    std::condition_variable has_work_;
+    std::condition_variable has_space_;
+    std::list<Job> queue_;
+    std::map<JobKey, std::list<Job>::iterator> index_;
+    bool running_{true};
+    std::vector<std::thread> threads_;
+
+    void worker();
+
+    StorageWriteQueue() = delete;
+    StorageWriteQueue(const StorageWriteQueue&) = delete;
+    StorageWriteQueue(StorageWriteQueue&&) = delete;
+    StorageWriteQueue& operator=(const StorageWriteQueue&) = delete;
+    StorageWriteQueue& operator=(StorageWriteQueue&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_STORAGE_STORAGEWRITEQUEUE_HPP
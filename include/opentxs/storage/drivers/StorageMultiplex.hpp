@@ -42,9 +42,15 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/api/storage/Driver.hpp"
+#include "opentxs/storage/ObjectCache.hpp"
+#include "opentxs/storage/StorageWriteQueue.hpp"
 #include "opentxs/Types.hpp"
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace opentxs
@@ -76,6 +82,7 @@ class Tree;
 class StorageMultiplex : virtual public opentxs::api::storage::Driver
 {
 public:
+    const storage::ObjectCache* Cache() const override { return &cache_; }
     bool EmptyBucket(const bool bucket) const override;
     bool LoadFromBucket(
         const std::string& key,
@@ -102,6 +109,7 @@ public:
         const bool isTransaction,
         const std::string& value,
         std::string& key) const override;
+    bool StoreNode(const std::string& value, std::string& key) const override;
     bool StoreRoot(const bool commit, const std::string& hash) const override;
 
     ~StorageMultiplex();
@@ -109,6 +117,10 @@ public:
 private:
     friend class api::storage::implementation::Storage;
 
+    /** Reference count and serialized value of an index node which has not
+     *  been written yet */
+    typedef std::pair<std::size_t, std::string> PendingNode;
+
     const api::storage::Storage& storage_;
     const Flag& primary_bucket_;
     const StorageConfig& config_;
@@ -116,6 +128,13 @@ private:
     std::vector<std::unique_ptr<opentxs::api::storage::Plugin>> backup_plugins_;
     const Digest digest_;
     const Random random_;
+    mutable StorageWriteQueue write_queue_;
+    storage::ObjectCache cache_;
+    mutable std::mutex batch_lock_;
+    mutable std::mutex flush_lock_;
+    mutable bool batch_active_{false};
+    mutable std::map<std::string, PendingNode> pending_;
+    mutable std::map<std::string, PendingNode> flushing_;
 
     StorageMultiplex(
         const api::storage::Storage& storage,
@@ -132,8 +151,11 @@ private:
     StorageMultiplex& operator=(const StorageMultiplex&) = delete;
     StorageMultiplex& operator=(StorageMultiplex&&) = delete;
 
+    void BeginBatch() const;
     void Cleanup();
     void Cleanup_StorageMultiplex();
+    void EndBatch() const;
+    bool flush() const;
     void init(
         const std::string& primary,
         std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
@@ -145,8 +167,11 @@ private:
         const String& previous);
     void InitBackup();
     void InitEncryptedBackup(std::unique_ptr<SymmetricKey>& key);
+    bool load_pending(const std::string& key, std::string& value) const;
     void migrate_primary(const std::string& from, const std::string& to);
     opentxs::api::storage::Driver& Primary();
+    void release_pending(const Lock& lock, const std::string& key) const;
+    bool store_root(const bool commit, const std::string& hash) const;
     void synchronize_plugins(
         const std::string& hash,
         const storage::Root& root,
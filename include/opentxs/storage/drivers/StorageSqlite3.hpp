@@ -50,8 +50,11 @@ extern "C" {
 }
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <sstream>
 #include <tuple>
 #include <vector>
 
@@ -61,6 +64,10 @@ class StorageConfig;
 class StorageMultiplex;
 
 // SQLite3 implementation of opentxs::storage
+//
+// All writes go through a single connection. Reads are served by a pool of
+// separate connections so that, in WAL mode, loading objects never waits for
+// a commit in progress. Each connection caches its prepared statements.
 class StorageSqlite3 : public virtual Plugin,
                        public virtual opentxs::api::storage::Driver
 {
@@ -81,6 +88,14 @@ public:
 private:
     typedef Plugin ot_super;
 
+    struct Connection {
+        sqlite3* db_{nullptr};
+        std::map<std::string, sqlite3_stmt*> statements_{};
+    };
+
+    using Reader =
+        std::unique_ptr<Connection, std::function<void(Connection*)>>;
+
     friend class StorageMultiplex;
 
     std::string folder_;
@@ -88,24 +103,27 @@ private:
     mutable OTFlag transaction_bucket_;
     mutable std::vector<std::pair<const std::string, const std::string>>
         pending_;
-    sqlite3* db_{nullptr};
-
-    std::string bind_key(
-        const std::string& source,
-        const std::string& key,
-        const std::size_t start) const;
-    void commit(std::stringstream& sql) const;
+    mutable std::mutex write_lock_;
+    mutable Connection writer_;
+    mutable std::mutex reader_lock_;
+    mutable std::condition_variable reader_available_;
+    std::vector<std::unique_ptr<Connection>> readers_;
+    mutable std::vector<Connection*> idle_readers_;
+
+    void close(Connection& connection) const;
     bool commit_transaction(const std::string& rootHash) const;
     bool Create(const std::string& tablename) const;
+    bool exec(Connection& connection, const std::string& sql) const;
     std::string GetTableName(const bool bucket) const;
+    bool open(Connection& connection, const bool create) const;
+    Reader reader() const;
     bool Select(
         const std::string& key,
         const std::string& tablename,
         std::string& value) const;
     bool Purge(const std::string& tablename) const;
-    void set_data(std::stringstream& sql) const;
-    void set_root(const std::string& rootHash, std::stringstream& sql) const;
-    void start_transaction(std::stringstream& sql) const;
+    sqlite3_stmt* statement(Connection& connection, const std::string& sql)
+        const;
     void store(
         const bool isTransaction,
         const std::string& key,
@@ -116,6 +134,11 @@ private:
         const std::string& key,
         const std::string& tablename,
         const std::string& value) const;
+    bool upsert(
+        const Lock& lock,
+        const std::string& key,
+        const std::string& tablename,
+        const std::string& value) const;
 
     void Init_StorageSqlite3();
 
@@ -0,0 +1,110 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_STORAGE_STORAGETHROTTLE_HPP
+#define OPENTXS_STORAGE_STORAGETHROTTLE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/api/storage/Driver.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace opentxs
+{
+// Forwards to another driver while limiting the number of objects stored per
+// second
+//
+// Used as the destination of garbage collection so that copying the live tree
+// does not starve foreground reads and writes.
+class StorageThrottle : virtual public opentxs::api::storage::Driver
+{
+public:
+    bool EmptyBucket(const bool bucket) const override;
+    bool Load(const std::string& key, const bool checking, std::string& value)
+        const override;
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const override;
+    std::string LoadRoot() const override;
+    bool Migrate(
+        const std::string& key,
+        const opentxs::api::storage::Driver& to) const override;
+    bool Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const override;
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const override;
+    bool Store(
+        const bool isTransaction,
+        const std::string& value,
+        std::string& key) const override;
+    bool StoreRoot(const bool commit, const std::string& hash) const override;
+    const opentxs::api::storage::Driver& Target() const override;
+
+    StorageThrottle(
+        const opentxs::api::storage::Driver& driver,
+        const std::int64_t objectsPerSecond);
+
+    ~StorageThrottle() = default;
+
+private:
+    const opentxs::api::storage::Driver& driver_;
+    const std::chrono::microseconds interval_;
+    mutable std::mutex lock_;
+    mutable std::chrono::steady_clock::time_point next_;
+
+    void wait() const;
+
+    StorageThrottle() = delete;
+    StorageThrottle(const StorageThrottle&) = delete;
+    StorageThrottle(StorageThrottle&&) = delete;
+    StorageThrottle& operator=(const StorageThrottle&) = delete;
+    StorageThrottle& operator=(StorageThrottle&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_STORAGE_STORAGETHROTTLE_HPP
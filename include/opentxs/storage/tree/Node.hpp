@@ -108,6 +108,17 @@ protected:
         return store_proto<T>(data, id, alias, notUsed);
     }
 
+    template <class T>
+    bool store_node(const T& serialized) const
+    {
+        if (false == proto::Validate<T>(serialized, VERBOSE)) {
+
+            return false;
+        }
+
+        return driver_.StoreNode(proto::ProtoAsString<T>(serialized), root_);
+    }
+
     template <class T>
     bool load_proto(
         const std::string& id,
@@ -96,9 +96,11 @@ private:
     void cleanup() const;
     void collect_garbage(const opentxs::api::storage::Driver* to) const;
     void init(const std::string& hash) override;
+    std::size_t load_gc_cursor(const bool bucket) const;
     bool save(const Lock& lock, const opentxs::api::storage::Driver& to) const;
     bool save(const Lock& lock) const override;
     void save(class Tree* tree, const Lock& lock);
+    void save_gc_cursor(const std::size_t slice, const bool bucket) const;
 
     Root(
         const opentxs::api::storage::Driver& storage,
@@ -144,7 +144,13 @@ public:
     Editor<Servers> mutable_Servers();
     Editor<Units> mutable_Units();
 
+    // Garbage collection is performed in slices so that an interrupted
+    // collection can be resumed. Each nym is a separate slice.
+    std::size_t GCSlices() const;
     bool Migrate(const opentxs::api::storage::Driver& to) const override;
+    bool Migrate(
+        const std::size_t slice,
+        const opentxs::api::storage::Driver& to) const;
 
     ~Tree();
 };
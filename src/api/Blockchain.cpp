@@ -46,9 +46,9 @@
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/api/Activity.hpp"
-#include "opentxs/core/crypto/AsymmetricKeySecp256k1.hpp"
 #include "opentxs/core/crypto/Bip32.hpp"
-#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/util/Parallel.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
@@ -75,11 +75,17 @@
 #define LITECOIN_PUBKEY_HASH 0x30
 #define DOGECOIN_PUBKEY_HASH 0x1e
 #define DASH_PUBKEY_HASH 0x4c
+#define ADDRESSES_PER_THREAD 32
 
 #define OT_METHOD "opentxs::Blockchain::"
 
 namespace opentxs::api
 {
+struct Blockchain::ChainKey {
+    OTData key_{Data::Factory()};
+    OTPassword chain_code_{};
+};
+
 Blockchain::Blockchain(
     const Activity& activity,
     const Crypto& crypto,
@@ -92,6 +98,8 @@ Blockchain::Blockchain(
     , lock_()
     , nym_lock_()
     , account_lock_()
+    , chain_key_lock_()
+    , chain_keys_()
 {
 }
 
@@ -187,6 +195,57 @@ std::uint8_t Blockchain::address_prefix(const proto::ContactItemType type) const
     return 0x0;
 }
 
+bool Blockchain::allocate_addresses(
+    const Lock&,
+    proto::Bip44Account& account,
+    const std::uint32_t count,
+    const std::string& label,
+    const BIP44Chain chain,
+    std::vector<proto::Bip44Address>& output) const
+{
+    const std::uint32_t first =
+        chain ? account.internalindex() : account.externalindex();
+
+    if ((MAX_INDEX - first) < count) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Account is full." << std::endl;
+
+        return false;
+    }
+
+    const auto addresses = calculate_addresses(account, chain, first, count);
+
+    if (addresses.size() != count) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Expected " << count
+              << " addresses but calculated " << addresses.size() << "."
+              << std::endl;
+
+        return false;
+    }
+
+    for (const auto& address : addresses) {
+        if (address.empty()) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Unable to derive address."
+                  << std::endl;
+
+            return false;
+        }
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const auto index = first + i;
+        auto& newAddress = add_address(index, account, chain);
+        newAddress.set_version(BLOCKCHAIN_VERSION);
+        newAddress.set_index(index);
+        newAddress.set_address(addresses[i]);
+        otErr << OT_METHOD << __FUNCTION__ << ": Address "
+              << newAddress.address() << " allocated." << std::endl;
+        newAddress.set_label(label);
+        output.push_back(newAddress);
+    }
+
+    return true;
+}
+
 std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
     const Identifier& nymID,
     const Identifier& accountID,
@@ -208,25 +267,14 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
     }
 
     const auto& type = account->type();
-    const auto index =
-        chain ? account->internalindex() : account->externalindex();
+    std::vector<proto::Bip44Address> allocated{};
 
-    if (MAX_INDEX == index) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Account is full." << std::endl;
+    if (false ==
+        allocate_addresses(accountLock, *account, 1, label, chain, allocated)) {
 
         return output;
     }
 
-    auto& newAddress = add_address(index, *account, chain);
-    newAddress.set_version(BLOCKCHAIN_VERSION);
-    newAddress.set_index(index);
-    newAddress.set_address(calculate_address(*account, chain, index));
-
-    OT_ASSERT(false == newAddress.address().empty());
-
-    otErr << OT_METHOD << __FUNCTION__ << ": Address " << newAddress.address()
-          << " allocated." << std::endl;
-    newAddress.set_label(label);
     const auto saved = storage_.Store(sNymID, type, *account);
 
     if (false == saved) {
@@ -236,7 +284,56 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
         return output;
     }
 
-    output.reset(new proto::Bip44Address(newAddress));
+    output.reset(new proto::Bip44Address(allocated.front()));
+
+    return output;
+}
+
+std::vector<proto::Bip44Address> Blockchain::AllocateAddresses(
+    const Identifier& nymID,
+    const Identifier& accountID,
+    const std::uint32_t count,
+    const std::string& label,
+    const BIP44Chain chain) const
+{
+    LOCK_ACCOUNT()
+
+    const std::string sNymID = nymID.str();
+    const std::string sAccountID = accountID.str();
+    std::vector<proto::Bip44Address> output{};
+
+    if (0 == count) {
+        otErr << OT_METHOD << __FUNCTION__ << ": No addresses requested."
+              << std::endl;
+
+        return output;
+    }
+
+    auto account = load_account(accountLock, sNymID, sAccountID);
+
+    if (false == bool(account)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Account does not exist."
+              << std::endl;
+
+        return output;
+    }
+
+    const auto& type = account->type();
+
+    if (false == allocate_addresses(
+                     accountLock, *account, count, label, chain, output)) {
+
+        return {};
+    }
+
+    const auto saved = storage_.Store(sNymID, type, *account);
+
+    if (false == saved) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
+              << std::endl;
+
+        return {};
+    }
 
     return output;
 }
@@ -334,85 +431,121 @@ Bip44Type Blockchain::bip44_type(const proto::ContactItemType type) const
 }
 
 std::string Blockchain::calculate_address(
-    const proto::Bip44Account& account,
-    const BIP44Chain chain,
-    const std::uint32_t index) const
+    const proto::ContactItemType type,
+    const Data& pubkey) const
 {
-    const auto& path = account.path();
-    auto fingerprint = path.root();
-    auto serialized = crypto_.BIP32().AccountChildKey(path, chain, index);
-
-    if (false == bool(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to derive key."
-              << std::endl;
+    if (COMPRESSED_PUBKEY_SIZE != pubkey.GetSize()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Incorrect pubkey size ("
+              << pubkey.GetSize() << ")." << std::endl;
 
         return {};
     }
 
-    std::unique_ptr<OTAsymmetricKey> key{nullptr};
-    std::unique_ptr<AsymmetricKeySecp256k1> ecKey{nullptr};
-    key.reset(OTAsymmetricKey::KeyFactory(*serialized));
+    auto sha256 = Data::Factory();
+    auto ripemd160 = Data::Factory();
+    auto pubkeyHash = Data::Factory();
 
-    if (false == bool(key)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to instantiate key."
+    if (!crypto_.Hash().Digest(proto::HASHTYPE_SHA256, pubkey, sha256)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to calculate sha256."
               << std::endl;
 
         return {};
     }
 
-    ecKey.reset(dynamic_cast<AsymmetricKeySecp256k1*>(key.release()));
-
-    if (false == bool(ecKey)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Incorrect key type."
+    if (!crypto_.Hash().Digest(proto::HASHTYPE_RIMEMD160, sha256, pubkeyHash)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to calculate rimemd160."
               << std::endl;
 
         return {};
     }
 
-    auto pubkey = Data::Factory();
+    const auto prefix = address_prefix(type);
+    auto preimage = Data::Factory(&prefix, sizeof(prefix));
 
-    if (false == ecKey->GetPublicKey(pubkey)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to extract public key."
-              << std::endl;
+    OT_ASSERT(1 == preimage->GetSize());
 
-        return {};
-    }
+    preimage += pubkeyHash;
 
-    if (COMPRESSED_PUBKEY_SIZE != pubkey->GetSize()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Incorrect pubkey size ("
-              << pubkey->GetSize() << ")." << std::endl;
+    OT_ASSERT(21 == preimage->GetSize());
 
-        return {};
-    }
+    return crypto_.Encode().IdentifierEncode(preimage);
+}
 
-    auto sha256 = Data::Factory();
-    auto ripemd160 = Data::Factory();
-    auto pubkeyHash = Data::Factory();
+// Address keys are non-hardened children of the chain key, so they are
+// derived from the cached extended public key without loading the seed.
+std::vector<std::string> Blockchain::calculate_addresses(
+    const proto::Bip44Account& account,
+    const BIP44Chain chain,
+    const std::uint32_t first,
+    const std::uint32_t count) const
+{
+    const auto parent = chain_key(account, chain);
 
-    if (!crypto_.Hash().Digest(proto::HASHTYPE_SHA256, pubkey, sha256)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to calculate sha256."
+    if (false == bool(parent)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to derive chain key."
               << std::endl;
 
         return {};
     }
 
-    if (!crypto_.Hash().Digest(proto::HASHTYPE_RIMEMD160, sha256, pubkeyHash)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to calculate rimemd160."
-              << std::endl;
+    const auto type = account.type();
+    std::vector<std::string> output(count);
+    auto derive = [&](const std::size_t i) -> void {
+        auto pubkey = Data::Factory();
+        const bool derived = crypto_.BIP32().GetPublicChild(
+            EcdsaCurve::SECP256K1,
+            parent->key_,
+            parent->chain_code_,
+            first + static_cast<std::uint32_t>(i),
+            pubkey);
 
-        return {};
+        if (false == derived) {
+            otErr << OT_METHOD << "calculate_addresses"
+                  << ": Unable to derive key." << std::endl;
+
+            return;
+        }
+
+        output[i] = calculate_address(type, pubkey);
+    };
+
+    Parallel(count, ADDRESSES_PER_THREAD, derive);
+
+    return output;
+}
+
+std::shared_ptr<const Blockchain::ChainKey> Blockchain::chain_key(
+    const proto::Bip44Account& account,
+    const BIP44Chain chain) const
+{
+    const ChainKeyID id{account.id(), chain};
+    Lock lock(chain_key_lock_);
+    auto it = chain_keys_.find(id);
+
+    if (chain_keys_.end() != it) {
+
+        return it->second;
     }
 
-    const auto prefix = address_prefix(account.type());
-    auto preimage = Data::Factory(&prefix, sizeof(prefix));
+    // Deriving from the seed is slow, and the account lock already keeps two
+    // threads from deriving the same chain key
+    lock.unlock();
+    std::shared_ptr<ChainKey> output{new ChainKey};
 
-    OT_ASSERT(1 == preimage->GetSize());
+    OT_ASSERT(output);
 
-    preimage += pubkeyHash;
+    const bool derived = crypto_.BIP32().AccountChainKey(
+        account.path(), chain, output->key_, output->chain_code_);
 
-    OT_ASSERT(21 == preimage->GetSize());
+    if (false == derived) {
 
-    return crypto_.Encode().IdentifierEncode(preimage);
+        return {};
+    }
+
+    lock.lock();
+    chain_keys_[id] = output;
+
+    return output;
 }
 
 proto::Bip44Address& Blockchain::find_address(
@@ -698,12 +698,42 @@ void Native::Init_Storage()
         defaultGcInterval,
         configGcInterval,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "gc_objects_per_second",
+        config.gc_objects_per_second_,
+        config.gc_objects_per_second_,
+        notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "group_commit_window",
+        config.group_commit_window_,
+        config.group_commit_window_,
+        notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "object_cache_size",
+        config.object_cache_size_,
+        config.object_cache_size_,
+        notUsed);
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
         "path",
         String(config.path_),
         config.path_,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "write_threads",
+        config.write_threads_,
+        config.write_threads_,
+        notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "write_queue_size",
+        config.write_queue_size_,
+        config.write_queue_size_,
+        notUsed);
 #if OT_STORAGE_FS
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
@@ -769,6 +799,18 @@ void Native::Init_Storage()
         String(config.sqlite3_db_file_),
         config.sqlite3_db_file_,
         notUsed);
+    Config().CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "sqlite3_synchronous",
+        String(config.sqlite3_synchronous_),
+        config.sqlite3_synchronous_,
+        notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "sqlite3_read_connections",
+        config.sqlite3_read_connections_,
+        config.sqlite3_read_connections_,
+        notUsed);
 #endif
 
     if (haveGCInterval) {
@@ -41,10 +41,12 @@
 #include "opentxs/api/client/Wallet.hpp"
 #if OT_CASH
 #include "opentxs/cash/Mint.hpp"
+#include "opentxs/cash/SpentTokens.hpp"
 #endif  // OT_CASH
 #include <opentxs/core/util/OTDataFolder.hpp>
 #include <opentxs/core/util/OTFolders.hpp>
 #include <opentxs/core/util/OTPaths.hpp>
+#include "opentxs/core/AccountRegistry.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include <opentxs/core/OTStorage.hpp>
@@ -114,9 +116,38 @@ void Server::Cleanup()
           << std::endl;
 
     message_processor_.cleanup();
+    AccountRegistry::Flush();
 }
 
 #if OT_CASH
+void Server::expire_spent_tokens(
+    const std::string& unitID,
+    const std::int32_t last) const
+{
+    const Identifier unit(unitID);
+    const auto now = std::time(nullptr);
+
+    // Tokens can be deposited until the valid to date of their series, which
+    // is later than the date the series stops being used for withdrawals.
+    for (auto series = last - 1; series >= 0; --series) {
+        auto mint = GetPrivateMint(unit, series);
+
+        if (false == bool(mint)) {
+            break;
+        }
+
+        if (now <= mint->GetValidTo()) {
+
+            continue;
+        }
+
+        // Expire() returns false both when a series had no deposits and when
+        // it was removed on an earlier pass, so that can not be used to stop
+        // early. Older series may still have records.
+        SpentTokens::Expire(unit, series);
+    }
+}
+
 void Server::generate_mint(
     const std::string& serverID,
     const std::string& unitID,
@@ -406,6 +437,8 @@ void Server::mint() const
             continue;
         }
 
+        expire_spent_tokens(unitID, last);
+
         const auto now = std::time(nullptr);
         const std::time_t expires = mint->GetExpiration();
         const std::chrono::seconds limit(
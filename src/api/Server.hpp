@@ -110,6 +110,9 @@ private:
 #endif  // OT_CASH
 
 #if OT_CASH
+    void expire_spent_tokens(
+        const std::string& unitID,
+        const std::int32_t last) const;
     void generate_mint(
         const std::string& serverID,
         const std::string& unitID,
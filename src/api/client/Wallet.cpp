@@ -78,10 +78,6 @@ Wallet::Wallet(Native& ot)
     , unit_map_()
     , context_map_()
     , issuer_map_()
-    , nym_map_lock_()
-    , server_map_lock_()
-    , unit_map_lock_()
-    , context_map_lock_()
     , issuer_map_lock_()
     , peer_map_lock_()
     , peer_lock_()
@@ -93,12 +89,27 @@ Wallet::Wallet(Native& ot)
 std::shared_ptr<class Context> Wallet::context(
     const Identifier& localNymID,
     const Identifier& remoteNymID) const
+{
+    const ContextID context = {localNymID.str(), remoteNymID.str()};
+    Lock lock(shard(context_map_, context).lock_);
+
+    return this->context(lock, localNymID, remoteNymID);
+}
+
+std::shared_ptr<class Context> Wallet::context(
+    const Lock& lock,
+    const Identifier& localNymID,
+    const Identifier& remoteNymID) const
 {
     const std::string local = localNymID.str();
     const std::string remote = remoteNymID.str();
     const ContextID context = {local, remote};
-    auto it = context_map_.find(context);
-    const bool inMap = (it != context_map_.end());
+    auto& map = shard(context_map_, context).map_;
+
+    OT_ASSERT(lock.mutex() == &shard(context_map_, context).lock_);
+
+    auto it = map.find(context);
+    const bool inMap = (it != map.end());
 
     if (inMap) {
         return it->second;
@@ -127,7 +138,7 @@ std::shared_ptr<class Context> Wallet::context(
         return nullptr;
     }
 
-    auto& entry = context_map_[context];
+    auto& entry = map[context];
 
     // Obtain nyms.
     const auto localNym = Nym(localNymID);
@@ -180,7 +191,7 @@ std::shared_ptr<class Context> Wallet::context(
     const bool valid = entry->Validate();
 
     if (!valid) {
-        context_map_.erase(context);
+        map.erase(context);
 
         otErr << OT_METHOD << __FUNCTION__ << ": invalid signature on context."
               << std::endl;
@@ -270,8 +281,10 @@ Editor<class ClientContext> Wallet::mutable_ClientContext(
 
     const auto& serverID = ot_.Server().ID();
     const auto& serverNymID = ot_.Server().NymID();
-    Lock lock(context_map_lock_);
-    auto base = context(serverNymID, remoteNymID);
+    const ContextID contextID = {serverNymID.str(), remoteNymID.str()};
+    auto& shard = this->shard(context_map_, contextID);
+    Lock lock(shard.lock_);
+    auto base = context(lock, serverNymID, remoteNymID);
     std::function<void(class Context*)> callback =
         [&](class Context* in) -> void { this->save(in); };
 
@@ -288,8 +301,7 @@ Editor<class ClientContext> Wallet::mutable_ClientContext(
         OT_ASSERT_MSG(remote, "Remote nym does not exist in the wallet.");
 
         // Create a new Context
-        const ContextID contextID = {serverNymID.str(), remoteNymID.str()};
-        auto& entry = context_map_[contextID];
+        auto& entry = shard.map_[contextID];
         entry.reset(new class ClientContext(
             local, remote, serverID, nymfile_lock(remoteNymID)));
         base = entry;
@@ -308,12 +320,12 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
     const Identifier& localNymID,
     const Identifier& remoteID) const
 {
-    Lock lock(context_map_lock_);
-
     Identifier serverID = remoteID;
     Identifier remoteNymID = ServerToNym(serverID);
-
-    auto base = context(localNymID, remoteNymID);
+    const ContextID contextID = {localNymID.str(), remoteNymID.str()};
+    auto& shard = this->shard(context_map_, contextID);
+    Lock lock(shard.lock_);
+    auto base = context(lock, localNymID, remoteNymID);
 
     std::function<void(class Context*)> callback =
         [&](class Context* in) -> void { this->save(in); };
@@ -331,8 +343,7 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
         OT_ASSERT_MSG(remoteNym, "Remote nym does not exist in the wallet.");
 
         // Create a new Context
-        const ContextID contextID = {localNymID.str(), remoteNymID.str()};
-        auto& entry = context_map_[contextID];
+        auto& entry = shard.map_[contextID];
         auto& zmq = ot_.ZMQ();
         auto& connection = zmq.Server(serverID.str());
         entry.reset(new class ServerContext(
@@ -461,8 +472,10 @@ ConstNym Wallet::Nym(
     const std::chrono::milliseconds& timeout) const
 {
     const std::string nym = id.str();
-    Lock mapLock(nym_map_lock_);
-    bool inMap = (nym_map_.find(nym) != nym_map_.end());
+    auto& shard = this->shard(nym_map_, nym);
+    auto& map = shard.map_;
+    Lock mapLock(shard.lock_);
+    bool inMap = (map.find(nym) != map.end());
     bool valid = false;
 
     if (!inMap) {
@@ -472,47 +485,39 @@ ConstNym Wallet::Nym(
         bool loaded = ot_.DB().Load(nym, serialized, alias, true);
 
         if (loaded) {
-            auto& pNym = nym_map_[nym].second;
+            auto& entry = map[nym];
+            auto& pNym = entry.nym_;
             pNym.reset(new class Nym(id));
 
             if (pNym) {
                 if (pNym->LoadCredentialIndex(*serialized)) {
-                    valid = pNym->VerifyPseudonym();
+                    valid = verify_nym(mapLock, entry);
                     pNym->alias_ = alias;
                 }
             }
+
+            shard.added_.notify_all();
         } else {
             ot_.DHT().GetPublicNym(nym);
 
             if (timeout > std::chrono::milliseconds(0)) {
+                shard.added_.wait_for(mapLock, timeout, [&]() -> bool {
+                    return map.end() != map.find(nym);
+                });
                 mapLock.unlock();
-                auto start = std::chrono::high_resolution_clock::now();
-                auto end = start + timeout;
-                const auto interval = std::chrono::milliseconds(100);
-
-                while (std::chrono::high_resolution_clock::now() < end) {
-                    std::this_thread::sleep_for(interval);
-                    mapLock.lock();
-                    bool found = (nym_map_.find(nym) != nym_map_.end());
-                    mapLock.unlock();
-
-                    if (found) {
-                        break;
-                    }
-                }
 
                 return Nym(id);  // timeout of zero prevents infinite recursion
             }
         }
     } else {
-        auto& pNym = nym_map_[nym].second;
-        if (pNym) {
-            valid = pNym->VerifyPseudonym();
+        auto& entry = map[nym];
+        if (entry.nym_) {
+            valid = verify_nym(mapLock, entry);
         }
     }
 
     if (valid) {
-        return nym_map_[nym].second;
+        return map[nym].nym_;
     }
 
     return nullptr;
@@ -540,8 +545,9 @@ ConstNym Wallet::Nym(const proto::CredentialIndex& publicNym) const
 
         if (candidate->VerifyPseudonym()) {
             candidate->WriteCredentials();
-            Lock mapLock(nym_map_lock_);
-            nym_map_.erase(id);
+            auto& shard = this->shard(nym_map_, id);
+            Lock mapLock(shard.lock_);
+            shard.map_.erase(id);
             mapLock.unlock();
         }
     }
@@ -559,14 +565,15 @@ NymData Wallet::mutable_Nym(const Identifier& id) const
               << std::endl;
     }
 
-    Lock mapLock(nym_map_lock_);
-    auto it = nym_map_.find(nym);
+    auto& shard = this->shard(nym_map_, nym);
+    Lock mapLock(shard.lock_);
+    auto it = shard.map_.find(nym);
 
-    if (nym_map_.end() == it) {
+    if (shard.map_.end() == it) {
         return NymData(nullptr);
     }
 
-    return NymData(it->second.second);
+    return NymData(it->second.nym_);
 }
 
 std::mutex& Wallet::nymfile_lock(const Identifier& nymID) const
@@ -1035,8 +1042,9 @@ bool Wallet::PeerRequestUpdate(
 bool Wallet::RemoveServer(const Identifier& id) const
 {
     std::string server(id.str());
-    Lock mapLock(server_map_lock_);
-    auto deleted = server_map_.erase(server);
+    auto& shard = this->shard(server_map_, server);
+    Lock mapLock(shard.lock_);
+    auto deleted = shard.map_.erase(server);
 
     if (0 != deleted) {
         return ot_.DB().RemoveServer(server);
@@ -1048,8 +1056,9 @@ bool Wallet::RemoveServer(const Identifier& id) const
 bool Wallet::RemoveUnitDefinition(const Identifier& id) const
 {
     std::string unit(id.str());
-    Lock mapLock(unit_map_lock_);
-    auto deleted = unit_map_.erase(unit);
+    auto& shard = this->shard(unit_map_, unit);
+    Lock mapLock(shard.lock_);
+    auto deleted = shard.map_.erase(unit);
 
     if (0 != deleted) {
         return ot_.DB().RemoveUnitDefinition(unit);
@@ -1063,8 +1072,10 @@ ConstServerContract Wallet::Server(
     const std::chrono::milliseconds& timeout) const
 {
     const std::string server = id.str();
-    Lock mapLock(server_map_lock_);
-    bool inMap = (server_map_.find(server) != server_map_.end());
+    auto& shard = this->shard(server_map_, server);
+    auto& map = shard.map_;
+    Lock mapLock(shard.lock_);
+    bool inMap = (map.find(server) != map.end());
     bool valid = false;
 
     if (!inMap) {
@@ -1081,48 +1092,38 @@ ConstServerContract Wallet::Server(
             }
 
             if (nym) {
-                auto& pServer = server_map_[server];
+                auto& pServer = map[server];
                 pServer.reset(ServerContract::Factory(nym, *serialized));
 
                 if (pServer) {
                     valid = true;  // Factory() performs validation
                     pServer->Signable::SetAlias(alias);
                 }
+
+                shard.added_.notify_all();
             }
         } else {
             ot_.DHT().GetServerContract(server);
 
             if (timeout > std::chrono::milliseconds(0)) {
+                shard.added_.wait_for(mapLock, timeout, [&]() -> bool {
+                    return map.end() != map.find(server);
+                });
                 mapLock.unlock();
-                auto start = std::chrono::high_resolution_clock::now();
-                auto end = start + timeout;
-                const auto interval = std::chrono::milliseconds(100);
-
-                while (std::chrono::high_resolution_clock::now() < end) {
-                    std::this_thread::sleep_for(interval);
-                    mapLock.lock();
-                    bool found =
-                        (server_map_.find(server) != server_map_.end());
-                    mapLock.unlock();
-
-                    if (found) {
-                        break;
-                    }
-                }
 
                 return Server(
                     id);  // timeout of zero prevents infinite recursion
             }
         }
     } else {
-        auto& pServer = server_map_[server];
-        if (pServer) {
-            valid = pServer->Validate();
-        }
+        // Only validated contracts are ever inserted into the map and a
+        // contract's ID is the hash of its content, so a cached entry never
+        // needs to be validated again.
+        valid = bool(map[server]);
     }
 
     if (valid) {
-        return server_map_[server];
+        return map[server];
     }
 
     return nullptr;
@@ -1136,9 +1137,11 @@ ConstServerContract Wallet::Server(
     if (contract) {
         if (contract->Validate()) {
             if (ot_.DB().Store(contract->Contract(), contract->Alias())) {
-                Lock mapLock(server_map_lock_);
-                server_map_[server].reset(contract.release());
+                auto& shard = this->shard(server_map_, server);
+                Lock mapLock(shard.lock_);
+                shard.map_[server].reset(contract.release());
                 mapLock.unlock();
+                shard.added_.notify_all();
             }
         }
     }
@@ -1162,9 +1165,11 @@ ConstServerContract Wallet::Server(const proto::ServerContract& contract) const
         if (candidate) {
             if (candidate->Validate()) {
                 if (ot_.DB().Store(candidate->Contract(), candidate->Alias())) {
-                    Lock mapLock(server_map_lock_);
-                    server_map_[server].reset(candidate.release());
+                    auto& shard = this->shard(server_map_, server);
+                    Lock mapLock(shard.lock_);
+                    shard.map_[server].reset(candidate.release());
                     mapLock.unlock();
+                    shard.added_.notify_all();
                 }
             }
         }
@@ -1206,12 +1211,12 @@ ObjectList Wallet::ServerList() const { return ot_.DB().ServerList(); }
 
 bool Wallet::SetNymAlias(const Identifier& id, const std::string& alias) const
 {
-    Lock mapLock(nym_map_lock_);
+    auto& shard = this->shard(nym_map_, id.str());
+    Lock mapLock(shard.lock_);
+    auto it = shard.map_.find(id.str());
 
-    auto it = nym_map_.find(id.str());
-
-    if (nym_map_.end() != it) {
-        nym_map_.erase(it);
+    if (shard.map_.end() != it) {
+        shard.map_.erase(it);
     }
 
     return ot_.DB().SetNymAlias(id.str(), alias);
@@ -1263,8 +1268,9 @@ bool Wallet::SetServerAlias(const Identifier& id, const std::string& alias)
     const bool saved = ot_.DB().SetServerAlias(server, alias);
 
     if (saved) {
-        Lock mapLock(server_map_lock_);
-        server_map_.erase(server);
+        auto& shard = this->shard(server_map_, server);
+        Lock mapLock(shard.lock_);
+        shard.map_.erase(server);
 
         return true;
     }
@@ -1280,8 +1286,9 @@ bool Wallet::SetUnitDefinitionAlias(
     const bool saved = ot_.DB().SetUnitDefinitionAlias(unit, alias);
 
     if (saved) {
-        Lock mapLock(unit_map_lock_);
-        unit_map_.erase(unit);
+        auto& shard = this->shard(unit_map_, unit);
+        Lock mapLock(shard.lock_);
+        shard.map_.erase(unit);
 
         return true;
     }
@@ -1299,8 +1306,10 @@ const ConstUnitDefinition Wallet::UnitDefinition(
     const std::chrono::milliseconds& timeout) const
 {
     const std::string unit = id.str();
-    Lock mapLock(unit_map_lock_);
-    bool inMap = (unit_map_.find(unit) != unit_map_.end());
+    auto& shard = this->shard(unit_map_, unit);
+    auto& map = shard.map_;
+    Lock mapLock(shard.lock_);
+    bool inMap = (map.find(unit) != map.end());
     bool valid = false;
 
     if (!inMap) {
@@ -1317,47 +1326,36 @@ const ConstUnitDefinition Wallet::UnitDefinition(
             }
 
             if (nym) {
-                auto& pUnit = unit_map_[unit];
+                auto& pUnit = map[unit];
                 pUnit.reset(UnitDefinition::Factory(nym, *serialized));
 
                 if (pUnit) {
                     valid = true;  // Factory() performs validation
                     pUnit->Signable::SetAlias(alias);
                 }
+
+                shard.added_.notify_all();
             }
         } else {
             ot_.DHT().GetUnitDefinition(unit);
 
             if (timeout > std::chrono::milliseconds(0)) {
+                shard.added_.wait_for(mapLock, timeout, [&]() -> bool {
+                    return map.end() != map.find(unit);
+                });
                 mapLock.unlock();
-                auto start = std::chrono::high_resolution_clock::now();
-                auto end = start + timeout;
-                const auto interval = std::chrono::milliseconds(100);
-
-                while (std::chrono::high_resolution_clock::now() < end) {
-                    std::this_thread::sleep_for(interval);
-                    mapLock.lock();
-                    bool found = (unit_map_.find(unit) != unit_map_.end());
-                    mapLock.unlock();
-
-                    if (found) {
-                        break;
-                    }
-                }
 
                 return UnitDefinition(id);  // timeout of zero prevents
                                             // infinite recursion
             }
         }
     } else {
-        auto& pUnit = unit_map_[unit];
-        if (pUnit) {
-            valid = pUnit->Validate();
-        }
+        // See Server()
+        valid = bool(map[unit]);
     }
 
     if (valid) {
-        return unit_map_[unit];
+        return map[unit];
     }
 
     return nullptr;
@@ -1371,9 +1369,11 @@ ConstUnitDefinition Wallet::UnitDefinition(
     if (contract) {
         if (contract->Validate()) {
             if (ot_.DB().Store(contract->Contract(), contract->Alias())) {
-                Lock mapLock(unit_map_lock_);
-                unit_map_[unit].reset(contract.release());
+                auto& shard = this->shard(unit_map_, unit);
+                Lock mapLock(shard.lock_);
+                shard.map_[unit].reset(contract.release());
                 mapLock.unlock();
+                shard.added_.notify_all();
             }
         }
     }
@@ -1398,9 +1398,11 @@ ConstUnitDefinition Wallet::UnitDefinition(
         if (candidate) {
             if (candidate->Validate()) {
                 if (ot_.DB().Store(candidate->Contract(), candidate->Alias())) {
-                    Lock mapLock(unit_map_lock_);
-                    unit_map_[unit].reset(candidate.release());
+                    auto& shard = this->shard(unit_map_, unit);
+                    Lock mapLock(shard.lock_);
+                    shard.map_[unit].reset(candidate.release());
                     mapLock.unlock();
+                    shard.added_.notify_all();
                 }
             }
         }
@@ -1472,5 +1474,26 @@ ConstUnitDefinition Wallet::UnitDefinition(
     return UnitDefinition(Identifier(unit));
 }
 
+bool Wallet::verify_nym(const Lock& lock, NymEntry& entry) const
+{
+    OT_ASSERT(lock.owns_lock());
+    OT_ASSERT(entry.nym_);
+
+    // Every change to a nym's credentials increments its revision, so a
+    // revision which has already been verified does not need to be checked
+    // again.
+    const auto revision = entry.nym_->Revision();
+
+    if (entry.verified_ && (revision == entry.revision_)) {
+
+        return true;
+    }
+
+    entry.verified_ = entry.nym_->VerifyPseudonym();
+    entry.revision_ = revision;
+
+    return entry.verified_;
+}
+
 Wallet::~Wallet() {}
 }  // namespace opentxs::api
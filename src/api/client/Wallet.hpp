@@ -43,10 +43,16 @@
 
 #include "opentxs/api/client/Wallet.hpp"
 
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <tuple>
 
+#define WALLET_CACHE_SHARDS 16
+
 namespace opentxs::api::client::implementation
 {
 class Wallet : virtual public opentxs::api::client::Wallet
@@ -178,14 +184,31 @@ public:
     ~Wallet();
 
 private:
-    typedef std::pair<std::mutex, std::shared_ptr<class Nym>> NymLock;
-    typedef std::map<std::string, NymLock> NymMap;
-    typedef std::map<std::string, std::shared_ptr<class ServerContract>>
-        ServerMap;
-    typedef std::map<std::string, std::shared_ptr<class UnitDefinition>>
-        UnitMap;
+    struct NymEntry {
+        std::shared_ptr<class Nym> nym_{nullptr};
+        // Revision which last passed VerifyPseudonym()
+        std::uint64_t revision_{0};
+        bool verified_{false};
+    };
+
+    /** One slice of a cache. Objects are assigned to a shard by key, so
+     *  lookups for different objects rarely contend for the same mutex. */
+    template <typename Key, typename Value>
+    struct CacheShard {
+        std::mutex lock_{};
+        // Notified whenever an entry is added to map_
+        std::condition_variable added_{};
+        std::map<Key, Value> map_{};
+    };
+    template <typename Key, typename Value>
+    using Cache = std::array<CacheShard<Key, Value>, WALLET_CACHE_SHARDS>;
+
     typedef std::pair<std::string, std::string> ContextID;
-    typedef std::map<ContextID, std::shared_ptr<class Context>> ContextMap;
+    typedef Cache<std::string, NymEntry> NymMap;
+    typedef Cache<std::string, std::shared_ptr<class ServerContract>>
+        ServerMap;
+    typedef Cache<std::string, std::shared_ptr<class UnitDefinition>> UnitMap;
+    typedef Cache<ContextID, std::shared_ptr<class Context>> ContextMap;
     typedef std::pair<Identifier, Identifier> IssuerID;
     typedef std::pair<std::mutex, std::shared_ptr<api::client::Issuer>> IssuerLock;
     typedef std::map<IssuerID, IssuerLock> IssuerMap;
@@ -198,10 +221,6 @@ private:
     mutable UnitMap unit_map_;
     mutable ContextMap context_map_;
     mutable IssuerMap issuer_map_;
-    mutable std::mutex nym_map_lock_;
-    mutable std::mutex server_map_lock_;
-    mutable std::mutex unit_map_lock_;
-    mutable std::mutex context_map_lock_;
     mutable std::mutex issuer_map_lock_;
     mutable std::mutex peer_map_lock_;
     mutable std::map<std::string, std::mutex> peer_lock_;
@@ -212,8 +231,32 @@ private:
     std::mutex& peer_lock(const std::string& nymID) const;
     void save(class Context* context) const;
     void save(const Lock& lock, api::client::Issuer* in) const;
+    bool verify_nym(const Lock& lock, NymEntry& entry) const;
 
+    static std::size_t shard_index(const std::string& key)
+    {
+        return std::hash<std::string>()(key) % WALLET_CACHE_SHARDS;
+    }
+    static std::size_t shard_index(const ContextID& key)
+    {
+        const std::hash<std::string> hash{};
+
+        return (hash(key.first) ^ (hash(key.second) << 1)) %
+               WALLET_CACHE_SHARDS;
+    }
+    template <typename Key, typename Value>
+    static CacheShard<Key, Value>& shard(
+        Cache<Key, Value>& cache,
+        const Key& key)
+    {
+        return cache[shard_index(key)];
+    }
+
+    std::shared_ptr<class Context> context(
+        const Identifier& localNymID,
+        const Identifier& remoteNymID) const;
     std::shared_ptr<class Context> context(
+        const Lock& lock,
         const Identifier& localNymID,
         const Identifier& remoteNymID) const;
     IssuerLock& issuer(
@@ -52,18 +52,22 @@
 #include "opentxs/core/crypto/Libsecp256k1.hpp"
 #endif
 #include "opentxs/core/crypto/Libsodium.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTCachedKey.hpp"
 #if OT_CRYPTO_USING_OPENSSL
 #include "opentxs/core/crypto/OpenSSL.hpp"
 #endif
+#include "opentxs/core/crypto/PrivateKeyCache.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
 #if OT_CRYPTO_USING_TREZOR
-#include "opentxs/core/crypto/OTCachedKey.hpp"
 #include "opentxs/core/crypto/TrezorCrypto.hpp"
 #endif
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/Parallel.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <ostream>
 #include <vector>
@@ -79,6 +83,9 @@ extern "C" {
 #include "Hash.hpp"
 #include "Symmetric.hpp"
 
+#define OT_PRIVATE_KEY_CACHE_SIZE 1024
+#define OT_VERIFY_BATCH_PER_THREAD 16
+
 #define OT_METHOD "opentxs::Crypto::"
 
 namespace opentxs::api::implementation
@@ -87,6 +94,9 @@ namespace opentxs::api::implementation
 Crypto::Crypto(api::Native& native)
     : native_(native)
     , cached_key_lock_()
+    , key_cache_(new PrivateKeyCache(
+          OT_PRIVATE_KEY_CACHE_SIZE,
+          std::chrono::seconds(OT_MASTER_KEY_TIMEOUT)))
     , primary_key_(nullptr)
     , cached_keys_()
 #if OT_CRYPTO_USING_TREZOR
@@ -165,6 +175,7 @@ const OTCachedKey& Crypto::CachedKey(const OTCachedKey& source) const
 
 void Crypto::Cleanup()
 {
+    key_cache_->Clear();
 #if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
     secp256k1_->Cleanup();
 #endif
@@ -259,9 +270,20 @@ void Crypto::init_default_key(const Lock&) const
 {
     if (false == bool(primary_key_)) {
         primary_key_.reset(new OTCachedKey(OT_MASTER_KEY_TIMEOUT));
+
+        OT_ASSERT(primary_key_);
+
+        primary_key_->private_keys_ = key_cache_.get();
     }
 }
 
+const PrivateKeyCache& Crypto::KeyCache() const
+{
+    OT_ASSERT(key_cache_);
+
+    return *key_cache_;
+}
+
 const OTCachedKey& Crypto::LoadDefaultKey(const OTASCIIArmor& serialized) const
 {
     Lock lock(cached_key_lock_);
@@ -302,6 +324,7 @@ void Crypto::SetTimeout(const std::chrono::seconds& timeout) const
     OT_ASSERT(primary_key_);
 
     primary_key_->SetTimeoutSeconds(timeout.count());
+    key_cache_->SetTimeout(timeout);
 }
 
 void Crypto::SetSystemKeyring(const bool useKeyring) const
@@ -360,5 +383,31 @@ std::unique_ptr<SymmetricKey> Crypto::GetStorageKey(__attribute__((unused))
 #endif
 }
 
+std::vector<bool> Crypto::VerifyBatch(
+    const std::vector<SignatureCheck>& batch) const
+{
+    const auto count = batch.size();
+    // std::vector<bool> packs bits, so workers can not safely write to it
+    std::vector<std::uint8_t> results(count, 0);
+    auto verify = [&](const std::size_t i) -> void {
+        const auto& item = batch[i];
+
+        if ((nullptr == item.plaintext_) || (nullptr == item.key_) ||
+            (nullptr == item.signature_)) {
+            otErr << OT_METHOD << "VerifyBatch: Incomplete item " << i
+                  << std::endl;
+
+            return;
+        }
+
+        results[i] = item.key_->engine().Verify(
+            *item.plaintext_, *item.key_, *item.signature_, item.hash_type_);
+    };
+
+    Parallel(count, OT_VERIFY_BATCH_PER_THREAD, verify);
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
 Crypto::~Crypto() { Cleanup(); }
 }  // namespace opentxs::api::implementation
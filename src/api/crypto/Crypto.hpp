@@ -49,6 +49,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace opentxs
 {
@@ -85,6 +86,7 @@ public:
         const OTCachedKey& source) const override;
     EXPORT const OTCachedKey& LoadDefaultKey(
         const OTASCIIArmor& serialized) const override;
+    EXPORT const PrivateKeyCache& KeyCache() const override;
     EXPORT void SetTimeout(const std::chrono::seconds& timeout) const override;
     EXPORT void SetSystemKeyring(const bool useKeyring) const override;
 
@@ -121,6 +123,8 @@ public:
 
     std::unique_ptr<SymmetricKey> GetStorageKey(
         std::string& seed) const override;
+    std::vector<bool> VerifyBatch(
+        const std::vector<SignatureCheck>& batch) const override;
 
     ~Crypto();
 
@@ -129,6 +133,8 @@ private:
 
     api::Native& native_;
     mutable std::mutex cached_key_lock_;
+    // Declared first so that it outlives primary_key_, which clears it
+    std::unique_ptr<PrivateKeyCache> key_cache_;
     mutable std::unique_ptr<OTCachedKey> primary_key_;
     mutable std::map<Identifier, std::unique_ptr<OTCachedKey>> cached_keys_;
 #if OT_CRYPTO_USING_TREZOR
@@ -47,11 +47,50 @@
 #endif
 #include "opentxs/core/Data.hpp"
 
-#include "base64/base64.h"
-
 #include <iostream>
 #include <regex>
 
+namespace
+{
+const char BASE64_CHARACTERS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const std::uint8_t BASE64_PAD{0x40};
+const std::uint8_t BASE64_SKIP{0x80};
+
+// Maps every byte to its six bit value, BASE64_PAD for '=', or BASE64_SKIP
+// for line breaks and any other character outside the alphabet
+struct Base64DecodeTable {
+    std::uint8_t value_[256];
+
+    constexpr Base64DecodeTable()
+        : value_()
+    {
+        for (std::size_t i = 0; i < 256; ++i) {
+            value_[i] = BASE64_SKIP;
+        }
+
+        for (std::uint8_t i = 0; i < 64; ++i) {
+            value_[static_cast<std::uint8_t>(BASE64_CHARACTERS[i])] = i;
+        }
+
+        value_[static_cast<std::uint8_t>('=')] = BASE64_PAD;
+    }
+};
+
+constexpr Base64DecodeTable BASE64_DECODE{};
+
+inline char* encode_group(const std::uint8_t* in, char* out)
+{
+    const std::uint32_t group = (in[0] << 16) | (in[1] << 8) | in[2];
+    out[0] = BASE64_CHARACTERS[(group >> 18) & 0x3f];
+    out[1] = BASE64_CHARACTERS[(group >> 12) & 0x3f];
+    out[2] = BASE64_CHARACTERS[(group >> 6) & 0x3f];
+    out[3] = BASE64_CHARACTERS[group & 0x3f];
+
+    return out + 4;
+}
+}  // namespace
+
 namespace opentxs::api::crypto::implementation
 {
 
@@ -60,62 +99,112 @@ Encode::Encode(CryptoEncoding& base58)
 {
 }
 
+// Line breaks are written during encoding. Each full line is encoded without
+// per-character bookkeeping.
 std::string Encode::Base64Encode(
     const std::uint8_t* inputStart,
     const std::size_t& size) const
 {
-    std::string output;
-    output.resize(::Base64encode_len(size));
-    ::Base64encode(
-        const_cast<char*>(output.data()),
-        reinterpret_cast<const char*>(inputStart),
-        size);
+    static_assert(0 == LineWidth % 4, "Lines must contain whole groups");
 
-    return BreakLines(output);
-}
+    const std::size_t lineBytes = (LineWidth / 4) * 3;
+    const std::size_t encodedSize = 4 * ((size + 2) / 3);
+    const std::size_t lines = (encodedSize + LineWidth - 1) / LineWidth;
+    std::string output(encodedSize + lines, '\n');
 
-bool Encode::Base64Decode(const std::string&& input, RawData& output) const
-{
-    output.resize(::Base64decode_len(input.data()), 0x0);
+    if (0 == size) {
+
+        return output;
+    }
+
+    const auto* in = inputStart;
+    const auto* end = inputStart + size;
+    char* out = &output[0];
+
+    while (lineBytes <= static_cast<std::size_t>(end - in)) {
+        for (std::size_t i = 0; i < lineBytes; i += 3) {
+            out = encode_group(in + i, out);
+        }
 
-    const size_t decoded =
-        ::Base64decode(reinterpret_cast<char*>(output.data()), input.data());
+        in += lineBytes;
+        ++out;  // '\n'
+    }
 
-    if (0 == decoded) {
-        return false;
+    while (3 <= (end - in)) {
+        out = encode_group(in, out);
+        in += 3;
     }
 
-    OT_ASSERT(decoded <= output.size());
+    const auto remaining = end - in;
 
-    output.resize(decoded);
+    if (0 < remaining) {
+        std::uint8_t last[3]{in[0], 0, 0};
 
-    return true;
+        if (2 == remaining) {
+            last[1] = in[1];
+        }
+
+        out = encode_group(last, out);
+        *(out - 1) = '=';
+
+        if (1 == remaining) {
+            *(out - 2) = '=';
+        }
+    }
+
+    return output;
 }
 
-std::string Encode::BreakLines(const std::string& input) const
+// Characters outside the base64 alphabet, including line breaks, are skipped
+// so that the input does not need to be sanitized first. Decoding stops at
+// the first padding character.
+bool Encode::Base64Decode(const std::string& input, RawData& output) const
 {
-    std::string output;
+    output.resize(((input.size() / 4) + 1) * 3);
+    auto* out = output.data();
+    std::uint32_t group{0};
+    std::size_t count{0};
 
-    if (0 == input.size()) {
-        return output;
-    }
+    for (const auto& character : input) {
+        const auto value =
+            BASE64_DECODE.value_[static_cast<std::uint8_t>(character)];
 
-    std::size_t width = 0;
+        if (BASE64_SKIP == value) {
+            continue;
+        }
+
+        if (BASE64_PAD == value) {
+            break;
+        }
 
-    for (auto& character : input) {
-        output.push_back(character);
+        group = (group << 6) | value;
 
-        if (++width >= LineWidth) {
-            output.push_back('\n');
-            width = 0;
+        if (4 == ++count) {
+            *out++ = static_cast<std::uint8_t>(group >> 16);
+            *out++ = static_cast<std::uint8_t>(group >> 8);
+            *out++ = static_cast<std::uint8_t>(group);
+            group = 0;
+            count = 0;
         }
     }
 
-    if ('\n' != output.back()) {
-        output.push_back('\n');
+    switch (count) {
+        case 2: {
+            *out++ = static_cast<std::uint8_t>(group >> 4);
+        } break;
+        case 3: {
+            *out++ = static_cast<std::uint8_t>(group >> 10);
+            *out++ = static_cast<std::uint8_t>(group >> 2);
+        } break;
+        default: {
+        }
     }
 
-    return output;
+    OT_ASSERT(static_cast<std::size_t>(out - output.data()) <= output.size());
+
+    output.resize(out - output.data());
+
+    return (0 < output.size());
 }
 
 std::string Encode::DataEncode(const std::string& input) const
@@ -134,7 +223,7 @@ std::string Encode::DataDecode(const std::string& input) const
 {
     RawData decoded;
 
-    if (Base64Decode(SanatizeBase64(input), decoded)) {
+    if (Base64Decode(input, decoded)) {
 
         return std::string(
             reinterpret_cast<const char*>(decoded.data()), decoded.size());
@@ -209,6 +298,18 @@ std::string Encode::SanatizeBase58(const std::string& input) const
 
 std::string Encode::SanatizeBase64(const std::string& input) const
 {
-    return std::regex_replace(input, std::regex("[^0-9A-Za-z+/=]"), "");
+    std::string output;
+    output.reserve(input.size());
+
+    for (const auto& character : input) {
+        const auto value =
+            BASE64_DECODE.value_[static_cast<std::uint8_t>(character)];
+
+        if (BASE64_SKIP != value) {
+            output.push_back(character);
+        }
+    }
+
+    return output;
 }
 }  // namespace opentxs::api::crypto::implementation
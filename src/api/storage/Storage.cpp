@@ -41,6 +41,7 @@
 #include "Storage.hpp"
 
 #include "opentxs/storage/drivers/StorageMultiplex.hpp"
+#include "opentxs/storage/drivers/StorageThrottle.hpp"
 #include "opentxs/storage/tree/BlockchainTransactions.hpp"
 #include "opentxs/storage/tree/Contacts.hpp"
 #include "opentxs/storage/tree/Contexts.hpp"
@@ -67,6 +68,9 @@
 #include <stdexcept>
 #include <utility>
 
+// Maximum number of mutations which may share a single root commit
+#define OT_STORAGE_GROUP_COMMIT_LIMIT 1024
+
 #define OT_METHOD "opentxs::api::storage::implementation::Storage::"
 
 namespace opentxs::api::storage::implementation
@@ -83,7 +87,16 @@ Storage::Storage(
     const Random& random)
     : running_(running)
     , gc_interval_(config.gc_interval_)
+    , group_commit_window_(config.group_commit_window_)
     , write_lock_()
+    , waiting_writers_(0)
+    , committed_()
+    , batch_depth_(0)
+    , batch_threads_()
+    , uncommitted_(0)
+    , first_uncommitted_()
+    , write_sequence_(0)
+    , commit_sequence_(0)
     , root_(nullptr)
     , primary_bucket_(Flag::Factory(false))
     , background_threads_()
@@ -98,8 +111,22 @@ Storage::Storage(
           hash,
           random))
     , multiplex_(*multiplex_p_)
+    , gc_target_(new StorageThrottle(
+          multiplex_.Primary(),
+          config_.gc_objects_per_second_))
 {
     OT_ASSERT(multiplex_p_);
+    OT_ASSERT(gc_target_);
+}
+
+void Storage::BeginBatch() const
+{
+    Lock lock(write_lock_);
+    ++batch_threads_[std::this_thread::get_id()];
+
+    if (0 == batch_depth_++) {
+        multiplex_.BeginBatch();
+    }
 }
 
 std::set<std::string> Storage::BlockchainAccountList(
@@ -130,6 +157,22 @@ void Storage::Cleanup_Storage()
         }
     }
 
+    Lock lock(write_lock_);
+
+    if (0 < batch_depth_) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Committing unfinished write batch." << std::endl;
+        batch_depth_ = 0;
+        batch_threads_.clear();
+        multiplex_.EndBatch();
+    }
+
+    if (0 < uncommitted_) {
+        commit(lock);
+    }
+
+    lock.unlock();
+
     if (root_) {
         root_->cleanup();
     }
@@ -137,7 +180,20 @@ void Storage::Cleanup_Storage()
 
 void Storage::Cleanup() { Cleanup_Storage(); }
 
-void Storage::CollectGarbage() const { Root().Migrate(multiplex_.Primary()); }
+void Storage::CollectGarbage() const { Root().Migrate(*gc_target_); }
+
+bool Storage::commit(const Lock& lock) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+    OT_ASSERT(root_);
+
+    uncommitted_ = 0;
+    const bool output = multiplex_.StoreRoot(true, root_->root_);
+    commit_sequence_ = write_sequence_;
+    committed_.notify_all();
+
+    return output;
+}
 
 std::string Storage::ContactAlias(const std::string& id) const
 {
@@ -205,6 +261,35 @@ bool Storage::DeleteContact(const std::string& id) const
         .Delete(id);
 }
 
+bool Storage::EndBatch() const
+{
+    Lock lock(write_lock_);
+
+    OT_ASSERT(0 < batch_depth_);
+
+    auto it = batch_threads_.find(std::this_thread::get_id());
+
+    OT_ASSERT(batch_threads_.end() != it);
+
+    if (0 == --it->second) {
+        batch_threads_.erase(it);
+    }
+
+    if (0 < --batch_depth_) {
+
+        return true;
+    }
+
+    multiplex_.EndBatch();
+
+    if (0 == uncommitted_) {
+
+        return true;
+    }
+
+    return commit(lock);
+}
+
 std::uint32_t Storage::HashType() const { return HASH_TYPE; }
 
 void Storage::InitBackup() { multiplex_.InitBackup(); }
@@ -588,6 +673,8 @@ bool Storage::MoveThreadItem(
         return false;
     }
 
+    // Both threads and their common ancestors are committed together
+    Batch batch(*this);
     auto& fromThread = mutable_Root()
                            .It()
                            .mutable_Tree()
@@ -659,7 +746,12 @@ Editor<opentxs::storage::Root> Storage::mutable_Root() const
         this->save(in, lock);
     };
 
-    return Editor<opentxs::storage::Root>(write_lock_, root(), callback);
+    auto* root = this->root();
+    ++waiting_writers_;
+    Editor<opentxs::storage::Root> output(write_lock_, root, callback);
+    --waiting_writers_;
+
+    return output;
 }
 
 ObjectList Storage::NymBoxList(const std::string& nymID, const StorageBox box)
@@ -724,6 +816,16 @@ ObjectList Storage::NymBoxList(const std::string& nymID, const StorageBox box)
 
 ObjectList Storage::NymList() const { return Root().Tree().NymNode().List(); }
 
+std::uint64_t Storage::ObjectCacheHits() const
+{
+    return multiplex_.cache_.Hits();
+}
+
+std::uint64_t Storage::ObjectCacheMisses() const
+{
+    return multiplex_.cache_.Misses();
+}
+
 bool Storage::RelabelThread(
     const std::string& threadID,
     const std::string& label) const
@@ -973,12 +1075,42 @@ void Storage::RunMapUnits(UnitLambda lambda) const
     return Root().Tree().UnitNode().Map(lambda);
 }
 
-void Storage::save(opentxs::storage::Root* in, const Lock& lock) const
+void Storage::save(opentxs::storage::Root* in, Lock& lock) const
 {
     OT_ASSERT(verify_write_lock(lock));
     OT_ASSERT(nullptr != in);
 
-    multiplex_.StoreRoot(true, in->root_);
+    const auto now = std::chrono::steady_clock::now();
+    const auto sequence = ++write_sequence_;
+
+    if (0 == uncommitted_++) {
+        first_uncommitted_ = now;
+    }
+
+    // Changes made inside a batch are committed when the thread which opened
+    // it ends the outermost batch
+    if (0 < batch_threads_.count(std::this_thread::get_id())) {
+
+        return;
+    }
+
+    // A writer which is already waiting for the lock will commit this change
+    // together with its own, as long as the oldest uncommitted change is
+    // still inside the group commit window
+    if (0 == batch_depth_) {
+        const bool waiting = (0 < waiting_writers_.load());
+        const bool expired =
+            ((now - first_uncommitted_) >= group_commit_window_) ||
+            (OT_STORAGE_GROUP_COMMIT_LIMIT <= uncommitted_);
+
+        if ((false == waiting) || expired) {
+            commit(lock);
+
+            return;
+        }
+    }
+
+    wait_for_commit(lock, sequence);
 }
 
 bool Storage::SetContactAlias(const std::string& id, const std::string& alias)
@@ -1590,5 +1722,27 @@ bool Storage::verify_write_lock(const Lock& lock) const
     return true;
 }
 
+// Returns once the change with the given sequence number has been committed.
+// A batch held open by another thread commits when it ends. Otherwise, if the
+// writer which should have committed the change has not done so within the
+// group commit window, the change is committed here.
+void Storage::wait_for_commit(Lock& lock, const std::uint64_t sequence) const
+{
+    while (commit_sequence_ < sequence) {
+        if (0 < batch_depth_) {
+            committed_.wait(lock);
+
+            continue;
+        }
+
+        const auto status = committed_.wait_for(lock, group_commit_window_);
+
+        if ((std::cv_status::timeout == status) &&
+            (commit_sequence_ < sequence) && (0 == batch_depth_)) {
+            commit(lock);
+        }
+    }
+}
+
 Storage::~Storage() { Cleanup_Storage(); }
 }  // namespace opentxs::api::storage::implementation
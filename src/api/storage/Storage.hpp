@@ -46,6 +46,10 @@
 #include "opentxs/storage/StorageConfig.hpp"
 #include "opentxs/core/Flag.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <list>
@@ -88,6 +92,7 @@ namespace implementation
 class Storage : public opentxs::api::storage::Storage
 {
 public:
+    void BeginBatch() const override;
     std::set<std::string> BlockchainAccountList(
         const std::string& nymID,
         const proto::ContactItemType type) const override;
@@ -107,6 +112,7 @@ public:
         const std::set<std::string>& participants) const override;
     std::string DefaultSeed() const override;
     bool DeleteContact(const std::string& id) const override;
+    bool EndBatch() const override;
     std::uint32_t HashType() const override;
     ObjectList IssuerList(const std::string& nymID) const override;
     bool Load(
@@ -212,6 +218,8 @@ public:
     ObjectList NymBoxList(const std::string& nymID, const StorageBox box)
         const override;
     ObjectList NymList() const override;
+    std::uint64_t ObjectCacheHits() const override;
+    std::uint64_t ObjectCacheMisses() const override;
     bool RelabelThread(const std::string& threadID, const std::string& label)
         const override;
     bool RemoveNymBoxItem(
@@ -310,21 +318,33 @@ private:
 
     const Flag& running_;
     std::int64_t gc_interval_{std::numeric_limits<std::int64_t>::max()};
+    const std::chrono::milliseconds group_commit_window_;
     mutable std::mutex write_lock_;
+    mutable std::atomic<std::size_t> waiting_writers_{0};
+    mutable std::condition_variable committed_;
+    mutable std::size_t batch_depth_{0};
+    mutable std::map<std::thread::id, std::size_t> batch_threads_;
+    mutable std::size_t uncommitted_{0};
+    mutable std::chrono::steady_clock::time_point first_uncommitted_{};
+    mutable std::uint64_t write_sequence_{0};
+    mutable std::uint64_t commit_sequence_{0};
     mutable std::unique_ptr<opentxs::storage::Root> root_;
     mutable OTFlag primary_bucket_;
     std::vector<std::thread> background_threads_;
     const StorageConfig config_;
     std::unique_ptr<StorageMultiplex> multiplex_p_;
     StorageMultiplex& multiplex_;
+    std::unique_ptr<StorageThrottle> gc_target_;
 
     opentxs::storage::Root* root() const;
     const opentxs::storage::Root& Root() const;
     bool verify_write_lock(const Lock& lock) const;
+    void wait_for_commit(Lock& lock, const std::uint64_t sequence) const;
 
     void Cleanup();
     void Cleanup_Storage();
     void CollectGarbage() const;
+    bool commit(const Lock& lock) const;
     void InitBackup();
     void InitEncryptedBackup(std::unique_ptr<SymmetricKey>& key);
     void InitPlugins();
@@ -332,7 +352,7 @@ private:
     void RunMapPublicNyms(NymLambda lambda) const;
     void RunMapServers(ServerLambda lambda) const;
     void RunMapUnits(UnitLambda lambda) const;
-    void save(opentxs::storage::Root* in, const Lock& lock) const;
+    void save(opentxs::storage::Root* in, Lock& lock) const;
     void start();
 
     Storage(
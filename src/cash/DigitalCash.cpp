@@ -129,6 +129,8 @@ LucreDumper::~LucreDumper()
 #endif
 }
 
+void InstallLucreDumper() { static LucreDumper dumper{}; }
+
 #else  // No digital cash lib is selected? Perhaps error message here?
 
 #endif  // Which digital cash library we're using.
@@ -41,6 +41,7 @@
 #include "opentxs/cash/Mint.hpp"
 
 #include "opentxs/cash/MintLucre.hpp"
+#include "opentxs/cash/Token.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Identifier.hpp"
@@ -50,23 +51,34 @@
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/OTEnvelope.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/Parallel.hpp"
 #include "opentxs/core/util/Tag.hpp"
+#include "opentxs/Types.hpp"
 
 #include <irrxml/irrXML.hpp>
 #include <stdint.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
+
+#define OT_MINT_TOKENS_PER_THREAD 4
+
+#define OT_METHOD "opentxs::Mint::"
 
 namespace opentxs
 {
-
 // static
 Mint* Mint::MintFactory()
 {
@@ -168,6 +180,9 @@ void Mint::ReleaseDenominations()
         delete pArmor;
         pArmor = nullptr;
     }
+
+    Lock lock(m_lockOpened);
+    m_mapOpened.clear();
 }
 
 // If you want to load a certain Mint from string, then
@@ -504,6 +519,65 @@ bool Mint::GetPrivate(OTASCIIArmor& theArmor, int64_t lDenomination)
     return false;
 }
 
+std::shared_ptr<const OTOpenedMint> Mint::GetOpenedPrivate(
+    const Nym& theNotary,
+    int64_t lDenomination)
+{
+    Lock lock(m_lockOpened);
+    auto& output = m_mapOpened[lDenomination];
+
+    if (output) {
+
+        return output;
+    }
+
+    OTASCIIArmor thePrivate;
+
+    if (false == GetPrivate(thePrivate, lDenomination)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Missing private mint for "
+              << "denomination " << lDenomination << std::endl;
+        m_mapOpened.erase(lDenomination);
+
+        return {};
+    }
+
+    OTEnvelope theEnvelope(thePrivate);
+    String strContents;  // zeroed when it goes out of scope
+
+    if (false == theEnvelope.Open(theNotary, strContents)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open private mint "
+              << "for denomination " << lDenomination << std::endl;
+        m_mapOpened.erase(lDenomination);
+
+        return {};
+    }
+
+    std::shared_ptr<OTOpenedMint> pOpened(new OTOpenedMint);
+
+    OT_ASSERT(pOpened)
+
+    // An OTPassword holds at most one block, so the contents are copied
+    // into as many of them as it takes.
+    const char* pContents = strContents.Get();
+    std::size_t remaining = strContents.GetLength();
+
+    while (0 < remaining) {
+        std::unique_ptr<OTPassword> pBlock(new OTPassword);
+
+        OT_ASSERT(pBlock)
+
+        const auto size = std::min(remaining, pBlock->getBlockSize());
+        pBlock->setMemory(pContents, size);
+        pContents += size;
+        remaining -= size;
+        pOpened->push_back(std::move(pBlock));
+    }
+
+    output = pOpened;
+
+    return output;
+}
+
 // The mint has a different key pair for each denomination.
 // Pass in the actual denomination such as 5, 10, 20, 50, 100...
 bool Mint::GetPublic(OTASCIIArmor& theArmor, int64_t lDenomination)
@@ -882,4 +956,61 @@ void Mint::GenerateNewMint(
     }
 }
 
+std::vector<bool> Mint::SignTokens(
+    const Nym& theNotary,
+    const std::vector<Token*>& theTokens,
+    std::vector<String>& theOutput,
+    int32_t nTokenIndex)
+{
+    const auto count = theTokens.size();
+    // std::vector<bool> can not be written from several threads
+    std::vector<std::uint8_t> results(count, 0);
+    theOutput.assign(count, String());
+
+    // Open every private key involved before starting any threads
+    for (const auto& pToken : theTokens) {
+        if (nullptr != pToken) {
+            GetOpenedPrivate(theNotary, pToken->GetDenomination());
+        }
+    }
+
+    auto sign = [&](const std::size_t i) -> void {
+        auto pToken = theTokens[i];
+
+        if (nullptr == pToken) {
+
+            return;
+        }
+
+        results[i] = SignToken(theNotary, *pToken, theOutput[i], nTokenIndex);
+    };
+
+    Parallel(count, OT_MINT_TOKENS_PER_THREAD, sign);
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+std::vector<bool> Mint::VerifyTokens(
+    const Nym& theNotary,
+    std::vector<String>& theCleartextTokens,
+    const std::vector<int64_t>& theDenominations)
+{
+    OT_ASSERT(theCleartextTokens.size() == theDenominations.size())
+
+    const auto count = theCleartextTokens.size();
+    std::vector<std::uint8_t> results(count, 0);
+
+    for (const auto& denomination : theDenominations) {
+        GetOpenedPrivate(theNotary, denomination);
+    }
+
+    auto verify = [&](const std::size_t i) -> void {
+        results[i] = VerifyToken(
+            theNotary, theCleartextTokens[i], theDenominations[i]);
+    };
+
+    Parallel(count, OT_MINT_TOKENS_PER_THREAD, verify);
+
+    return std::vector<bool>(results.begin(), results.end());
+}
 }  // namespace opentxs
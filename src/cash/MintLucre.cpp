@@ -49,15 +49,18 @@
 #endif
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
+#include "opentxs/Types.hpp"
 
 #include <openssl/bio.h>
 #include <openssl/bn.h>
 #include <openssl/ossl_typ.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <memory>
 #include <ostream>
 
 #ifdef __APPLE__
@@ -68,6 +71,18 @@ namespace opentxs
 {
 
 #if OT_CASH_USING_LUCRE
+namespace
+{
+// Copies an opened private mint into a BIO, one block at a time.
+void write_opened(BIO* bio, const OTOpenedMint& opened)
+{
+    for (const auto& pBlock : opened) {
+        OT_ASSERT(pBlock)
+
+        BIO_write(bio, pBlock->getMemory(), pBlock->getMemorySize());
+    }
+}
+}  // namespace
 
 MintLucre::MintLucre()
     : ot_super()
@@ -205,26 +220,24 @@ bool MintLucre::SignToken(
 {
     bool bReturnValue = false;
 
-    LucreDumper setDumper;
+    InstallLucreDumper();
 
     OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());       // input
     OpenSSL_BIO bioRequest = BIO_new(BIO_s_mem());    // input
     OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());  // output
 
-    OTASCIIArmor thePrivate;
-    GetPrivate(thePrivate, theToken.GetDenomination());
-
     // The Mint private info is encrypted in
     // m_mapPrivates[theToken.GetDenomination()].
-    // So I need to extract that first before I can use it.
-    OTEnvelope theEnvelope(thePrivate);
+    // The opened copy is kept, so the envelope is only opened once.
+    auto pContents = GetOpenedPrivate(theNotary, theToken.GetDenomination());
 
-    String strContents;  // output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (!theEnvelope.Open(theNotary, strContents)) return false;
+    if (false == bool(pContents)) {
 
-    // copy strContents to a BIO
-    BIO_puts(bioBank, strContents.Get());
+        return false;
+    }
+
+    // copy the opened contents to a BIO
+    write_opened(bioBank, *pContents);
 
     // Instantiate the Bank with its private key
     Bank bank(bioBank);
@@ -313,7 +326,7 @@ bool MintLucre::VerifyToken(
     int64_t lDenomination)
 {
     bool bReturnValue = false;
-    LucreDumper setDumper;
+    InstallLucreDumper();
 
     OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());  // input
     OpenSSL_BIO bioCoin = BIO_new(BIO_s_mem());  // input
@@ -322,16 +335,12 @@ bool MintLucre::VerifyToken(
     BIO_puts(bioCoin, theCleartextToken.Get());
 
     // --- The Mint private info is encrypted in m_mapPrivate[lDenomination].
-    // So I need to extract that first before I can use it.
-    OTASCIIArmor theArmor;
-    GetPrivate(theArmor, lDenomination);
-    OTEnvelope theEnvelope(theArmor);
-
-    String strContents;  // will contain output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (theEnvelope.Open(theNotary, strContents)) {
-        // copy strContents to a BIO
-        BIO_puts(bioBank, strContents.Get());
+    // The opened copy is kept, so the envelope is only opened once.
+    auto pContents = GetOpenedPrivate(theNotary, lDenomination);
+
+    if (pContents) {
+        // copy the opened contents to a BIO
+        write_opened(bioBank, *pContents);
 
         // ---- Now the bank and coin bios are both ready to go...
 
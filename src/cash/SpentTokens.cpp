@@ -0,0 +1,729 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/cash/SpentTokens.hpp"
+
+#if OT_CASH
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/OTPaths.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/Types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+}
+
+#define OT_SPENT_RECORD_SIZE 32
+#define OT_SPENT_MERGE_THRESHOLD 4096
+#define OT_SPENT_BLOOM_BITS_PER_TOKEN 16
+#define OT_SPENT_BLOOM_HASHES 7
+#define OT_SPENT_BLOOM_MINIMUM_BITS (1 << 20)
+#define OT_SPENT_MAX_LOADED_SERIES 32
+#define OT_SPENT_INDEX_EXTENSION ".idx"
+#define OT_SPENT_LOG_EXTENSION ".log"
+#define OT_SPENT_TEMP_EXTENSION ".tmp"
+
+#define OT_METHOD "opentxs::SpentTokens::"
+
+namespace opentxs
+{
+namespace
+{
+using Record = std::array<std::uint8_t, OT_SPENT_RECORD_SIZE>;
+
+struct Series {
+    std::mutex lock_{};
+    bool loaded_{false};
+    // Tokens spent before this store existed are one file per token
+    bool legacy_{false};
+    std::string folder_{};
+    std::string index_{};
+    std::string log_{};
+    // Number of records in the index file
+    std::size_t indexed_{0};
+    // Records in the log file, not yet merged into the index
+    std::set<Record> recent_{};
+    std::vector<bool> bloom_{};
+};
+
+struct LoadedSeries {
+    std::shared_ptr<Series> series_{};
+    std::uint64_t last_used_{0};
+};
+
+std::mutex series_lock_{};
+std::uint64_t series_counter_{0};
+std::map<std::string, LoadedSeries> series_{};
+
+std::string series_name(const Identifier& unitID, const std::int32_t series)
+{
+    return unitID.str() + "." + std::to_string(series);
+}
+
+Record make_record(const Identifier& token)
+{
+    Record output{};
+    const auto size = std::min(token.GetSize(), output.size());
+    std::memcpy(output.data(), token.GetPointer(), size);
+
+    return output;
+}
+
+bool sync_fd(const int fd)
+{
+#if defined(_WIN32)
+    return 0 == ::_commit(fd);
+#elif defined(__APPLE__)
+    return 0 == ::fcntl(fd, F_FULLFSYNC);
+#else
+    return 0 == ::fsync(fd);
+#endif
+}
+
+// Appends a record and does not return until it is on disk, since the caller
+// credits the depositor as soon as this succeeds
+bool append_record(const std::string& path, const Record& record)
+{
+#ifdef _WIN32
+    const int fd = ::_open(
+        path.c_str(),
+        _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY,
+        _S_IREAD | _S_IWRITE);
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0600);
+#endif
+
+    if (-1 == fd) {
+
+        return false;
+    }
+
+#ifdef _WIN32
+    const auto written = ::_write(fd, record.data(), record.size());
+#else
+    const auto written = ::write(fd, record.data(), record.size());
+#endif
+    const bool output = (static_cast<std::size_t>(written) == record.size()) &&
+                        sync_fd(fd);
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+
+    return output;
+}
+
+bool sync_file(const std::string& path)
+{
+#ifdef _WIN32
+    const int fd = ::_open(path.c_str(), _O_WRONLY | _O_BINARY);
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY);
+#endif
+
+    if (-1 == fd) {
+
+        return false;
+    }
+
+    const bool output = sync_fd(fd);
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+
+    return output;
+}
+
+bool make_paths(const std::string& name, Series& series)
+{
+    String spentFolder{""};
+    String indexFile{""};
+    String logFile{""};
+    String legacyFolder{""};
+
+    if (false == OTPaths::AppendFolder(
+                     spentFolder, OTDataFolder::Get(), OTFolders::Spent())) {
+
+        return false;
+    }
+
+    bool created{false};
+
+    if (false == OTPaths::BuildFolderPath(spentFolder, created)) {
+
+        return false;
+    }
+
+    const std::string index{name + OT_SPENT_INDEX_EXTENSION};
+    const std::string log{name + OT_SPENT_LOG_EXTENSION};
+
+    if (false ==
+        OTPaths::AppendFile(indexFile, spentFolder, String(index.c_str()))) {
+
+        return false;
+    }
+
+    if (false ==
+        OTPaths::AppendFile(logFile, spentFolder, String(log.c_str()))) {
+
+        return false;
+    }
+
+    if (false ==
+        OTPaths::AppendFolder(legacyFolder, spentFolder, String(name.c_str()))) {
+
+        return false;
+    }
+
+    series.folder_ = name;
+    series.index_ = indexFile.Get();
+    series.log_ = logFile.Get();
+    series.legacy_ = OTPaths::FolderExists(legacyFolder);
+
+    return true;
+}
+
+void bloom_positions(
+    const Record& record,
+    const std::size_t bits,
+    std::array<std::size_t, OT_SPENT_BLOOM_HASHES>& output)
+{
+    // The record is already a cryptographic hash, so two of its words are
+    // enough to derive every position
+    std::uint64_t first{0};
+    std::uint64_t second{0};
+    std::memcpy(&first, record.data(), sizeof(first));
+    std::memcpy(&second, record.data() + sizeof(first), sizeof(second));
+    second |= 1;
+
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        output[i] = (first + i * second) % bits;
+    }
+}
+
+void bloom_add(Series& series, const Record& record)
+{
+    std::array<std::size_t, OT_SPENT_BLOOM_HASHES> positions{};
+    bloom_positions(record, series.bloom_.size(), positions);
+
+    for (const auto& position : positions) {
+        series.bloom_[position] = true;
+    }
+}
+
+bool bloom_check(const Series& series, const Record& record)
+{
+    std::array<std::size_t, OT_SPENT_BLOOM_HASHES> positions{};
+    bloom_positions(record, series.bloom_.size(), positions);
+
+    for (const auto& position : positions) {
+        if (false == series.bloom_[position]) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t file_records(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (false == file.good()) {
+
+        return 0;
+    }
+
+    return static_cast<std::size_t>(file.tellg()) / OT_SPENT_RECORD_SIZE;
+}
+
+bool build_bloom(Series& series)
+{
+    const auto expected = series.indexed_ + OT_SPENT_MERGE_THRESHOLD;
+    const std::size_t bits = std::max<std::size_t>(
+        OT_SPENT_BLOOM_MINIMUM_BITS, expected * OT_SPENT_BLOOM_BITS_PER_TOKEN);
+    series.bloom_.assign(bits, false);
+
+    if (0 < series.indexed_) {
+        std::ifstream index(series.index_, std::ios::binary);
+        Record record{};
+
+        for (std::size_t i = 0; i < series.indexed_; ++i) {
+            if (false == bool(index.read(
+                             reinterpret_cast<char*>(record.data()),
+                             record.size()))) {
+                otErr << OT_METHOD << __FUNCTION__ << ": Failed to read "
+                      << series.index_ << std::endl;
+
+                return false;
+            }
+
+            bloom_add(series, record);
+        }
+    }
+
+    for (const auto& record : series.recent_) {
+        bloom_add(series, record);
+    }
+
+    return true;
+}
+
+bool load(const std::string& name, Series& series)
+{
+    if (series.loaded_) {
+
+        return true;
+    }
+
+    if (false == make_paths(name, series)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to locate spent token folder." << std::endl;
+
+        return false;
+    }
+
+    series.indexed_ = file_records(series.index_);
+    series.recent_.clear();
+    bool partial{false};
+
+    {
+        std::ifstream log(series.log_, std::ios::binary);
+        Record record{};
+
+        while (log.read(
+            reinterpret_cast<char*>(record.data()), record.size())) {
+            series.recent_.insert(record);
+        }
+
+        // A partial record at the end of the log is a write which never
+        // finished, so the token it describes was never credited. It has to
+        // go before anything else is appended.
+        partial = (0 < log.gcount());
+    }
+
+    if (partial) {
+        std::ofstream log(series.log_, std::ios::binary | std::ios::trunc);
+
+        for (const auto& record : series.recent_) {
+            log.write(
+                reinterpret_cast<const char*>(record.data()), record.size());
+        }
+
+        log.close();
+
+        if (log.fail() || (false == sync_file(series.log_))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to rewrite "
+                  << series.log_ << std::endl;
+
+            return false;
+        }
+    }
+
+    if (false == build_bloom(series)) {
+
+        return false;
+    }
+
+    series.loaded_ = true;
+
+    return true;
+}
+
+bool index_contains(const Series& series, const Record& record)
+{
+    if (0 == series.indexed_) {
+
+        return false;
+    }
+
+    std::ifstream index(series.index_, std::ios::binary);
+
+    if (false == index.good()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open "
+              << series.index_ << std::endl;
+
+        // Treat an unreadable index as a match
+        return true;
+    }
+
+    std::size_t low{0};
+    std::size_t high{series.indexed_};
+    Record candidate{};
+
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        index.seekg(middle * OT_SPENT_RECORD_SIZE);
+
+        if (false == bool(index.read(
+                         reinterpret_cast<char*>(candidate.data()),
+                         candidate.size()))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to read "
+                  << series.index_ << std::endl;
+
+            return true;
+        }
+
+        if (candidate == record) {
+
+            return true;
+        }
+
+        if (candidate < record) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return false;
+}
+
+bool legacy_contains(const Series& series, const Identifier& token)
+{
+    if (false == series.legacy_) {
+
+        return false;
+    }
+
+    return OTDB::Exists(
+        OTFolders::Spent().Get(), series.folder_, token.str());
+}
+
+bool contains(
+    const Series& series,
+    const Record& record,
+    const Identifier& token)
+{
+    if (bloom_check(series, record)) {
+        if (1 == series.recent_.count(record)) {
+
+            return true;
+        }
+
+        if (index_contains(series, record)) {
+
+            return true;
+        }
+    }
+
+    return legacy_contains(series, token);
+}
+
+bool merge(Series& series)
+{
+    const std::string temp{series.index_ + OT_SPENT_TEMP_EXTENSION};
+
+    {
+        std::ifstream index(series.index_, std::ios::binary);
+        std::ofstream output(temp, std::ios::binary | std::ios::trunc);
+        auto recent = series.recent_.begin();
+        Record record{};
+        std::size_t written{0};
+        bool haveLast{false};
+        Record last{};
+
+        auto write = [&](const Record& next) -> void {
+            // The log may still hold records which were merged just before
+            // a crash
+            if (haveLast && (last == next)) {
+
+                return;
+            }
+
+            output.write(reinterpret_cast<const char*>(next.data()), next.size());
+            last = next;
+            haveLast = true;
+            ++written;
+        };
+
+        for (std::size_t i = 0; i < series.indexed_; ++i) {
+            if (false == bool(index.read(
+                             reinterpret_cast<char*>(record.data()),
+                             record.size()))) {
+                otErr << OT_METHOD << __FUNCTION__ << ": Failed to read "
+                      << series.index_ << std::endl;
+
+                return false;
+            }
+
+            while ((series.recent_.end() != recent) && (*recent < record)) {
+                write(*recent++);
+            }
+
+            write(record);
+        }
+
+        while (series.recent_.end() != recent) {
+            write(*recent++);
+        }
+
+        output.close();
+
+        if (output.fail() || (false == sync_file(temp))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << temp
+                  << std::endl;
+
+            return false;
+        }
+
+        series.indexed_ = written;
+    }
+
+    if (0 != std::rename(temp.c_str(), series.index_.c_str())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to replace "
+              << series.index_ << std::endl;
+        // The old index and the log are both intact, so the next load
+        // starts over from them
+        series.loaded_ = false;
+
+        return false;
+    }
+
+    std::ofstream log(series.log_, std::ios::binary | std::ios::trunc);
+    series.recent_.clear();
+
+    if (false == log.good()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to truncate "
+              << series.log_ << std::endl;
+        // Everything in the log is also in the index now, so nothing is lost
+        // but the log will be merged again after the next load.
+        series.loaded_ = false;
+
+        return false;
+    }
+
+    const std::size_t capacity =
+        series.bloom_.size() / OT_SPENT_BLOOM_BITS_PER_TOKEN;
+
+    if (capacity < (series.indexed_ + OT_SPENT_MERGE_THRESHOLD)) {
+        if (false == build_bloom(series)) {
+            series.loaded_ = false;
+        }
+    }
+
+    return true;
+}
+
+// Drops the least recently used series which no thread is using, so that the
+// number of series held in memory stays bounded
+void evict_series(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock())
+
+    auto oldest = series_.end();
+
+    for (auto it = series_.begin(); it != series_.end(); ++it) {
+        if (1 < it->second.series_.use_count()) {
+
+            continue;
+        }
+
+        if ((series_.end() == oldest) ||
+            (it->second.last_used_ < oldest->second.last_used_)) {
+            oldest = it;
+        }
+    }
+
+    if (series_.end() != oldest) {
+        series_.erase(oldest);
+    }
+}
+
+std::shared_ptr<Series> get_series(const std::string& name)
+{
+    Lock lock(series_lock_);
+    auto it = series_.find(name);
+
+    if (series_.end() == it) {
+        if (OT_SPENT_MAX_LOADED_SERIES <= series_.size()) {
+            evict_series(lock);
+        }
+
+        it = series_.emplace(name, LoadedSeries{}).first;
+        it->second.series_.reset(new Series);
+    }
+
+    auto& output = it->second;
+    output.last_used_ = ++series_counter_;
+
+    OT_ASSERT(output.series_)
+
+    return output.series_;
+}
+}  // namespace
+
+bool SpentTokens::Contains(
+    const Identifier& unitID,
+    const std::int32_t series,
+    const Identifier& token)
+{
+    const auto name = series_name(unitID, series);
+    auto pSeries = get_series(name);
+    auto& store = *pSeries;
+    Lock lock(store.lock_);
+
+    if (false == load(name, store)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load spent tokens "
+              << "for series " << name << std::endl;
+
+        return true;
+    }
+
+    return contains(store, make_record(token), token);
+}
+
+bool SpentTokens::Expire(const Identifier& unitID, const std::int32_t series)
+{
+    const auto name = series_name(unitID, series);
+    std::shared_ptr<Series> pSeries{};
+
+    {
+        Lock lock(series_lock_);
+        auto it = series_.find(name);
+
+        if (series_.end() != it) {
+            pSeries = it->second.series_;
+            series_.erase(it);
+        }
+    }
+
+    Series store{};
+
+    if (false == make_paths(name, store)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to locate spent token folder." << std::endl;
+
+        return false;
+    }
+
+    Lock lock;
+
+    // Wait for any lookup which found the series before it was removed
+    if (pSeries) {
+        lock = Lock(pSeries->lock_);
+    }
+
+    const bool index = (0 == std::remove(store.index_.c_str()));
+    const bool log = (0 == std::remove(store.log_.c_str()));
+
+    if (index || log) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Removed spent tokens for "
+               << "expired series " << name << std::endl;
+    }
+
+    return index || log;
+}
+
+bool SpentTokens::Insert(
+    const Identifier& unitID,
+    const std::int32_t series,
+    const Identifier& token)
+{
+    const auto name = series_name(unitID, series);
+    auto pSeries = get_series(name);
+    auto& store = *pSeries;
+    Lock lock(store.lock_);
+
+    if (false == load(name, store)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load spent tokens "
+              << "for series " << name << std::endl;
+
+        return false;
+    }
+
+    const auto record = make_record(token);
+
+    if (contains(store, record, token)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Token already recorded in "
+              << "series " << name << std::endl;
+
+        return false;
+    }
+
+    if (false == append_record(store.log_, record)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to append to "
+              << store.log_ << std::endl;
+        // Part of the record may have been written
+        store.loaded_ = false;
+
+        return false;
+    }
+
+    store.recent_.insert(record);
+    bloom_add(store, record);
+
+    if (OT_SPENT_MERGE_THRESHOLD <= store.recent_.size()) {
+        // The token is already durable in the log, so a failed merge does
+        // not fail the insert
+        merge(store);
+    }
+
+    return true;
+}
+}  // namespace opentxs
+#endif  // OT_CASH
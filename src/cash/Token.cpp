@@ -42,6 +42,7 @@
 
 #include "opentxs/cash/Mint.hpp"
 #include "opentxs/cash/Purse.hpp"
+#include "opentxs/cash/SpentTokens.hpp"
 #if OT_CASH_USING_LUCRE
 #include "opentxs/cash/TokenLucre.hpp"
 #endif
@@ -50,7 +51,6 @@
 #include "opentxs/core/Instrument.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
-#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
@@ -58,7 +58,6 @@
 #include "opentxs/core/crypto/OTNymOrSymmetricKey.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
-#include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/Tag.hpp"
 
 #include <irrxml/irrXML.hpp>
@@ -472,26 +471,17 @@ Token* Token::TokenFactory(String strInput)
 //
 bool Token::IsTokenAlreadySpent(String& theCleartextToken)
 {
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
-
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
+    // Calculate the token hash (a hash of the Lucre cleartext token ID)
     Identifier theTokenHash;
     theTokenHash.CalculateDigest(theCleartextToken);
 
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
-
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
+    const bool bTokenIsPresent = SpentTokens::Contains(
+        GetInstrumentDefinitionID(), GetSeries(), theTokenHash);
 
     if (bTokenIsPresent) {
         otOut << "\nToken::IsTokenAlreadySpent: Token was already spent: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
+              << GetInstrumentDefinitionID().str() << "." << GetSeries()
+              << Log::PathSeparator() << theTokenHash.str() << "\n";
         return true;  // all errors must return true in this function.
                       // But this is not an error. Token really WAS already
     }                 // spent, and this true is for real. The others are just
@@ -506,59 +496,19 @@ bool Token::IsTokenAlreadySpent(String& theCleartextToken)
 
 bool Token::RecordTokenAsSpent(String& theCleartextToken)
 {
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
-
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
+    // Calculate the token hash (a hash of the Lucre cleartext token ID)
     Identifier theTokenHash;
     theTokenHash.CalculateDigest(theCleartextToken);
 
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
-
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    // See if the spent token file ALREADY EXISTS...
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
-
-    // If so, we're trying to record a token that was already recorded...
-    if (bTokenIsPresent) {
-        otErr << "Token::RecordTokenAsSpent: Trying to record token as spent,"
-                 " but it was already recorded: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return false;
-    }
-
-    // FINISHED:
-    //
-    // We actually save the token itself into the file, which is named based
-    // on a hash of the Lucre data.
-    // The success of that operation is also now the success of this one.
-
-    String strFinal;
-    OTASCIIArmor ascTemp(m_strRawFile);
-
-    if (false ==
-        ascTemp.WriteArmoredString(strFinal, m_strContractType.Get())) {
-        otErr << "Token::RecordTokenAsSpent: Error recording token as "
-                 "spent (failed writing armored string):\n"
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return false;
-    }
+    // Checking and recording happen together, so if two deposits of the same
+    // token race each other only one of them is recorded.
+    const bool bSaved = SpentTokens::Insert(
+        GetInstrumentDefinitionID(), GetSeries(), theTokenHash);
 
-    const bool bSaved = OTDB::StorePlainString(
-        strFinal.Get(),
-        OTFolders::Spent().Get(),
-        strAssetFolder.Get(),
-        strTokenHash.Get());
     if (!bSaved) {
-        otErr << "Token::RecordTokenAsSpent: Error saving file: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
+        otErr << "Token::RecordTokenAsSpent: Error recording token as spent: "
+              << GetInstrumentDefinitionID().str() << "." << GetSeries()
+              << Log::PathSeparator() << theTokenHash.str() << "\n";
     }
 
     return bSaved;
@@ -113,7 +113,7 @@ bool Token_Lucre::GenerateTokenRequest(
         return false;
     }
 
-    LucreDumper setDumper;  // todo security.
+    InstallLucreDumper();  // todo security.
 
     OpenSSL_BIO bioBank = BIO_new(
         BIO_s_mem());  // Input. We must supply the bank's public lucre info
@@ -270,7 +270,7 @@ bool Token_Lucre::ProcessToken(
     }
 
     // Lucre
-    LucreDumper setDumper;  // todo security.
+    InstallLucreDumper();  // todo security.
 
     OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());            // input
     OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());       // input
@@ -172,7 +172,10 @@ void OTMessageOutbuffer::AddSentMessage(Message& theMessage)  // must be heap
     if (OTDB::Exists(strFolder.Get(), str_data_filename)) {
         String strNumList(
             OTDB::QueryPlainString(strFolder.Get(), str_data_filename));
-        if (strNumList.Exists()) theNumList.Add(strNumList);
+        if (strNumList.Exists()) {
+            theNumList.AddRanges(strNumList);
+        }
+
         theNumList.Add(lRequestNum);  // Add the new request number to it.
     } else  // it doesn't exist on disk, so let's just create it from the list
             // we
@@ -209,7 +212,7 @@ void OTMessageOutbuffer::AddSentMessage(Message& theMessage)  // must be heap
     // Therefore nothing left to do here, but save it back again!
     //
     String strOutput;
-    theNumList.Output(strOutput);
+    theNumList.OutputRanges(strOutput);
 
     if (!OTDB::StorePlainString(
             strOutput.Get(),
@@ -279,7 +282,9 @@ Message* OTMessageOutbuffer::GetSentMessage(
         String strNumList(
             OTDB::QueryPlainString(strFolder.Get(), str_data_filename));
 
-        if (strNumList.Exists()) theNumList.Add(strNumList);
+        if (strNumList.Exists()) {
+            theNumList.AddRanges(strNumList);
+        }
 
         if (theNumList.Verify(lRequestNum)) {
             // Even if the outgoing message was stored, we still act like it
@@ -493,14 +498,14 @@ void OTMessageOutbuffer::Clear(
                 OTDB::QueryPlainString(strFolder.Get(), str_data_filename));
 
             if (strNumList.Exists()) {
-                theNumList.Add(strNumList);
+                theNumList.AddRanges(strNumList);
             }
 
             theNumList.Remove(lRequestNum);
         }
 
         String strOutput;
-        theNumList.Output(strOutput);
+        theNumList.OutputRanges(strOutput);
         const bool saved = OTDB::StorePlainString(
             strOutput.Get(), strFolder.Get(), str_data_filename);
 
@@ -599,7 +604,10 @@ bool OTMessageOutbuffer::RemoveSentMessage(
     if (OTDB::Exists(strFolder.Get(), str_data_filename)) {
         String strNumList(
             OTDB::QueryPlainString(strFolder.Get(), str_data_filename));
-        if (strNumList.Exists()) theNumList.Add(strNumList);
+        if (strNumList.Exists()) {
+            theNumList.AddRanges(strNumList);
+        }
+
         theNumList.Remove(lRequestNum);
     } else  // it doesn't exist on disk, so let's just create it from the list
             // we
@@ -640,7 +648,7 @@ bool OTMessageOutbuffer::RemoveSentMessage(
     // Therefore nothing left to do here, but save it back again!
     //
     String strOutput;
-    theNumList.Output(strOutput);
+    theNumList.OutputRanges(strOutput);
     if (!OTDB::StorePlainString(
             strOutput.Get(), strFolder.Get(), str_data_filename)) {
         otErr << "OTMessageOutbuffer::RemoveSentMessage: Error: failed writing "
@@ -119,6 +119,7 @@
 #include <stdlib.h>
 #include <cassert>
 #include <fstream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -2054,7 +2055,14 @@ bool OT_API::NumList_VerifyAll(
 
 int32_t OT_API::NumList_Count(const NumList& theList) const
 {
-    return theList.Count();
+    const auto count = theList.Count();
+
+    if (std::numeric_limits<int32_t>::max() < count) {
+
+        return std::numeric_limits<int32_t>::max();
+    }
+
+    return static_cast<int32_t>(count);
 }
 
 /** TIME (in seconds, as std::int64_t)
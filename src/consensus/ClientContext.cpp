@@ -112,7 +112,7 @@ bool ClientContext::CloseCronItem(const TransactionNumber number)
     return (0 < output);
 }
 
-void ClientContext::FinishAcknowledgements(const std::set<RequestNumber>& req)
+void ClientContext::FinishAcknowledgements(const IntervalSet& req)
 {
     Lock lock(lock_);
 
@@ -195,9 +195,16 @@ bool ClientContext::Verify(
     const std::set<TransactionNumber>& excluded,
     const std::set<TransactionNumber>& included) const
 {
+    if (!statement.Valid()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid transaction statement."
+              << std::endl;
+
+        return false;
+    }
+
     Lock lock(lock_);
 
-    std::set<TransactionNumber> effective = issued_transaction_numbers_;
+    IntervalSet effective = issued_transaction_numbers_;
 
     for (const auto& number : included) {
         const bool inserted = effective.insert(number).second;
@@ -181,9 +181,7 @@ proto::Context Context::contract(const Lock& lock) const
 
 // This method will remove entries from acknowledged_request_numbers_ if they
 // are not on the provided set
-void Context::finish_acknowledgements(
-    const Lock& lock,
-    const std::set<RequestNumber>& req)
+void Context::finish_acknowledgements(const Lock& lock, const IntervalSet& req)
 {
     OT_ASSERT(verify_write_lock(lock));
 
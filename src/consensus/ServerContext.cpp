@@ -167,6 +167,13 @@ bool ServerContext::AcceptIssuedNumber(const TransactionNumber& number)
 
 bool ServerContext::AcceptIssuedNumbers(const TransactionStatement& statement)
 {
+    if (!statement.Valid()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid transaction statement."
+              << std::endl;
+
+        return false;
+    }
+
     Lock lock(lock_);
     std::size_t added = 0;
     const auto offered = statement.Issued().size();
@@ -435,9 +442,8 @@ ServerContext::ManagedNumber ServerContext::NextTransactionNumber(
         return ManagedNumber(0, *this);
     }
 
-    auto first = available_transaction_numbers_.begin();
-    const auto output = *first;
-    available_transaction_numbers_.erase(first);
+    const auto output = *available_transaction_numbers_.begin();
+    available_transaction_numbers_.erase(output);
 
     return ManagedNumber(output, *this);
 }
@@ -889,6 +895,13 @@ RequestNumber ServerContext::UpdateRequestNumber(bool& sendStatus)
 // the count.
 bool ServerContext::Verify(const TransactionStatement& statement) const
 {
+    if (!statement.Valid()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid transaction statement."
+              << std::endl;
+
+        return false;
+    }
+
     Lock lock(lock_);
 
     for (const auto& number : issued_transaction_numbers_) {
@@ -44,7 +44,6 @@
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Log.hpp"
-#include "opentxs/core/NumList.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 
 #include <irrxml/irrXML.hpp>
@@ -98,22 +97,18 @@ TransactionStatement::TransactionStatement(const String& serialized)
                         break;
                     }
 
-                    NumList numlist;
-
-                    if (!list.empty()) {
-                        numlist.Add(list);
+                    if (!list.empty() &&
+                        !IntervalSet::Decode(list.Get(), available_)) {
+                        otErr << __FUNCTION__
+                              << ": Error: invalid transactionNums list."
+                              << std::endl;
+                        valid_ = false;
+                        break;
                     }
 
-                    TransactionNumber number = 0;
-
-                    while (numlist.Peek(number)) {
-                        numlist.Pop();
-
-                        otLog3 << "Transaction Number " << number
-                               << " ready-to-use for NotaryID: " << notary_
-                               << std::endl;
-                        available_.insert(number);
-                    }
+                    otLog3 << available_.size()
+                           << " transaction numbers ready-to-use for NotaryID: "
+                           << notary_ << std::endl;
                 } else if (nodeName.Compare("issuedNums")) {
                     notary_ = xml->getAttributeValue("notaryID");
                     String list;
@@ -127,22 +122,18 @@ TransactionStatement::TransactionStatement(const String& serialized)
                         break;
                     }
 
-                    NumList numlist;
-
-                    if (!list.empty()) {
-                        numlist.Add(list);
+                    if (!list.empty() &&
+                        !IntervalSet::Decode(list.Get(), issued_)) {
+                        otErr << __FUNCTION__
+                              << ": Error: invalid issuedNums list."
+                              << std::endl;
+                        valid_ = false;
+                        break;
                     }
 
-                    TransactionNumber number = 0;
-
-                    while (numlist.Peek(number)) {
-                        numlist.Pop();
-
-                        otLog3 << "Currently liable for issued trans# "
-                               << number << " at NotaryID: " << notary_
-                               << std::endl;
-                        issued_.insert(number);
-                    }
+                    otLog3 << "Currently liable for " << issued_.size()
+                           << " issued transaction numbers at NotaryID: "
+                           << notary_ << std::endl;
                 } else {
                     otErr << "Unknown element type in " << __FUNCTION__ << ": "
                           << nodeName << std::endl;
@@ -167,18 +158,14 @@ TransactionStatement::operator String() const
     serialized.add_attribute("nymID", nym_id_);
 
     if (0 < issued_.size()) {
-        NumList issuedList(issued_);
-        String issued;
-        issuedList.Output(issued);
+        const String issued(issued_.Encode());
         TagPtr issuedTag(new Tag("issuedNums", OTASCIIArmor(issued).Get()));
         issuedTag->add_attribute("notaryID", notary_);
         serialized.add_tag(issuedTag);
     }
 
     if (0 < available_.size()) {
-        NumList availableList(available_);
-        String available;
-        availableList.Output(available);
+        const String available(available_.Encode());
         TagPtr availableTag(
             new Tag("transactionNums", OTASCIIArmor(available).Get()));
         availableTag->add_attribute("notaryID", notary_);
@@ -191,7 +178,7 @@ TransactionStatement::operator String() const
     return result.c_str();
 }
 
-const std::set<TransactionNumber>& TransactionStatement::Issued() const
+const IntervalSet& TransactionStatement::Issued() const
 {
     return issued_;
 }
@@ -47,6 +47,7 @@
 #include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/OTPaths.hpp"
 #include "opentxs/core/util/Tag.hpp"
+#include "opentxs/core/AccountRegistry.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Helpers.hpp"
@@ -293,7 +294,21 @@ bool Account::SaveAccount()
 {
     String id;
     GetIdentifier(id);
-    return SaveContract(OTFolders::Account().Get(), id.Get());
+
+    if (false == SaveContract(OTFolders::Account().Get(), id.Get())) {
+        return false;
+    }
+
+    // Only queues the balance, the registry writes it with the next batch.
+    // Accounts which are not registered, such as those in a client wallet,
+    // are dropped then.
+    if (false == AccountRegistry::Update(*this)) {
+        otErr << "Account::SaveAccount: Failed to update the account "
+                 "registry for account "
+              << id << "\n";
+    }
+
+    return true;
 }
 
 // Debit a certain amount from the account (presumably the same amount is being
@@ -0,0 +1,769 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/AccountRegistry.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Account.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#define OT_REGISTRY_BUCKETS 256
+#define OT_REGISTRY_UPDATE_BATCH 256
+#define OT_REGISTRY_FOLDER "registry"
+#define OT_REGISTRY_ACCOUNTS "accounts"
+#define OT_REGISTRY_ISSUER 'i'
+#define OT_REGISTRY_USER 'u'
+
+#define OT_METHOD "opentxs::AccountRegistry::"
+
+namespace opentxs
+{
+namespace
+{
+struct Summary {
+    std::size_t count_{0};
+    std::int64_t balance_{0};
+};
+
+// What the registry knows about the accounts in one data folder
+struct State {
+    // Units whose count and balance are known
+    std::map<std::string, Summary> summaries_{};
+    // Units which have no old style account list left to import
+    std::set<std::string> imported_{};
+};
+
+// A balance which has not been written to its bucket yet
+struct Pending {
+    std::string unit_{};
+    std::string value_{};
+};
+
+using Bucket = std::unique_ptr<OTDB::StringMap>;
+// Keyed by account ID
+using PendingMap = std::map<std::string, Pending>;
+
+// Held for every read and write of the buckets
+std::mutex registry_lock_{};
+// Keyed by data folder
+std::map<std::string, State> states_{};
+// Only held while queueing or taking balance updates, never during I/O
+std::mutex pending_lock_{};
+// Keyed by data folder
+std::map<std::string, PendingMap> pending_{};
+
+std::string bucket_name(const std::size_t index)
+{
+    char output[8]{};
+    std::snprintf(output, sizeof(output), "%02zx", index);
+
+    return output;
+}
+
+// FNV-1a, so an account lands in the same bucket on every platform
+std::string bucket_name(const std::string& accountID)
+{
+    std::uint32_t hash{2166136261u};
+
+    for (const auto& c : accountID) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+
+    return bucket_name(std::size_t(hash % OT_REGISTRY_BUCKETS));
+}
+
+std::string data_folder() { return OTDataFolder::Get().Get(); }
+
+bool decode(const std::string& value, bool& issuer, std::int64_t& balance)
+{
+    if ((2 > value.size()) || (':' != value[1])) {
+
+        return false;
+    }
+
+    issuer = (OT_REGISTRY_ISSUER == value[0]);
+    balance = String::StringToLong(value.substr(2));
+
+    return true;
+}
+
+std::string encode(const bool issuer, const std::int64_t balance)
+{
+    std::string output{issuer ? OT_REGISTRY_ISSUER : OT_REGISTRY_USER};
+    output += ':';
+    output += std::to_string(balance);
+
+    return output;
+}
+
+// The amount an entry contributes to the total balance of its unit
+std::int64_t circulating(const std::string& value)
+{
+    bool issuer{false};
+    std::int64_t balance{0};
+
+    if (false == decode(value, issuer, balance)) {
+
+        return 0;
+    }
+
+    return issuer ? 0 : balance;
+}
+
+bool exists(const std::string& owner, const std::string& bucket)
+{
+    return OTDB::Exists(
+        OTFolders::Contract().Get(), OT_REGISTRY_FOLDER, owner, bucket);
+}
+
+Bucket load(const std::string& owner, const std::string& bucket)
+{
+    std::unique_ptr<OTDB::Storable> storable{nullptr};
+
+    if (exists(owner, bucket)) {
+        storable.reset(OTDB::QueryObject(
+            OTDB::STORED_OBJ_STRING_MAP,
+            OTFolders::Contract().Get(),
+            OT_REGISTRY_FOLDER,
+            owner,
+            bucket));
+    } else {
+        storable.reset(OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    }
+
+    Bucket output{dynamic_cast<OTDB::StringMap*>(storable.get())};
+
+    if (output) {
+        storable.release();
+    } else {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load bucket "
+              << bucket << " of " << owner << std::endl;
+    }
+
+    return output;
+}
+
+bool store(
+    OTDB::StringMap& map,
+    const std::string& owner,
+    const std::string& bucket)
+{
+    if (map.the_map.empty()) {
+        if (false == exists(owner, bucket)) {
+
+            return true;
+        }
+
+        return OTDB::EraseValueByKey(
+            OTFolders::Contract().Get(), OT_REGISTRY_FOLDER, owner, bucket);
+    }
+
+    if (false == OTDB::StoreObject(
+                     map,
+                     OTFolders::Contract().Get(),
+                     OT_REGISTRY_FOLDER,
+                     owner,
+                     bucket)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save bucket "
+              << bucket << " of " << owner << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+State& state(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    return states_[data_folder()];
+}
+
+// Adjusts a known summary after an entry was replaced. An empty value means
+// there was no entry.
+void revise(
+    const Lock& lock,
+    const std::string& unit,
+    const std::string& before,
+    const std::string& after)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    auto& summaries = state(lock).summaries_;
+    auto it = summaries.find(unit);
+
+    if (summaries.end() == it) {
+
+        return;
+    }
+
+    auto& output = it->second;
+
+    if (before.empty() && (false == after.empty())) {
+        ++output.count_;
+    }
+
+    if (after.empty() && (false == before.empty())) {
+        --output.count_;
+    }
+
+    output.balance_ += circulating(after) - circulating(before);
+}
+
+// Writes the queued balance updates, one bucket at a time. Updates for
+// accounts which are not registered, such as those in a client wallet, are
+// dropped.
+bool flush(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    PendingMap pending{};
+
+    {
+        // Taken under the registry lock, so batches are written in the order
+        // they were queued
+        Lock pendingLock(pending_lock_);
+        pending.swap(pending_[data_folder()]);
+    }
+
+    std::map<
+        std::pair<std::string, std::string>,
+        std::vector<std::pair<std::string, std::string>>>
+        buckets{};
+
+    for (auto& it : pending) {
+        auto& update = it.second;
+        buckets[{update.unit_, bucket_name(it.first)}].emplace_back(
+            it.first, std::move(update.value_));
+    }
+
+    bool output{true};
+
+    for (const auto& it : buckets) {
+        const auto& unit = it.first.first;
+        const auto& name = it.first.second;
+
+        if (false == exists(unit, name)) {
+
+            continue;
+        }
+
+        auto bucket = load(unit, name);
+
+        if (false == bool(bucket)) {
+            output = false;
+
+            continue;
+        }
+
+        std::vector<std::pair<std::string, std::string>> changed{};
+
+        for (const auto& update : it.second) {
+            auto entry = bucket->the_map.find(update.first);
+
+            if ((bucket->the_map.end() == entry) ||
+                (entry->second == update.second)) {
+
+                continue;
+            }
+
+            changed.emplace_back(entry->second, update.second);
+            entry->second = update.second;
+        }
+
+        if (changed.empty()) {
+
+            continue;
+        }
+
+        if (false == store(*bucket, unit, name)) {
+            output = false;
+
+            continue;
+        }
+
+        for (const auto& change : changed) {
+            revise(lock, unit, change.first, change.second);
+        }
+    }
+
+    return output;
+}
+
+// Moves an old style "<unit>.a" account list into the registry. The list only
+// held account IDs, so each account is loaded once for its balance. A unit is
+// only marked as imported once the list has been fully moved, so a failed
+// import is tried again.
+bool import(const Lock& lock, const std::string& unit)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    auto& imported = state(lock).imported_;
+
+    if (0 < imported.count(unit)) {
+
+        return true;
+    }
+
+    const std::string legacy = unit + ".a";
+
+    if (false == OTDB::Exists(OTFolders::Contract().Get(), legacy)) {
+        imported.insert(unit);
+
+        return true;
+    }
+
+    std::unique_ptr<OTDB::Storable> storable(OTDB::QueryObject(
+        OTDB::STORED_OBJ_STRING_MAP, OTFolders::Contract().Get(), legacy));
+    auto* list = dynamic_cast<OTDB::StringMap*>(storable.get());
+
+    if (nullptr == list) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load " << legacy
+              << std::endl;
+
+        return false;
+    }
+
+    std::map<std::string, std::vector<std::pair<std::string, std::string>>>
+        entries{};
+
+    for (const auto& it : list->the_map) {
+        const auto& accountID = it.first;
+
+        if (unit != it.second) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Account " << accountID
+                  << " is listed under the wrong unit " << it.second
+                  << std::endl;
+
+            continue;
+        }
+
+        Account account{Identifier(), Identifier(accountID), Identifier()};
+        std::string value{encode(false, 0)};
+
+        if (account.LoadContract()) {
+            value = encode(account.IsIssuer(), account.GetBalance());
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to load account "
+                  << accountID << std::endl;
+        }
+
+        entries[bucket_name(accountID)].emplace_back(accountID, value);
+    }
+
+    for (const auto& it : entries) {
+        const auto& name = it.first;
+        auto bucket = load(unit, name);
+        auto index = load(OT_REGISTRY_ACCOUNTS, name);
+
+        if ((false == bool(bucket)) || (false == bool(index))) {
+
+            return false;
+        }
+
+        std::vector<std::pair<std::string, std::string>> changed{};
+
+        for (const auto& entry : it.second) {
+            auto& value = bucket->the_map[entry.first];
+            changed.emplace_back(value, entry.second);
+            value = entry.second;
+            index->the_map[entry.first] = unit;
+        }
+
+        if (false == store(*bucket, unit, name)) {
+
+            return false;
+        }
+
+        // An earlier attempt may have written this bucket already, so the
+        // summary is adjusted by what actually changed
+        for (const auto& change : changed) {
+            revise(lock, unit, change.first, change.second);
+        }
+
+        if (false == store(*index, OT_REGISTRY_ACCOUNTS, name)) {
+
+            return false;
+        }
+    }
+
+    if (false == OTDB::EraseValueByKey(OTFolders::Contract().Get(), legacy)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to remove " << legacy
+              << std::endl;
+
+        return false;
+    }
+
+    imported.insert(unit);
+    otWarn << OT_METHOD << __FUNCTION__ << ": Imported "
+           << list->the_map.size() << " accounts for unit " << unit
+           << std::endl;
+
+    return true;
+}
+
+Summary& summary(const Lock& lock, const std::string& unit)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    auto& summaries = state(lock).summaries_;
+    auto it = summaries.find(unit);
+
+    if (summaries.end() != it) {
+
+        return it->second;
+    }
+
+    import(lock, unit);
+    Summary output{};
+
+    for (std::size_t i = 0; i < OT_REGISTRY_BUCKETS; ++i) {
+        const auto name = bucket_name(i);
+
+        if (false == exists(unit, name)) {
+
+            continue;
+        }
+
+        auto bucket = load(unit, name);
+
+        if (false == bool(bucket)) {
+
+            continue;
+        }
+
+        for (const auto& entry : bucket->the_map) {
+            ++output.count_;
+            output.balance_ += circulating(entry.second);
+        }
+    }
+
+    return summaries.emplace(unit, output).first->second;
+}
+}  // namespace
+
+bool AccountRegistry::Add(const Account& account)
+{
+    return Add(
+        account.GetInstrumentDefinitionID(),
+        Identifier(account),
+        account.IsIssuer(),
+        account.GetBalance());
+}
+
+bool AccountRegistry::Add(
+    const Identifier& unitID,
+    const Identifier& accountID,
+    const bool issuer,
+    const std::int64_t balance)
+{
+    Lock lock(registry_lock_);
+    const std::string unit = String(unitID).Get();
+    const std::string account = String(accountID).Get();
+    const auto name = bucket_name(account);
+    flush(lock);
+    import(lock, unit);
+    auto bucket = load(unit, name);
+    auto index = load(OT_REGISTRY_ACCOUNTS, name);
+
+    if ((false == bool(bucket)) || (false == bool(index))) {
+
+        return false;
+    }
+
+    auto& value = bucket->the_map[account];
+    const std::string before = value;
+    value = encode(issuer, balance);
+
+    if (before != value) {
+        if (false == store(*bucket, unit, name)) {
+
+            return false;
+        }
+
+        revise(lock, unit, before, value);
+    }
+
+    auto& owner = index->the_map[account];
+
+    if (owner != unit) {
+        owner = unit;
+
+        return store(*index, OT_REGISTRY_ACCOUNTS, name);
+    }
+
+    return true;
+}
+
+std::size_t AccountRegistry::Count(const Identifier& unitID)
+{
+    Lock lock(registry_lock_);
+    flush(lock);
+
+    return summary(lock, String(unitID).Get()).count_;
+}
+
+bool AccountRegistry::Erase(
+    const Identifier& unitID,
+    const Identifier& accountID)
+{
+    Lock lock(registry_lock_);
+    const std::string unit = String(unitID).Get();
+    const std::string account = String(accountID).Get();
+    const auto name = bucket_name(account);
+    flush(lock);
+    import(lock, unit);
+
+    // Erasing an account which is not registered is not an error, since the
+    // end result is the same.
+    if (exists(unit, name)) {
+        auto bucket = load(unit, name);
+
+        if (false == bool(bucket)) {
+
+            return false;
+        }
+
+        auto it = bucket->the_map.find(account);
+
+        if (bucket->the_map.end() != it) {
+            const std::string before = it->second;
+            bucket->the_map.erase(it);
+
+            if (false == store(*bucket, unit, name)) {
+
+                return false;
+            }
+
+            revise(lock, unit, before, "");
+        }
+    }
+
+    if (exists(OT_REGISTRY_ACCOUNTS, name)) {
+        auto index = load(OT_REGISTRY_ACCOUNTS, name);
+
+        if (false == bool(index)) {
+
+            return false;
+        }
+
+        if (0 < index->the_map.erase(account)) {
+
+            return store(*index, OT_REGISTRY_ACCOUNTS, name);
+        }
+    }
+
+    return true;
+}
+
+bool AccountRegistry::Exists(
+    const Identifier& unitID,
+    const Identifier& accountID)
+{
+    Lock lock(registry_lock_);
+    const std::string unit = String(unitID).Get();
+    const std::string account = String(accountID).Get();
+    const auto name = bucket_name(account);
+    import(lock, unit);
+
+    if (false == exists(unit, name)) {
+
+        return false;
+    }
+
+    auto bucket = load(unit, name);
+
+    if (false == bool(bucket)) {
+
+        return false;
+    }
+
+    return (0 < bucket->the_map.count(account));
+}
+
+bool AccountRegistry::Flush()
+{
+    Lock lock(registry_lock_);
+
+    return flush(lock);
+}
+
+std::int64_t AccountRegistry::TotalBalance(const Identifier& unitID)
+{
+    Lock lock(registry_lock_);
+    flush(lock);
+
+    return summary(lock, String(unitID).Get()).balance_;
+}
+
+bool AccountRegistry::Unit(const Identifier& accountID, Identifier& unitID)
+{
+    Lock lock(registry_lock_);
+    const std::string account = String(accountID).Get();
+    const auto name = bucket_name(account);
+
+    if (false == exists(OT_REGISTRY_ACCOUNTS, name)) {
+
+        return false;
+    }
+
+    auto index = load(OT_REGISTRY_ACCOUNTS, name);
+
+    if (false == bool(index)) {
+
+        return false;
+    }
+
+    const auto it = index->the_map.find(account);
+
+    if (index->the_map.end() == it) {
+
+        return false;
+    }
+
+    unitID.SetString(it->second);
+
+    return true;
+}
+
+bool AccountRegistry::Update(const Account& account)
+{
+    return Update(
+        account.GetInstrumentDefinitionID(),
+        Identifier(account),
+        account.IsIssuer(),
+        account.GetBalance());
+}
+
+bool AccountRegistry::Update(
+    const Identifier& unitID,
+    const Identifier& accountID,
+    const bool issuer,
+    const std::int64_t balance)
+{
+    std::size_t queued{0};
+
+    {
+        Lock lock(pending_lock_);
+        auto& pending = pending_[data_folder()];
+        auto& update = pending[String(accountID).Get()];
+        update.unit_ = String(unitID).Get();
+        update.value_ = encode(issuer, balance);
+        queued = pending.size();
+    }
+
+    if (OT_REGISTRY_UPDATE_BATCH > queued) {
+
+        return true;
+    }
+
+    Lock lock(registry_lock_);
+
+    return flush(lock);
+}
+
+bool AccountRegistry::Visit(const Identifier& unitID, const Visitor& visitor)
+{
+    const std::string unit = String(unitID).Get();
+
+    {
+        Lock lock(registry_lock_);
+        flush(lock);
+        import(lock, unit);
+    }
+
+    for (std::size_t i = 0; i < OT_REGISTRY_BUCKETS; ++i) {
+        const auto name = bucket_name(i);
+        std::vector<std::pair<std::string, std::int64_t>> entries{};
+
+        // The lock is released before visiting, so the visitor may save
+        // accounts.
+        {
+            Lock lock(registry_lock_);
+
+            if (false == exists(unit, name)) {
+
+                continue;
+            }
+
+            auto bucket = load(unit, name);
+
+            if (false == bool(bucket)) {
+
+                return false;
+            }
+
+            entries.reserve(bucket->the_map.size());
+
+            for (const auto& it : bucket->the_map) {
+                bool issuer{false};
+                std::int64_t balance{0};
+                decode(it.second, issuer, balance);
+                entries.emplace_back(it.first, balance);
+            }
+        }
+
+        for (const auto& entry : entries) {
+            if (false == visitor(entry.first, entry.second)) {
+
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+}  // namespace opentxs
@@ -40,6 +40,8 @@
 
 #include "opentxs/core/Contract.hpp"
 
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/Native.hpp"
 #include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/CryptoHash.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
@@ -51,21 +53,26 @@
 #include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 
 #include <stdint.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <irrxml/irrXML.hpp>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace irr;
 using namespace io;
@@ -610,6 +617,90 @@ bool Contract::VerifySignature(const Nym& theNym, const OTPasswordData* pPWData)
     return false;
 }
 
+// Tries the same keys as VerifySignature(theNym), but collects every
+// (contract, signature, key) combination first and checks them all in one
+// batch.
+std::vector<bool> Contract::VerifySignatures(
+    const std::vector<const Contract*>& contracts,
+    const Nym& theNym)
+{
+    std::vector<bool> output(contracts.size(), false);
+    std::vector<SignatureCheck> batch{};
+    std::vector<std::size_t> owner{};
+    std::list<OTData> plaintexts{};
+    std::list<OTData> signatures{};
+    String strNymID;
+    theNym.GetIdentifier(strNymID);
+    char cNymID = '0';
+    uint32_t uIndex = 3;
+    const bool bNymID = strNymID.At(uIndex, cNymID);
+    const auto& defaultKey = theNym.GetPublicSignKey();
+
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        const auto* contract = contracts[i];
+
+        OT_ASSERT(nullptr != contract);
+
+        const auto unsigned_xml = trim(contract->m_xmlUnsigned);
+        plaintexts.emplace_back(Data::Factory(
+            unsigned_xml.Get(), unsigned_xml.GetLength() + 1));
+        const Data& plaintext = plaintexts.back();
+
+        for (const auto* pSig : contract->m_listSignatures) {
+            OT_ASSERT(nullptr != pSig);
+
+            const auto& metadata = pSig->getMetaData();
+
+            if (bNymID && metadata.HasMetadata() &&
+                (metadata.FirstCharNymID() != cNymID)) {
+
+                continue;
+            }
+
+            listOfAsymmetricKeys found;
+            theNym.GetPublicKeysBySignature(found, *pSig, 'S');
+            std::vector<const OTAsymmetricKey*> keys(
+                found.begin(), found.end());
+
+            // VerifySignature(theNym) always falls back to the default key
+            if (found.end() ==
+                std::find(found.begin(), found.end(), &defaultKey)) {
+                keys.push_back(&defaultKey);
+            }
+
+            signatures.emplace_back(Data::Factory());
+            Data& signature = signatures.back();
+            pSig->GetData(signature);
+
+            for (const auto* pKey : keys) {
+                OT_ASSERT(nullptr != pKey);
+
+                if ((nullptr != pKey->m_pMetadata) &&
+                    pKey->m_pMetadata->HasMetadata() &&
+                    metadata.HasMetadata() &&
+                    (metadata != *pKey->m_pMetadata)) {
+
+                    continue;
+                }
+
+                batch.push_back(
+                    {&plaintext, pKey, &signature, contract->m_strSigHashType});
+                owner.push_back(i);
+            }
+        }
+    }
+
+    const auto results = OT::App().Crypto().VerifyBatch(batch);
+
+    for (std::size_t n = 0; n < results.size(); ++n) {
+        if (results[n]) {
+            output[owner[n]] = true;
+        }
+    }
+
+    return output;
+}
+
 bool Contract::VerifyWithKey(
     const OTAsymmetricKey& theKey,
     const OTPasswordData* pPWData) const
@@ -54,6 +54,9 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/OT.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace opentxs
 {
 
@@ -167,38 +170,32 @@ Identifier& Identifier::operator=(Identifier&& rhs)
 
 bool Identifier::operator==(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.Compare(ots2);
+    return 0 == compare(s2);
 }
 
 bool Identifier::operator!=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return !(ots1.Compare(ots2));
+    return 0 != compare(s2);
 }
 
 bool Identifier::operator>(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator>(ots2);
+    return 0 < compare(s2);
 }
 
 bool Identifier::operator<(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator<(ots2);
+    return 0 > compare(s2);
 }
 
 bool Identifier::operator<=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator<=(ots2);
+    return 0 >= compare(s2);
 }
 
 bool Identifier::operator>=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator>=(ots2);
+    return 0 <= compare(s2);
 }
 
 bool Identifier::CalculateDigest(const String& strInput, const ID type)
@@ -274,6 +271,41 @@ void Identifier::SetString(const std::string& encoded)
     }
 }
 
+int Identifier::compare(const Identifier& rhs) const
+{
+    const auto lhsSize = GetSize();
+    const auto rhsSize = rhs.GetSize();
+
+    if ((0 == lhsSize) || (0 == rhsSize)) {
+        if (lhsSize == rhsSize) {
+
+            return 0;
+        }
+
+        return (0 == lhsSize) ? -1 : 1;
+    }
+
+    if (type_ != rhs.type_) {
+
+        return (type_ < rhs.type_) ? -1 : 1;
+    }
+
+    const auto result =
+        std::memcmp(GetPointer(), rhs.GetPointer(), std::min(lhsSize, rhsSize));
+
+    if (0 != result) {
+
+        return result;
+    }
+
+    if (lhsSize == rhsSize) {
+
+        return 0;
+    }
+
+    return (lhsSize < rhsSize) ? -1 : 1;
+}
+
 // This Identifier is stored in binary form.
 // But what if you want a pretty string version of it?
 // Just call this function.
@@ -335,3 +367,25 @@ void Identifier::swap(Identifier&& rhs)
     rhs.type_ = ID::ERROR;
 }
 }  // namespace opentxs
+
+namespace std
+{
+std::size_t hash<opentxs::Identifier>::operator()(
+    const opentxs::Identifier& id) const
+{
+    const auto size = id.GetSize();
+
+    // Consistent with operator==, which ignores the type of empty identifiers
+    if (0 == size) {
+
+        return 0;
+    }
+
+    // The digest is already uniformly distributed, so its leading bytes are a
+    // sufficient hash
+    std::size_t output{0};
+    std::memcpy(&output, id.GetPointer(), std::min(sizeof(output), size));
+
+    return output ^ static_cast<std::size_t>(id.Type());
+}
+}  // namespace std
@@ -0,0 +1,430 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/IntervalSet.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <sstream>
+
+#define OT_METHOD "opentxs::IntervalSet::"
+
+namespace opentxs
+{
+IntervalSet::const_iterator::const_iterator(
+    const Map* ranges,
+    const Map::const_iterator range,
+    const value_type value)
+    : ranges_(ranges)
+    , range_(range)
+    , value_(value)
+{
+}
+
+IntervalSet::const_iterator& IntervalSet::const_iterator::operator++()
+{
+    if (value_ < range_->second) {
+        ++value_;
+    } else {
+        ++range_;
+
+        if (ranges_->end() != range_) {
+            value_ = range_->first;
+        }
+    }
+
+    return *this;
+}
+
+IntervalSet::const_iterator IntervalSet::const_iterator::operator++(int)
+{
+    auto output = *this;
+    ++(*this);
+
+    return output;
+}
+
+bool IntervalSet::const_iterator::operator==(const const_iterator& rhs) const
+{
+    if (ranges_ != rhs.ranges_) {
+
+        return false;
+    }
+
+    if (range_ != rhs.range_) {
+
+        return false;
+    }
+
+    if (nullptr == ranges_) {
+
+        return true;
+    }
+
+    return (ranges_->end() == range_) || (value_ == rhs.value_);
+}
+
+bool IntervalSet::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return !(*this == rhs);
+}
+
+IntervalSet::IntervalSet(const std::set<value_type>& values)
+    : ranges_()
+    , size_(0)
+{
+    auto hint = ranges_.end();
+
+    // The input is sorted, so each value either extends the last range or
+    // starts a new one.
+    for (const auto& value : values) {
+        if ((ranges_.end() != hint) && (hint->second + 1 == value)) {
+            hint->second = value;
+        } else {
+            hint = ranges_.emplace_hint(ranges_.end(), value, value);
+        }
+    }
+
+    size_ = values.size();
+}
+
+IntervalSet::const_iterator IntervalSet::begin() const
+{
+    if (ranges_.empty()) {
+
+        return end();
+    }
+
+    const auto first = ranges_.begin();
+
+    return const_iterator(&ranges_, first, first->first);
+}
+
+void IntervalSet::clear()
+{
+    ranges_.clear();
+    size_ = 0;
+}
+
+IntervalSet::Map::iterator IntervalSet::containing(const value_type value)
+{
+    auto it = ranges_.upper_bound(value);
+
+    if (ranges_.begin() == it) {
+
+        return ranges_.end();
+    }
+
+    --it;
+
+    return (it->second >= value) ? it : ranges_.end();
+}
+
+IntervalSet::Map::const_iterator IntervalSet::containing(
+    const value_type value) const
+{
+    auto it = ranges_.upper_bound(value);
+
+    if (ranges_.begin() == it) {
+
+        return ranges_.end();
+    }
+
+    --it;
+
+    return (it->second >= value) ? it : ranges_.end();
+}
+
+std::size_t IntervalSet::count(const value_type value) const
+{
+    return (ranges_.end() == containing(value)) ? 0 : 1;
+}
+
+bool IntervalSet::Decode(
+    const std::string& encoded,
+    IntervalSet& output,
+    const bool allowRanges)
+{
+    bool success{true};
+    bool inRange{false};
+    bool haveNumber{false};
+    value_type first{0};
+    value_type number{0};
+
+    const auto finish = [&]() -> void {
+        if (false == haveNumber) {
+            if (inRange) {
+                otErr << OT_METHOD << "Decode: Range without an upper bound."
+                      << std::endl;
+                success = false;
+            }
+        } else if (inRange) {
+            if (number < first) {
+                otErr << OT_METHOD << "Decode: Invalid range " << first << "-"
+                      << number << std::endl;
+                success = false;
+            } else {
+                output.InsertRange(first, number);
+            }
+        } else {
+            output.insert(number);
+        }
+
+        inRange = false;
+        haveNumber = false;
+        number = 0;
+    };
+
+    for (const auto& c : encoded) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            haveNumber = true;
+            number *= 10;
+            number += (c - '0');
+        } else if ('-' == c) {
+            if (false == allowRanges) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Ranges are not allowed in this list." << std::endl;
+
+                return false;
+            }
+
+            if ((false == haveNumber) || inRange) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Misplaced range separator." << std::endl;
+
+                return false;
+            }
+
+            first = number;
+            number = 0;
+            haveNumber = false;
+            inRange = true;
+        } else if ((',' == c) || std::isspace(static_cast<unsigned char>(c))) {
+            if (haveNumber || inRange) {
+                finish();
+            }
+        } else {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Unexpected character found in list of numbers: " << c
+                  << std::endl;
+
+            return false;
+        }
+    }
+
+    finish();
+
+    return success;
+}
+
+std::string IntervalSet::Encode() const
+{
+    std::stringstream output{};
+    bool first{true};
+
+    for (const auto& range : ranges_) {
+        if (false == first) {
+            output << ',';
+        }
+
+        first = false;
+        output << range.first;
+
+        if (range.second != range.first) {
+            output << '-' << range.second;
+        }
+    }
+
+    return output.str();
+}
+
+IntervalSet::const_iterator IntervalSet::end() const
+{
+    return const_iterator(&ranges_, ranges_.end(), 0);
+}
+
+std::size_t IntervalSet::erase(const value_type value)
+{
+    auto it = containing(value);
+
+    if (ranges_.end() == it) {
+
+        return 0;
+    }
+
+    const auto first = it->first;
+    const auto last = it->second;
+
+    if (first == last) {
+        ranges_.erase(it);
+    } else if (first == value) {
+        ranges_.erase(it);
+        ranges_.emplace(value + 1, last);
+    } else if (last == value) {
+        it->second = value - 1;
+    } else {
+        it->second = value - 1;
+        ranges_.emplace(value + 1, last);
+    }
+
+    --size_;
+
+    return 1;
+}
+
+IntervalSet::const_iterator IntervalSet::find(const value_type value) const
+{
+    const auto it = containing(value);
+
+    if (ranges_.end() == it) {
+
+        return end();
+    }
+
+    return const_iterator(&ranges_, it, value);
+}
+
+std::pair<IntervalSet::const_iterator, bool> IntervalSet::insert(
+    const value_type value)
+{
+    if (ranges_.end() != containing(value)) {
+
+        return {find(value), false};
+    }
+
+    auto next = ranges_.upper_bound(value);
+    auto previous = (ranges_.begin() == next) ? ranges_.end() : std::prev(next);
+    const bool joinPrevious =
+        (ranges_.end() != previous) && (previous->second + 1 == value);
+    const bool joinNext = (ranges_.end() != next) && (next->first - 1 == value);
+    auto range = ranges_.end();
+
+    if (joinPrevious && joinNext) {
+        previous->second = next->second;
+        ranges_.erase(next);
+        range = previous;
+    } else if (joinPrevious) {
+        previous->second = value;
+        range = previous;
+    } else if (joinNext) {
+        const auto last = next->second;
+        ranges_.erase(next);
+        range = ranges_.emplace(value, last).first;
+    } else {
+        range = ranges_.emplace(value, value).first;
+    }
+
+    ++size_;
+
+    return {const_iterator(&ranges_, range, value), true};
+}
+
+std::size_t IntervalSet::InsertRange(
+    const value_type first,
+    const value_type last)
+{
+    if (last < first) {
+
+        return 0;
+    }
+
+    const auto before = size_;
+    auto mergedFirst = first;
+    auto mergedLast = last;
+    auto it = ranges_.upper_bound(first);
+
+    // Start with the range to the left if it overlaps or touches [first, last]
+    if (ranges_.begin() != it) {
+        auto previous = std::prev(it);
+
+        if ((previous->second >= first) ||
+            ((std::numeric_limits<value_type>::min() != first) &&
+             (previous->second == first - 1))) {
+            it = previous;
+        }
+    }
+
+    const auto touches = [&](const value_type start) -> bool {
+        if (start <= last) {
+
+            return true;
+        }
+
+        return (std::numeric_limits<value_type>::max() != last) &&
+               (start == last + 1);
+    };
+
+    while ((ranges_.end() != it) && touches(it->first)) {
+        mergedFirst = std::min(mergedFirst, it->first);
+        mergedLast = std::max(mergedLast, it->second);
+        size_ -= static_cast<std::size_t>(it->second - it->first) + 1;
+        it = ranges_.erase(it);
+    }
+
+    ranges_.emplace(mergedFirst, mergedLast);
+    size_ += static_cast<std::size_t>(mergedLast - mergedFirst) + 1;
+
+    return size_ - before;
+}
+
+std::set<IntervalSet::value_type> IntervalSet::Set() const
+{
+    std::set<value_type> output{};
+
+    for (const auto& value : *this) {
+        output.emplace_hint(output.end(), value);
+    }
+
+    return output;
+}
+
+bool IntervalSet::operator==(const IntervalSet& rhs) const
+{
+    return ranges_ == rhs.ranges_;
+}
+
+bool IntervalSet::operator!=(const IntervalSet& rhs) const
+{
+    return ranges_ != rhs.ranges_;
+}
+}  // namespace opentxs
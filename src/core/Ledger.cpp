@@ -1791,8 +1791,12 @@ void Ledger::UpdateContents()  // Before transmission or serialization, this is
 
             pTransaction->SaveContractRaw(strTransaction);
             OTASCIIArmor ascTransaction;
+            // The message containing this ledger is compressed again, so
+            // the best compression is not worth its cost here
             ascTransaction.SetString(
-                strTransaction, true);  // linebreaks = true
+                strTransaction,
+                true,  // linebreaks = true
+                ArmorCompression::Fast);
 
             tag.add_tag("transaction", ascTransaction.Get());
         } else  // true == bSavingAbbreviated
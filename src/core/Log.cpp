@@ -45,6 +45,7 @@
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTPaths.hpp"
 #include "opentxs/core/util/stacktrace.h"
+#include "opentxs/core/Flag.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/Types.hpp"
 
@@ -58,19 +59,26 @@
 #include <stdint.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <typeinfo>
 
 #define LOG_DEQUE_SIZE 1024
+// Must be a power of two
+#define LOG_RING_SIZE 4096
+#define LOG_WRITER_IDLE_MILLISECONDS 10
 
 extern "C" {
 
@@ -120,6 +128,7 @@ struct sigcontext {
 #define GLOBAL_LOGFILE "init.log"
 #define CONFIG_LOG_SECTION "logging"
 #define CONFIG_LOG_TO_FILE_KEY "log_to_file"
+#define CONFIG_LOG_JSON_KEY "log_json"
 
 //  OTLog Static Variables and Constants.
 
@@ -139,47 +148,339 @@ OTLOG_IMPORT OTLogStream otLog3(3);  // logs using OTLog::vOutput(3)
 OTLOG_IMPORT OTLogStream otLog4(4);  // logs using OTLog::vOutput(4)
 OTLOG_IMPORT OTLogStream otLog5(5);  // logs using OTLog::vOutput(5)
 
+namespace
+{
+/** Partial lines, per thread and per stream */
+thread_local std::map<const OTLogStream*, std::string> line_buffers_{};
+}  // namespace
+
+/** Moves complete lines from producers to the console and the log file. The
+ * ring is a bounded multi-producer, multi-consumer queue in which each slot
+ * carries a sequence number, so producers only contend on a single atomic
+ * increment. If the ring is full, the producer drains it and writes the line
+ * itself rather than dropping it. */
+class Log::Writer
+{
+public:
+    void Flush();
+    void Push(std::string&& line);
+
+    Writer(const String& path, const bool writeFile);
+    ~Writer();
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence_{0};
+        std::string line_{};
+    };
+
+    std::unique_ptr<Slot[]> ring_;
+    const std::size_t mask_{LOG_RING_SIZE - 1};
+    std::atomic<std::size_t> head_{0};
+    std::atomic<std::size_t> tail_{0};
+    std::mutex output_lock_;
+    std::mutex signal_lock_;
+    std::condition_variable signal_;
+    std::ofstream file_;
+    OTFlag running_;
+    std::thread thread_;
+
+    bool drain(const Lock& lock);
+    bool pop(std::string& line);
+    bool push(std::string&& line);
+    void run();
+    void write(const Lock& lock, const std::string& line);
+
+    Writer() = delete;
+    Writer(const Writer&) = delete;
+    Writer(Writer&&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    Writer& operator=(Writer&&) = delete;
+};
+
+Log::Writer::Writer(const String& path, const bool writeFile)
+    : ring_(new Slot[LOG_RING_SIZE])
+    , output_lock_()
+    , signal_lock_()
+    , signal_()
+    , file_()
+    , running_(Flag::Factory(true))
+    , thread_()
+{
+    OT_ASSERT(ring_);
+
+    for (std::size_t i = 0; i < LOG_RING_SIZE; ++i) {
+        ring_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+
+    if (writeFile && path.Exists()) {
+        file_.open(path.Get(), std::ios::app);
+
+        if (file_.fail()) {
+            std::cerr << "Log::Writer: failed to open " << path.Get() << "\n";
+        }
+    }
+
+    thread_ = std::thread(&Log::Writer::run, this);
+}
+
+bool Log::Writer::drain(const Lock& lock)
+{
+    bool output{false};
+    std::string line{};
+
+    while (pop(line)) {
+        write(lock, line);
+        output = true;
+    }
+
+    if (output) {
+        std::cerr.flush();
+
+        if (file_.is_open()) {
+            file_.flush();
+        }
+    }
+
+    return output;
+}
+
+// Best effort: if another thread is already writing then it will drain the
+// ring itself. This avoids deadlock when an assert fires during output.
+void Log::Writer::Flush()
+{
+    Lock lock(output_lock_, std::try_to_lock);
+
+    if (lock.owns_lock()) {
+        drain(lock);
+    }
+}
+
+bool Log::Writer::pop(std::string& line)
+{
+    Slot* slot{nullptr};
+    auto position = head_.load(std::memory_order_relaxed);
+
+    while (true) {
+        slot = &ring_[position & mask_];
+        const auto sequence = slot->sequence_.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) -
+                                static_cast<std::intptr_t>(position + 1);
+
+        if (0 == difference) {
+            if (head_.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (0 > difference) {
+
+            return false;
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    line.swap(slot->line_);
+    slot->line_.clear();
+    slot->sequence_.store(position + mask_ + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool Log::Writer::push(std::string&& line)
+{
+    Slot* slot{nullptr};
+    auto position = tail_.load(std::memory_order_relaxed);
+
+    while (true) {
+        slot = &ring_[position & mask_];
+        const auto sequence = slot->sequence_.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) -
+                                static_cast<std::intptr_t>(position);
+
+        if (0 == difference) {
+            if (tail_.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (0 > difference) {
+
+            return false;
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->line_ = std::move(line);
+    slot->sequence_.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+void Log::Writer::Push(std::string&& line)
+{
+    if (push(std::move(line))) {
+        signal_.notify_one();
+
+        return;
+    }
+
+    // The ring is full: apply backpressure by writing from this thread
+    Lock lock(output_lock_);
+    drain(lock);
+    write(lock, line);
+    std::cerr.flush();
+
+    if (file_.is_open()) {
+        file_.flush();
+    }
+}
+
+void Log::Writer::run()
+{
+    while (running_.get()) {
+        bool output{false};
+
+        {
+            Lock lock(output_lock_);
+            output = drain(lock);
+        }
+
+        if (false == output) {
+            Lock lock(signal_lock_);
+            signal_.wait_for(
+                lock, std::chrono::milliseconds(LOG_WRITER_IDLE_MILLISECONDS));
+        }
+    }
+}
+
+void Log::Writer::write(const Lock& lock, const std::string& line)
+{
+    std::cerr << line;
+
+    if (file_.is_open()) {
+        file_ << line;
+    }
+}
+
+Log::Writer::~Writer()
+{
+    running_->Off();
+    signal_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    Flush();
+
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
 OTLogStream::OTLogStream(int _logLevel)
     : std::ostream(this)
     , logLevel(_logLevel)
-    , next(0)
-    , pBuffer(new char[1024])
 {
 }
 
-OTLogStream::~OTLogStream()
+void OTLogStream::emit(std::string& line) const
+{
+    if (line.empty()) {
+
+        return;
+    }
+
+    if (logLevel < 0) {
+        Log::Error(line.c_str());
+    } else {
+        Log::Output(logLevel, line.c_str());
+    }
+
+    line.clear();
+}
+
+bool OTLogStream::enabled(const std::int32_t level) const
 {
-    delete[] pBuffer;
-    pBuffer = nullptr;
+    if (0 > logLevel) {
+
+        return true;
+    }
+
+    return (-1 != level) && (logLevel <= level);
 }
 
 int OTLogStream::overflow(int c)
 {
-    rLock lock(lock_);
+    using traits = std::streambuf::traits_type;
+
+    if (traits::eq_int_type(c, traits::eof())) {
 
-    pBuffer[next++] = c;
-    if (c != '\n' && next < 1000) {
         return 0;
     }
 
-    pBuffer[next++] = '\0';
-    next = 0;
+    if (false == enabled(Log::LogLevel())) {
 
-    if (logLevel < 0) {
-        Log::Error(pBuffer);
-        return 0;
+        return c;
+    }
+
+    auto& line = line_buffers_[this];
+    line.push_back(traits::to_char_type(c));
+
+    if ('\n' == c) {
+        emit(line);
+    }
+
+    return c;
+}
+
+// Called by Log whenever the log level changes. The level is normally set once
+// during startup, before any other threads are logging.
+void OTLogStream::update(const std::int32_t level)
+{
+    if (enabled(level)) {
+        clear();
+    } else {
+        setstate(std::ios_base::badbit);
+    }
+}
+
+std::streamsize OTLogStream::xsputn(const char* s, std::streamsize count)
+{
+    if (false == enabled(Log::LogLevel())) {
+
+        return count;
     }
 
-    Log::Output(logLevel, pBuffer);
-    return 0;
+    auto& line = line_buffers_[this];
+    const char* end = s + count;
+
+    while (s != end) {
+        const char* newline = std::find(s, end, '\n');
+
+        if (end == newline) {
+            line.append(s, end);
+            break;
+        }
+
+        line.append(s, newline + 1);
+        emit(line);
+        s = newline + 1;
+    }
+
+    return count;
 }
 
 Log::Log(const api::Settings& config)
     : config_(config)
+    , writer_(nullptr)
 {
     bool notUsed{false};
     config_.Check_bool(
         CONFIG_LOG_SECTION, CONFIG_LOG_TO_FILE_KEY, write_log_file_, notUsed);
+    config_.Check_bool(
+        CONFIG_LOG_SECTION, CONFIG_LOG_JSON_KEY, write_json_, notUsed);
 }
 
 //  OTLog Init, must run this before using any OTLog function.
@@ -246,7 +547,13 @@ bool Log::Init(
                 return false;
             }
 
+        pLogger->writer_.reset(new Writer(
+            pLogger->m_strLogFilePath, pLogger->write_log_file_));
+
+        OT_ASSERT(pLogger->writer_);
+
         pLogger->m_bInitialized = true;
+        update_streams(pLogger->m_nLogLevel);
 
         // Set the new log-assert function pointer.
         Assert* pLogAssert = new Assert(Log::logAssert);
@@ -260,6 +567,8 @@ bool Log::Init(
     }
 }
 
+Log::~Log() { writer_.reset(); }
+
 // static
 bool Log::IsInitialized()
 {
@@ -323,10 +632,21 @@ bool Log::SetLogLevel(const int32_t& nLogLevel)
         OT_FAIL;
     } else {
         pLogger->m_nLogLevel = nLogLevel;
+        update_streams(nLogLevel);
+
         return true;
     }
 }
 
+// static
+void Log::update_streams(const std::int32_t nLogLevel)
+{
+    for (auto stream :
+         {&otErr, &otOut, &otWarn, &otInfo, &otLog3, &otLog4, &otLog5}) {
+        stream->update(nLogLevel);
+    }
+}
+
 //  OTLog Functions
 
 // If there's no logfile, then send it to stderr.
@@ -337,47 +657,27 @@ bool Log::SetLogLevel(const int32_t& nLogLevel)
 // static
 bool Log::LogToFile(const String& strOutput)
 {
-    // We now do this either way.
-    {
-        std::cerr << strOutput;
-        std::cerr.flush();
-    }
-
-    // now log to file, if we can.
-
     bool bHaveLogger(false);
     if (nullptr != pLogger)
         if (pLogger->IsInitialized()) bHaveLogger = true;
 
-    // lets check if we are Initialized in this context
-    if (bHaveLogger) CheckLogger(Log::pLogger);
+    if ((false == bHaveLogger) || (false == bool(pLogger->writer_))) {
+        std::cerr << strOutput;
+        std::cerr.flush();
 
-    if (nullptr != pLogger) {
-        rLock lock(Log::pLogger->lock_);
+        return false;
     }
 
-    bool bSuccess = false;
+    if (false == strOutput.Exists()) {
 
-    if (bHaveLogger) {
-        if (false == pLogger->write_log_file_) {
-
-            return true;
-        }
-
-        // Append to logfile
-        if ((strOutput.Exists()) && (Log::pLogger->m_strLogFilePath.Exists())) {
-            std::ofstream logfile;
-            logfile.open(Log::LogFilePath(), std::ios::app);
-
-            if (!logfile.fail()) {
-                logfile << strOutput;
-                logfile.close();
-                bSuccess = true;
-            }
-        }
+        return false;
     }
 
-    return bSuccess;
+    // The background writer sends the line to stderr and, if enabled, to the
+    // persistent log file handle.
+    pLogger->writer_->Push(std::string(strOutput.Get()));
+
+    return pLogger->write_log_file_;
 }
 
 String Log::GetMemlogAtIndex(int32_t nIndex)
@@ -592,6 +892,10 @@ size_t Log::logAssert(
 #endif
     }
 
+    if ((nullptr != pLogger) && pLogger->writer_) {
+        pLogger->writer_->Flush();
+    }
+
     print_stacktrace();
 
     return 1;  // normal
@@ -693,6 +997,92 @@ void Log::vOutput(int32_t nVerbosity, const char* szOutput, ...)
     return;
 }
 
+// static
+std::string Log::format_record(
+    const std::int32_t nVerbosity,
+    const std::string& event,
+    const std::map<std::string, std::string>& fields)
+{
+    const bool json = (nullptr != pLogger) && pLogger->write_json_;
+    std::stringstream output{};
+
+    if (json) {
+        static const char hex[] = "0123456789abcdef";
+        const auto quote = [&output](const std::string& in) -> void {
+            output << '"';
+
+            for (const auto& c : in) {
+                switch (c) {
+                    case '"':
+                    case '\\': {
+                        output << '\\' << c;
+                    } break;
+                    case '\n': {
+                        output << "\\n";
+                    } break;
+                    default: {
+                        const auto byte = static_cast<unsigned char>(c);
+
+                        // JSON forbids raw control characters in strings
+                        if (0x20 > byte) {
+                            output << "\\u00" << hex[byte >> 4]
+                                   << hex[byte & 0x0f];
+                        } else {
+                            output << c;
+                        }
+                    }
+                }
+            }
+
+            output << '"';
+        };
+
+        output << "{\"level\":" << nVerbosity << ",\"event\":";
+        quote(event);
+
+        for (const auto& it : fields) {
+            output << ',';
+            quote(it.first);
+            output << ':';
+            quote(it.second);
+        }
+
+        output << "}\n";
+    } else {
+        output << event;
+
+        for (const auto& it : fields) {
+            output << ' ' << it.first << '=' << it.second;
+        }
+
+        output << '\n';
+    }
+
+    return output.str();
+}
+
+// static
+void Log::Record(
+    const std::int32_t nVerbosity,
+    const std::string& event,
+    const std::map<std::string, std::string>& fields)
+{
+    const auto level = LogLevel();
+
+    if (0 > nVerbosity) {
+        Log::Error(format_record(nVerbosity, event, fields).c_str());
+
+        return;
+    }
+
+    if ((nVerbosity > level) || (-1 == level)) {
+
+        return;
+    }
+
+    Log::Output(nVerbosity, format_record(nVerbosity, event, fields).c_str());
+}
+
 // the vError name is to avoid name conflicts
 void Log::vError(const char* szError, ...)
 {
@@ -57,10 +57,18 @@
 namespace opentxs
 {
 
-NumList::NumList(const std::set<int64_t>& theNumbers) { Add(theNumbers); }
+NumList::NumList(const std::set<int64_t>& theNumbers)
+    : m_setData(theNumbers)
+{
+}
 
 NumList::NumList(std::set<int64_t>&& theNumbers)
-    : m_setData(std::move(theNumbers))
+    : m_setData(theNumbers)
+{
+}
+
+NumList::NumList(const IntervalSet& theNumbers)
+    : m_setData(theNumbers)
 {
 }
 
@@ -84,7 +92,7 @@ bool NumList::Add(const String& strNumbers)  // if false, means the numbers
                                              // were already there. (At least
                                              // one of them.)
 {
-    return Add(strNumbers.Get());
+    return Add(strNumbers.Get(), false);
 }
 
 bool NumList::Add(const std::string& strNumbers)  // if false, means the
@@ -92,81 +100,42 @@ bool NumList::Add(const std::string& strNumbers)  // if false, means the
                                                   // there. (At least one of
                                                   // them.)
 {
-    return Add(strNumbers.c_str());
+    return Add(strNumbers.c_str(), false);
+}
+
+bool NumList::AddRanges(const String& strNumbers)
+{
+    return Add(strNumbers.Get(), true);
 }
 
 // This function is private, so you can't use it without passing an OTString.
-// (For security reasons.) It takes a comma-separated list of numbers, and adds
-// them to *this.
+// (For security reasons.) It takes a comma-separated list of numbers, and
+// ranges if allowRanges is set, and adds them to *this.
 //
-bool NumList::Add(const char* szNumbers)  // if false, means the numbers were
-                                          // already there. (At least one of
-                                          // them.)
+bool NumList::Add(const char* szNumbers, const bool allowRanges)
 {
     OT_ASSERT(nullptr != szNumbers);  // Should never happen.
 
-    bool bSuccess = true;
-    int64_t lNum = 0;
-    const char* pChar = szNumbers;
-    std::locale loc;
-
-    // Skip any whitespace.
-    while (std::isspace(*pChar, loc)) pChar++;
-
-    bool bStartedANumber =
-        false;  // During the loop, set this to true when processing a digit,
-                // and set to false when anything else. That way when we go to
-                // add the number to the list, and it's "0", we'll know it's a
-                // real number we're supposed to add, and not just a default
-                // value.
-
-    for (;;)  // We already know it's not null, due to the assert. (So at least
-              // one iteration will happen.)
-    {
-        if (std::isdigit(*pChar, loc)) {
-            bStartedANumber = true;
+    IntervalSet input;
 
-            int32_t nDigit = (*pChar - '0');
+    if (!IntervalSet::Decode(szNumbers, input, allowRanges)) {
+        otErr << "OTNumList::Add: Error: Failed to parse erstwhile "
+                 "comma-separated list of longs.\n";
 
-            lNum *= 10;  // Move it up a decimal place.
-            lNum += nDigit;
-        }
-        // if separator, or end of string, either way, add lNum to *this.
-        else if (
-            (',' == *pChar) || ('\0' == *pChar) ||
-            std::isspace(*pChar, loc))  // first sign of a space, and we are
-                                        // done with current number. (On to
-                                        // the next.)
-        {
-            if ((lNum > 0) || (bStartedANumber && (0 == lNum))) {
-                if (!Add(lNum))  // <=========
-                {
-                    bSuccess = false;  // We still go ahead and try to add them
-                                       // all, and then return this sort of
-                                       // status when it's all done.
-                }
-            }
-
-            lNum = 0;  // reset for the next transaction number (in the
-                       // comma-separated list.)
-            bStartedANumber = false;  // reset
-        } else {
-            otErr << "OTNumList::Add: Error: Unexpected character found in "
-                     "erstwhile comma-separated list of longs: "
-                  << *pChar << "\n";
-            bSuccess = false;
-            break;
-        }
-
-        // End of the road.
-        if ('\0' == *pChar) break;
+        return false;
+    }
 
-        pChar++;
+    bool bSuccess = true;
 
-        // Skip any whitespace.
-        while (std::isspace(*pChar, loc)) pChar++;
+    for (const auto& it : input.Ranges()) {
+        const auto count = static_cast<std::size_t>(it.second - it.first) + 1;
 
-    }  // while
+        // We still go ahead and try to add them all, and then return this
+        // sort of status when it's all done.
+        if (count != m_setData.InsertRange(it.first, it.second)) {
+            bSuccess = false;
+        }
+    }
 
     return bSuccess;
 }
@@ -174,14 +143,7 @@ bool NumList::Add(const char* szNumbers)  // if false, means the numbers were
 bool NumList::Add(const int64_t& theValue)  // if false, means the value was
                                             // already there.
 {
-    auto it = m_setData.find(theValue);
-
-    if (m_setData.end() == it)  // it's not already there, so add it.
-    {
-        m_setData.insert(theValue);
-        return true;
-    }
-    return false;  // it was already there.
+    return m_setData.insert(theValue).second;
 }
 
 bool NumList::Peek(int64_t& lPeek) const
@@ -202,7 +164,7 @@ bool NumList::Pop()
 
     if (m_setData.end() != it)  // it's there.
     {
-        m_setData.erase(it);
+        m_setData.erase(*it);
         return true;
     }
     return false;
@@ -211,23 +173,15 @@ bool NumList::Pop()
 bool NumList::Remove(const int64_t& theValue)  // if false, means the value was
                                                // NOT already there.
 {
-    auto it = m_setData.find(theValue);
-
-    if (m_setData.end() != it)  // it's there.
-    {
-        m_setData.erase(it);
-        return true;
-    }
-    return false;  // it wasn't there (so how could you remove it then?)
+    // if 0, it wasn't there (so how could you remove it then?)
+    return 1 == m_setData.erase(theValue);
 }
 
 bool NumList::Verify(const int64_t& theValue) const  // returns true/false
                                                      // (whether value is
                                                      // already there.)
 {
-    auto it = m_setData.find(theValue);
-
-    return (m_setData.end() == it) ? false : true;
+    return 1 == m_setData.count(theValue);
 }
 
 // True/False, based on whether values are already there.
@@ -251,24 +205,19 @@ bool NumList::Verify(const std::set<int64_t>& theNumbers) const
 ///
 bool NumList::Verify(const NumList& rhs) const
 {
-    // Verify they have the same number of elements.
-    //
-    if (Count() != rhs.Count()) return false;
-
-    // Verify each value on *this is also found on rhs.
-    //
-    for (auto& it : m_setData) {
-        if (!rhs.Verify(it)) return false;
-    }
-
-    return true;
+    // Equal sets have identical ranges.
+    return m_setData == rhs.m_setData;
 }
 
 /// True/False, based on whether ANY of the numbers in rhs are found in *this.
 ///
 bool NumList::VerifyAny(const NumList& rhs) const
 {
-    return rhs.VerifyAny(m_setData);
+    for (const auto& it : rhs.m_setData) {
+        if (Verify(it)) return true;
+    }
+
+    return false;
 }
 
 /// Verify whether ANY of the numbers on *this are found in setData.
@@ -289,10 +238,17 @@ bool NumList::Add(const NumList& theNumList)  // if false, means the numbers
                                               // were already there. (At
                                               // least one of them.)
 {
-    std::set<int64_t> theOutput;
-    theNumList.Output(theOutput);  // returns false if the numlist was empty.
+    bool bSuccess = true;
 
-    return Add(theOutput);
+    for (const auto& it : theNumList.m_setData.Ranges()) {
+        const auto count = static_cast<std::size_t>(it.second - it.first) + 1;
+
+        if (count != m_setData.InsertRange(it.first, it.second)) {
+            bSuccess = false;
+        }
+    }
+
+    return bSuccess;
 }
 
 bool NumList::Add(const std::set<int64_t>& theNumbers)  // if false, means the
@@ -333,7 +289,7 @@ bool NumList::Output(std::set<int64_t>& theOutput) const  // returns false if
                                                           // the numlist was
                                                           // empty.
 {
-    theOutput = m_setData;
+    theOutput = m_setData.Set();
 
     return !m_setData.empty();
 }
@@ -360,9 +316,20 @@ bool NumList::Output(String& strOutput) const  // returns false if the
     return !m_setData.empty();
 }
 
-int32_t NumList::Count() const
+// Outputs the numlist with contiguous numbers collapsed into ranges, for
+// example "5-1000,1003". Only AddRanges() reads this form.
+//
+bool NumList::OutputRanges(String& strOutput) const  // returns false if the
+                                                     // numlist was empty.
+{
+    strOutput.Concatenate(String(m_setData.Encode()));
+
+    return !m_setData.empty();
+}
+
+int64_t NumList::Count() const
 {
-    return static_cast<int32_t>(m_setData.size());
+    return static_cast<int64_t>(m_setData.size());
 }
 
 void NumList::Release() { m_setData.clear(); }
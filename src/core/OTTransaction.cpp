@@ -2894,9 +2894,8 @@ bool OTTransaction::VerifyItems(Nym& theNym)
     // items
     // and the transaction both have the same owner: Nym.
 
-    // if pointer not null, and it's a withdrawal, and it's an acknowledgement
-    // (not a rejection or error)
-    //
+    std::vector<const Contract*> items{};
+
     for (auto& it : GetItemList()) {
         // loop through the ALL items that make up this transaction and check
         // to see if a response to deposit.
@@ -2907,13 +2906,16 @@ bool OTTransaction::VerifyItems(Nym& theNym)
 
         if (NYM_ID != pItem->GetNymID()) return false;
 
-        if (!pItem->VerifySignature(theNym))  // NO need to call
-                                              // VerifyAccount since
-                                              // VerifyContractID is
-                                              // ALREADY called and now
-                                              // here's
-                                              // VerifySignature().
+        items.push_back(pItem);
+    }
+
+    // NO need to call VerifyAccount since VerifyContractID is ALREADY called.
+    // The item signatures are all checked together.
+    for (const bool verified : Contract::VerifySignatures(items, theNym)) {
+        if (false == verified) {
+
             return false;
+        }
     }
 
     return true;
@@ -4706,7 +4708,9 @@ void OTTransaction::SaveAbbreviatedNymboxRecord(Tag& parent)
                                             // been signed out.
             {
                 // This is always 0, except for blanks and successNotices.
-                if (m_Numlist.Count() > 0) m_Numlist.Output(strListOfBlanks);
+                if (m_Numlist.Count() > 0) {
+                    m_Numlist.Output(strListOfBlanks);
+                }
             }
             [[fallthrough]];
         case OTTransaction::replyNotice:  // A copy of a server reply to a
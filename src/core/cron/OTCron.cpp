@@ -59,7 +59,9 @@
 
 #include <irrxml/irrXML.hpp>
 #include <string.h>
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -573,7 +575,70 @@ void OTCron::UpdateContents()
 
 int64_t OTCron::computeTimeout()
 {
-    return OTCron::GetCronMsBetweenProcess() - tCron.getElapsedTimeInMilliSec();
+    const int64_t throttle =
+        OTCron::GetCronMsBetweenProcess() - tCron.getElapsedTimeInMilliSec();
+    Lock lock(m_lockSchedule);
+
+    if ((false == m_bIsActivated) || m_multimapSchedule.empty()) {
+
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    const auto next = m_multimapSchedule.begin()->first;
+    lock.unlock();
+    const int64_t due =
+        1000 * OTTimeGetTimeInterval(next, OTTimeGetCurrentTime());
+
+    return std::max(throttle, due);
+}
+
+// Items are processed no sooner than their own processing interval (see
+// OTCronItem::ProcessCron and its overrides) and no later than the moment they
+// expire. The result is always after now, so an item whose ProcessCron did not
+// advance its last process date is not picked up again in the same round.
+time64_t OTCron::next_due(const OTCronItem& item, const time64_t now) const
+{
+    const auto lastProcessed = item.GetLastProcessDate();
+    const auto expires = item.GetValidTo();
+    const auto earliest = OTTimeAddTimeInterval(now, 1);
+    time64_t output = earliest;
+
+    if (OT_TIME_ZERO < lastProcessed) {
+        output = std::max(
+            output,
+            OTTimeAddTimeInterval(
+                lastProcessed, item.GetProcessInterval() + 1));
+    }
+
+    if (OT_TIME_ZERO < expires) {
+        output = std::min(output, OTTimeAddTimeInterval(expires, 1));
+    }
+
+    return std::max(output, earliest);
+}
+
+void OTCron::schedule(const int64_t lTransactionNum, const time64_t due)
+{
+    Lock lock(m_lockSchedule);
+    m_multimapSchedule.emplace(due, lTransactionNum);
+}
+
+// Returns the transaction number of the earliest item which is due at or
+// before now and removes it from the schedule, or 0 if nothing is due.
+int64_t OTCron::take_due_item(const time64_t now)
+{
+    Lock lock(m_lockSchedule);
+    auto it = m_multimapSchedule.begin();
+
+    if ((m_multimapSchedule.end() == it) || (it->first > now)) {
+
+        return 0;
+    }
+
+    const auto output = it->second;
+    m_multimapSchedule.erase(it);
+
+    return output;
 }
 
 // Make sure to call this regularly so the CronItems get a chance to process and
@@ -607,12 +672,13 @@ void OTCron::ProcessCronItems()
         return;
     }
     bool bNeedToSave = false;
+    const auto now = OTTimeGetCurrentTime();
 
-    // loop through the cron items and tell each one to ProcessCron().
-    // If the item returns true, that means leave it on the list. Otherwise,
-    // if it returns false, that means "it's done: remove it."
-    for (auto it = m_multimapCronItems.begin();
-         it != m_multimapCronItems.end();) {
+    // loop through the cron items which are due and tell each one to
+    // ProcessCron(). If the item returns true, that means leave it on the list
+    // and schedule it again. Otherwise, if it returns false, that means "it's
+    // done: remove it."
+    while (true) {
         if (GetTransactionCount() <= nTwentyPercent) {
             otErr << "WARNING: Cron has fewer than 20 percent of its normal "
                      "transaction "
@@ -628,22 +694,37 @@ void OTCron::ProcessCronItems()
                      "SCHEDULED FOR THIS ROUND!!!\n\n";
             break;
         }
-        OTCronItem* pItem = it->second;
+
+        const auto lTransactionNum = take_due_item(now);
+
+        if (0 == lTransactionNum) {
+            break;
+        }
+
+        auto it_map = FindItemOnMap(lTransactionNum);
+
+        // Removed from cron since it was scheduled
+        if (m_mapCronItems.end() == it_map) {
+            continue;
+        }
+
+        OTCronItem* pItem = it_map->second;
         OT_ASSERT(nullptr != pItem);
         otInfo << "OTCron::" << __FUNCTION__
                << ": Processing item number: " << pItem->GetTransactionNum()
                << " \n";
 
         if (pItem->ProcessCron()) {
-            it++;
+            schedule(lTransactionNum, next_due(*pItem, now));
+
             continue;
         }
         pItem->HookRemovalFromCron(nullptr, GetNextTransactionNumber());
         otOut << "OTCron::" << __FUNCTION__
               << ": Removing cron item: " << pItem->GetTransactionNum() << "\n";
-        it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
-        OT_ASSERT(m_mapCronItems.end() != it_map);
+        auto it_multimap = FindItemOnMultimap(lTransactionNum);
+        OT_ASSERT(m_multimapCronItems.end() != it_multimap);
+        m_multimapCronItems.erase(it_multimap);
         m_mapCronItems.erase(it_map);
 
         delete pItem;
@@ -712,6 +793,9 @@ bool OTCron::AddCronItem(
         theItem.setServerNym(m_pServerNym);
         theItem.setNotaryID(&m_NOTARY_ID);
 
+        // New items are processed on the next round
+        schedule(theItem.GetTransactionNum(), OTTimeGetCurrentTime());
+
         bool bSuccess = true;
 
         theItem.HookActivationOnCron(
@@ -1135,6 +1219,10 @@ void OTCron::Release_Cron()
 {
     // If there were any dynamically allocated objects, clean them up here.
 
+    Lock lock(m_lockSchedule);
+    m_multimapSchedule.clear();
+    lock.unlock();
+
     while (!m_multimapCronItems.empty()) {
         auto it = m_multimapCronItems.begin();
         m_multimapCronItems.erase(it);
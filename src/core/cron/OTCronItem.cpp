@@ -255,8 +255,9 @@ bool OTCronItem::GetActiveCronTransNums(
                          "and then failed decoding. Contents: \n"
                       << strNumlist << "\n";
                 return false;
-            } else
-                output.Add(strNumlist);
+            } else {
+                output.AddRanges(strNumlist);
+            }
         }
     }
 
@@ -302,8 +303,9 @@ bool OTCronItem::EraseActiveCronReceipt(
                          "was encoded "
                          "and then failed decoding. Contents: \n"
                       << strNumlist << "\n";
-            } else
-                numlist.Add(strNumlist);
+            } else {
+                numlist.AddRanges(strNumlist);
+            }
         }
 
         strNumlist.Release();
@@ -319,7 +321,7 @@ bool OTCronItem::EraseActiveCronReceipt(
                       << Log::PathSeparator() << strListFilename << "\n";
             }
         } else {
-            numlist.Output(strNumlist);
+            numlist.OutputRanges(strNumlist);
 
             String strFinal;
             OTASCIIArmor ascTemp(strNumlist);
@@ -420,8 +422,9 @@ bool OTCronItem::SaveActiveCronReceipt(
                           << ": Input string apparently was encoded and then"
                              " failed decoding. Contents: \n"
                           << strNumlist << "\n";
-                } else
-                    numlist.Add(strNumlist);
+                } else {
+                    numlist.AddRanges(strNumlist);
+                }
             }
         }
 
@@ -429,7 +432,7 @@ bool OTCronItem::SaveActiveCronReceipt(
 
         String strNumlist;
 
-        if (numlist.Output(strNumlist)) {
+        if (numlist.OutputRanges(strNumlist)) {
             String strFinal;
             OTASCIIArmor ascTemp(strNumlist);
 
@@ -60,6 +60,30 @@
 namespace opentxs
 {
 
+bool Bip32::AccountChainKey(
+    const proto::HDPath& rootPath,
+    const BIP44Chain internal,
+    Data& publicKey,
+    OTPassword& chainCode) const
+{
+    auto path = rootPath;
+    auto fingerprint = rootPath.root();
+    std::uint32_t notUsed = 0;
+    auto seed = OT::App().Crypto().BIP39().Seed(fingerprint, notUsed);
+    path.set_root(fingerprint);
+
+    if (false == bool(seed)) {
+
+        return false;
+    }
+
+    const std::uint32_t change = internal ? 1 : 0;
+    path.add_child(change);
+
+    return GetHDPublicNode(
+        EcdsaCurve::SECP256K1, *seed, path, publicKey, chainCode);
+}
+
 serializedAsymmetricKey Bip32::AccountChildKey(
     const proto::HDPath& rootPath,
     const BIP44Chain internal,
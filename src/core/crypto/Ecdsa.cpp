@@ -51,6 +51,7 @@
 #include "opentxs/core/crypto/CryptoSymmetric.hpp"
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
+#include "opentxs/core/crypto/PrivateKeyCache.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
@@ -96,6 +97,13 @@ bool Ecdsa::DecryptPrivateKey(
     const OTPasswordData& password,
     OTPassword& plaintextKey)
 {
+    const auto& cache = OT::App().Crypto().KeyCache();
+
+    if (cache.Get(encryptedKey, plaintextKey)) {
+
+        return true;
+    }
+
     auto key = OT::App().Crypto().Symmetric().Key(
         encryptedKey.key(), encryptedKey.mode());
 
@@ -103,7 +111,14 @@ bool Ecdsa::DecryptPrivateKey(
         return false;
     }
 
-    return key->Decrypt(encryptedKey, password, plaintextKey);
+    if (false == key->Decrypt(encryptedKey, password, plaintextKey)) {
+
+        return false;
+    }
+
+    cache.Add(encryptedKey, plaintextKey);
+
+    return true;
 }
 
 bool Ecdsa::DecryptPrivateKey(
@@ -63,6 +63,8 @@
 #include <stdint.h>
 #include <ostream>
 
+#define OT_SECP256K1_PUBKEY_CACHE_SIZE 4096
+
 namespace opentxs
 {
 bool Libsecp256k1::Initialized_ = false;
@@ -73,6 +75,8 @@ Libsecp256k1::Libsecp256k1(api::crypto::Util& ssl, Ecdsa& ecdsa)
           SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY))
     , ecdsa_(ecdsa)
     , ssl_(ssl)
+    , pubkey_lock_()
+    , pubkeys_()
 {
     OT_ASSERT_MSG(nullptr != context_, "secp256k1_context_create failed.");
 }
@@ -289,11 +293,40 @@ bool Libsecp256k1::ParsePublicKey(const Data& input, secp256k1_pubkey& output)
         return false;
     }
 
-    return secp256k1_ec_pubkey_parse(
+    const std::string serialized(
+        static_cast<const char*>(input.GetPointer()), input.GetSize());
+    Lock lock(pubkey_lock_);
+    const auto it = pubkeys_.find(serialized);
+
+    if (pubkeys_.end() != it) {
+        output = it->second;
+
+        return true;
+    }
+
+    lock.unlock();
+    const bool parsed = secp256k1_ec_pubkey_parse(
         context_,
         &output,
         reinterpret_cast<const unsigned char*>(input.GetPointer()),
         input.GetSize());
+
+    if (false == parsed) {
+
+        return false;
+    }
+
+    lock.lock();
+
+    // Signing keys are long lived, so simply starting over is enough to
+    // bound the size of the cache
+    if (OT_SECP256K1_PUBKEY_CACHE_SIZE <= pubkeys_.size()) {
+        pubkeys_.clear();
+    }
+
+    pubkeys_.emplace(serialized, output);
+
+    return true;
 }
 
 bool Libsecp256k1::ScalarBaseMultiply(
@@ -55,6 +55,7 @@
 #include <sys/types.h>
 #include <zconf.h>
 #include <zlib.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <sstream>
@@ -192,91 +193,166 @@ OTASCIIArmor& OTASCIIArmor::operator=(const OTASCIIArmor& strValue)
     return *this;
 }
 
-// Source for these two functions: http://panthema.net/2007/0328-ZLibString.html
+namespace
+{
+// zlib allocates several hundred kilobytes of state for every stream, so each
+// thread keeps one deflate and one inflate stream and resets them between
+// uses instead of initializing and tearing down a stream for every call.
+class ZlibStreams
+{
+public:
+    z_stream* Deflate(const int level)
+    {
+        if (false == deflate_ready_) {
+            std::memset(&deflate_, 0, sizeof(deflate_));
+
+            if (Z_OK != deflateInit(&deflate_, level)) {
+
+                return nullptr;
+            }
+
+            deflate_ready_ = true;
+            deflate_level_ = level;
+        } else if (Z_OK != deflateReset(&deflate_)) {
+
+            return nullptr;
+        }
+
+        if (level != deflate_level_) {
+            if (Z_OK != deflateParams(&deflate_, level, Z_DEFAULT_STRATEGY)) {
+
+                return nullptr;
+            }
+
+            deflate_level_ = level;
+        }
+
+        return &deflate_;
+    }
+
+    z_stream* Inflate()
+    {
+        if (false == inflate_ready_) {
+            std::memset(&inflate_, 0, sizeof(inflate_));
+
+            if (Z_OK != inflateInit(&inflate_)) {
+
+                return nullptr;
+            }
+
+            inflate_ready_ = true;
+        } else if (Z_OK != inflateReset(&inflate_)) {
+
+            return nullptr;
+        }
+
+        return &inflate_;
+    }
+
+    ~ZlibStreams()
+    {
+        if (deflate_ready_) {
+            deflateEnd(&deflate_);
+        }
+
+        if (inflate_ready_) {
+            inflateEnd(&inflate_);
+        }
+    }
+
+private:
+    z_stream deflate_{};
+    bool deflate_ready_{false};
+    int deflate_level_{Z_DEFAULT_COMPRESSION};
+    z_stream inflate_{};
+    bool inflate_ready_{false};
+};
+
+thread_local ZlibStreams zlib_streams_{};
+}  // namespace
 
 /** Compress a STL string using zlib with given compression level and return
  * the binary data. */
 std::string OTASCIIArmor::compress_string(
     const std::string& str,
-    int32_t compressionlevel = Z_BEST_COMPRESSION) const
+    ArmorCompression compression) const
 {
-    z_stream zs;  // z_stream is zlib's control structure
-    memset(&zs, 0, sizeof(zs));
+    int level = static_cast<int>(compression);
 
-    if (deflateInit(&zs, compressionlevel) != Z_OK)
-        throw(std::runtime_error("deflateInit failed while compressing."));
+    if (ArmorCompression::Automatic == compression) {
+        level = (OT_ARMOR_RAW_THRESHOLD > str.size()) ? Z_NO_COMPRESSION
+                                                      : Z_BEST_COMPRESSION;
+    }
 
-    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
-    zs.avail_in = static_cast<uInt>(str.size());  // set the z_stream's input
+    auto* zs = zlib_streams_.Deflate(level);
 
-    int32_t ret;
-    char outbuffer[32768];
-    std::string outstring;
+    if (nullptr == zs) {
+        throw(std::runtime_error("deflateInit failed while compressing."));
+    }
 
-    // retrieve the compressed bytes blockwise
-    do {
-        zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-        zs.avail_out = sizeof(outbuffer);
+    // deflateBound guarantees that a single call to deflate is sufficient
+    std::string outstring(deflateBound(zs, str.size()), '\0');
+    zs->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
+    zs->avail_in = static_cast<uInt>(str.size());
+    zs->next_out = reinterpret_cast<Bytef*>(&outstring[0]);
+    zs->avail_out = static_cast<uInt>(outstring.size());
+    const auto ret = deflate(zs, Z_FINISH);
 
-        ret = deflate(&zs, Z_FINISH);
+    if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
+        std::ostringstream oss;
+        oss << "Exception during zlib compression: (" << ret << ")";
 
-        if (outstring.size() < zs.total_out) {
-            // append the block to the output string
-            outstring.append(outbuffer, zs.total_out - outstring.size());
+        if (zs->msg != nullptr) {
+            oss << " " << zs->msg;
         }
-    } while (ret == Z_OK);
-
-    deflateEnd(&zs);
 
-    if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
-        std::ostringstream oss;
-        oss << "Exception during zlib compression: (" << ret << ") " << zs.msg;
         throw(std::runtime_error(oss.str()));
     }
 
+    outstring.resize(zs->total_out);
+
     return outstring;
 }
 
 /** Decompress an STL string using zlib and return the original data. */
 std::string OTASCIIArmor::decompress_string(const std::string& str) const
 {
-    z_stream zs;  // z_stream is zlib's control structure
-    memset(&zs, 0, sizeof(zs));
+    auto* zs = zlib_streams_.Inflate();
 
-    if (inflateInit(&zs) != Z_OK)
+    if (nullptr == zs) {
         throw(std::runtime_error("inflateInit failed while decompressing."));
+    }
 
-    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
-    zs.avail_in = static_cast<uInt>(str.size());
+    zs->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
+    zs->avail_in = static_cast<uInt>(str.size());
 
     int32_t ret;
-    char outbuffer[32768];
     std::string outstring;
+    // Armored text typically compresses by a factor of three or four
+    outstring.resize(std::max<std::size_t>(4 * str.size(), 1024));
 
-    // get the decompressed bytes blockwise using repeated calls to inflate
+    // inflate directly into the output string, growing it as needed
     do {
-        zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-        zs.avail_out = sizeof(outbuffer);
-
-        ret = inflate(&zs, 0);
-
-        if (outstring.size() < zs.total_out) {
-            outstring.append(outbuffer, zs.total_out - outstring.size());
+        if (outstring.size() == zs->total_out) {
+            outstring.resize(2 * outstring.size());
         }
 
+        zs->next_out = reinterpret_cast<Bytef*>(&outstring[zs->total_out]);
+        zs->avail_out = static_cast<uInt>(outstring.size() - zs->total_out);
+        ret = inflate(zs, Z_NO_FLUSH);
     } while (ret == Z_OK);
 
-    inflateEnd(&zs);
-
     if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
         std::ostringstream oss;
         oss << "Exception during zlib decompression: (" << ret << ")";
-        if (zs.msg != nullptr) {
-            oss << " " << zs.msg;
+        if (zs->msg != nullptr) {
+            oss << " " << zs->msg;
         }
         throw(std::runtime_error(oss.str()));
     }
 
+    outstring.resize(zs->total_out);
+
     return outstring;
 }
 
@@ -349,13 +425,26 @@ bool OTASCIIArmor::GetString(String& strData, bool bLineBreaks) const
 }
 
 // Compress and Base64-encode
-bool OTASCIIArmor::SetString(const String& strData, bool bLineBreaks)  //=true
+bool OTASCIIArmor::SetString(
+    const String& strData,
+    bool bLineBreaks,
+    ArmorCompression compression)
 {
     Release();
 
     if (strData.GetLength() < 1) return true;
 
-    std::string str_compressed = compress_string(strData.Get());
+    std::string str_compressed;
+
+    try {
+        str_compressed = compress_string(
+            std::string(strData.Get(), strData.GetLength()), compression);
+    } catch (const std::runtime_error& e) {
+        otErr << "OTASCIIArmor::" << __FUNCTION__ << ": " << e.what()
+              << std::endl;
+
+        return false;
+    }
 
     // "Success"
     if (str_compressed.size() == 0) {
@@ -50,6 +50,7 @@
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
 #include "opentxs/core/crypto/OTSymmetricKey.hpp"
+#include "opentxs/core/crypto/PrivateKeyCache.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
@@ -82,6 +83,7 @@ OTCachedKey::OTCachedKey(const std::int32_t nTimeoutSeconds)
     , thread_(nullptr)
     , master_password_(nullptr)
     , key_(nullptr)
+    , private_keys_(nullptr)
 {
 }
 
@@ -759,6 +761,23 @@ bool OTCachedKey::Pause()
     return false;
 }
 
+void OTCachedKey::clear_master_password(const Lock& lock) const
+{
+    OT_ASSERT(lock.mutex() == &master_password_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    if (false == bool(master_password_)) {
+
+        return;
+    }
+
+    master_password_.reset();
+
+    if (nullptr != private_keys_) {
+        private_keys_->Clear();
+    }
+}
+
 void OTCachedKey::release_thread() const
 {
     shutdown_->On();
@@ -768,7 +787,15 @@ void OTCachedKey::release_thread() const
     }
 }
 
-void OTCachedKey::Reset() { reset_master_password(); }
+void OTCachedKey::Reset()
+{
+    reset_master_password();
+
+    // The timeout thread may already have destroyed the master password
+    if (nullptr != private_keys_) {
+        private_keys_->Clear();
+    }
+}
 
 void OTCachedKey::reset_timer(const Lock& lock) const
 {
@@ -780,7 +807,7 @@ void OTCachedKey::reset_master_password()
     Lock outer(general_lock_);
     release_thread();
     Lock inner(master_password_lock_);
-    master_password_.reset();
+    clear_master_password(inner);
     inner.unlock();
 
     if (key_) {
@@ -865,7 +892,7 @@ void OTCachedKey::timeout_thread() const
             if (duration > limit) {
                 if (timeout_.load() != (-1)) {
                     Lock lock(master_password_lock_);
-                    master_password_.reset();
+                    clear_master_password(lock);
                     lock.unlock();
                 }
             }
@@ -875,7 +902,7 @@ void OTCachedKey::timeout_thread() const
     }
 
     Lock lock(master_password_lock_);
-    master_password_.reset();
+    clear_master_password(lock);
     lock.unlock();
 
     if (IsUsingSystemKeyring()) {
@@ -0,0 +1,175 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/crypto/PrivateKeyCache.hpp"
+
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Log.hpp"
+
+namespace opentxs
+{
+PrivateKeyCache::PrivateKeyCache(
+    const std::size_t limit,
+    const std::chrono::seconds& timeout)
+    : limit_(limit)
+    , timeout_(timeout.count())
+    , lock_()
+    , lru_()
+    , index_()
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+void PrivateKeyCache::Add(
+    const proto::Ciphertext& encrypted,
+    const OTPassword& plaintext) const
+{
+    if ((0 == timeout_.load()) || (false == plaintext.isMemory())) {
+
+        return;
+    }
+
+    std::unique_ptr<OTPassword> copy(new OTPassword);
+
+    OT_ASSERT(copy);
+
+    copy->setMemory(plaintext.getMemory(), plaintext.getMemorySize());
+    const auto id = key(encrypted);
+    const auto now = std::chrono::steady_clock::now();
+    Lock lock(lock_);
+    auto it = index_.find(id);
+
+    if (index_.end() != it) {
+        std::get<2>(*it->second) = now;
+        lru_.splice(lru_.begin(), lru_, it->second);
+
+        return;
+    }
+
+    lru_.emplace_front(id, std::move(copy), now);
+    index_.emplace(id, lru_.begin());
+    trim(lock, now);
+}
+
+void PrivateKeyCache::Clear() const
+{
+    Lock lock(lock_);
+    index_.clear();
+    lru_.clear();
+}
+
+bool PrivateKeyCache::expired(const Time& used, const Time& now) const
+{
+    const auto timeout = timeout_.load();
+
+    if (-1 == timeout) {
+
+        return false;
+    }
+
+    return (now - used) > std::chrono::seconds(timeout);
+}
+
+bool PrivateKeyCache::Get(
+    const proto::Ciphertext& encrypted,
+    OTPassword& plaintext) const
+{
+    if (0 == timeout_.load()) {
+
+        return false;
+    }
+
+    const auto id = key(encrypted);
+    const auto now = std::chrono::steady_clock::now();
+    Lock lock(lock_);
+    trim(lock, now);
+    auto it = index_.find(id);
+
+    if (index_.end() == it) {
+        lock.unlock();
+        ++misses_;
+
+        return false;
+    }
+
+    auto& entry = *it->second;
+    const auto& cached = std::get<1>(entry);
+
+    OT_ASSERT(cached);
+
+    plaintext.setMemory(cached->getMemory(), cached->getMemorySize());
+    std::get<2>(entry) = now;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    lock.unlock();
+    ++hits_;
+
+    return true;
+}
+
+std::string PrivateKeyCache::key(const proto::Ciphertext& encrypted)
+{
+    return proto::ProtoAsString(encrypted);
+}
+
+void PrivateKeyCache::SetTimeout(const std::chrono::seconds& timeout) const
+{
+    timeout_.store(timeout.count());
+
+    if (0 == timeout.count()) {
+        Clear();
+    }
+}
+
+void PrivateKeyCache::trim(const Lock& lock, const Time& now) const
+{
+    OT_ASSERT(lock.mutex() == &lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    // The list is ordered by last use, so expired entries are at the back
+    while ((false == lru_.empty()) &&
+           ((lru_.size() > limit_) || expired(std::get<2>(lru_.back()), now))) {
+        index_.erase(std::get<0>(lru_.back()));
+        lru_.pop_back();
+    }
+}
+
+PrivateKeyCache::~PrivateKeyCache() { Clear(); }
+}  // namespace opentxs
@@ -250,6 +250,94 @@ serializedAsymmetricKey TrezorCrypto::GetHDKey(
     return output;
 }
 
+bool TrezorCrypto::GetHDPublicNode(
+    const EcdsaCurve& curve,
+    const OTPassword& seed,
+    proto::HDPath& path,
+    Data& publicKey,
+    OTPassword& chainCode) const
+{
+    otInfo << OT_METHOD << __FUNCTION__ << ": Deriving node:\n"
+           << Print(path) << std::endl;
+    auto node = DeriveChild(curve, seed, path);
+
+    if (!node) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to derive node."
+              << std::endl;
+
+        return false;
+    }
+
+    ::hdnode_fill_public_key(node.get());
+    publicKey.Assign(node->public_key, sizeof(node->public_key));
+    chainCode.setMemory(node->chain_code, sizeof(node->chain_code));
+    OTPassword::zeroMemory(node->private_key, sizeof(node->private_key));
+
+    return true;
+}
+
+bool TrezorCrypto::GetPublicChild(
+    const EcdsaCurve& curve,
+    const Data& parentKey,
+    const OTPassword& parentChainCode,
+    const std::uint32_t index,
+    Data& childKey) const
+{
+    if (0 != (index & static_cast<std::uint32_t>(Bip32Child::HARDENED))) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Hardened children require the private key." << std::endl;
+
+        return false;
+    }
+
+    HDNode node{};
+
+    if (EcdsaCurve::SECP256K1 == curve) {
+        node.curve = secp256k1_;
+    } else {
+        node.curve = get_curve_by_name(CurveName(curve).c_str());
+    }
+
+    if (nullptr == node.curve) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unsupported curve."
+              << std::endl;
+
+        return false;
+    }
+
+    if ((sizeof(node.public_key) != parentKey.GetSize()) ||
+        (sizeof(node.chain_code) != parentChainCode.getMemorySize())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid parent node."
+              << std::endl;
+
+        return false;
+    }
+
+    OTPassword::safe_memcpy(
+        &(node.public_key[0]),
+        sizeof(node.public_key),
+        parentKey.GetPointer(),
+        parentKey.GetSize(),
+        false);
+    OTPassword::safe_memcpy(
+        &(node.chain_code[0]),
+        sizeof(node.chain_code),
+        parentChainCode.getMemory(),
+        parentChainCode.getMemorySize(),
+        false);
+
+    if (1 != ::hdnode_public_ckd(&node, index)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to derive child."
+              << std::endl;
+
+        return false;
+    }
+
+    childKey.Assign(node.public_key, sizeof(node.public_key));
+
+    return true;
+}
+
 serializedAsymmetricKey TrezorCrypto::HDNodeToSerialized(
     const proto::AsymmetricKeyType& type,
     const HDNode& node,
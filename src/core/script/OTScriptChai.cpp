@@ -44,6 +44,8 @@
 #include "opentxs/core/script/OTParty.hpp"
 #include "opentxs/core/script/OTPartyAccount.hpp"
 #include "opentxs/core/script/OTScript.hpp"
+#include "opentxs/core/script/OTScriptable.hpp"
+#include "opentxs/core/script/OTSmartContract.hpp"
 #include "opentxs/core/script/OTVariable.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Log.hpp"
@@ -55,39 +57,341 @@
 #endif
 
 #include <stddef.h>
+#include <algorithm>
 #include <stdint.h>
 #include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
+
+// Idle engines kept by the pool
+#define OT_CHAI_MAX_IDLE_ENGINES 16
+// Parsed clauses kept by each engine
+#define OT_CHAI_MAX_PARSED_SCRIPTS 256
 
 namespace opentxs
 {
+class ChaiEngine
+{
+public:
+    chaiscript::ChaiScript chai_;
+
+    chaiscript::Boxed_Value Eval(
+        const std::string& script,
+        const std::string& filename);
+    /** Returns false if the engine can not be reused */
+    bool Reset();
+    void SetScriptable(OTScriptable* scriptable) { scriptable_ = scriptable; }
+    void SetSmartContract(OTSmartContract* contract) { contract_ = contract; }
+
+    ChaiEngine();
+
+private:
+    /** Source file name and script text */
+    typedef std::pair<std::string, std::string> ParsedKey;
+    typedef chaiscript::parser::ChaiScript_Parser<
+        chaiscript::eval::Noop_Tracer,
+        chaiscript::optimizer::Optimizer_Default>
+        Parser;
+
+    OTScriptable* scriptable_{nullptr};
+    OTSmartContract* contract_{nullptr};
+    chaiscript::ChaiScript::State clean_state_{};
+    std::map<std::string, chaiscript::Boxed_Value> clean_locals_{};
+    Parser parser_{};
+    std::map<ParsedKey, chaiscript::AST_NodePtr> parsed_{};
+
+    OTSmartContract& contract() const;
+    const chaiscript::AST_Node& parse(
+        const std::string& script,
+        const std::string& filename);
+    void register_native_calls();
+    void register_types();
+    OTScriptable& scriptable() const;
+
+    ChaiEngine(const ChaiEngine&) = delete;
+    ChaiEngine(ChaiEngine&&) = delete;
+    ChaiEngine& operator=(const ChaiEngine&) = delete;
+    ChaiEngine& operator=(ChaiEngine&&) = delete;
+};
+
+ChaiEngine::ChaiEngine()
+    : chai_()
+    , scriptable_(nullptr)
+    , contract_(nullptr)
+    , clean_state_()
+    , clean_locals_()
+    , parser_()
+    , parsed_()
+{
+    register_types();
+    register_native_calls();
+    clean_state_ = chai_.get_state();
+    clean_locals_ = chai_.get_locals();
+}
 
-bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
+OTSmartContract& ChaiEngine::contract() const
+{
+    if (nullptr == contract_) {
+        throw std::runtime_error("Not running a smart contract clause");
+    }
+
+    return *contract_;
+}
+
+chaiscript::Boxed_Value ChaiEngine::Eval(
+    const std::string& script,
+    const std::string& filename)
+{
+    const auto& ast = parse(script, filename);
+
+    try {
+        return chai_.eval(ast);
+    } catch (const chaiscript::Boxed_Value& error) {
+        // Evaluating a parsed script reports errors as boxed values rather
+        // than applying an exception specification
+        throw chai_.boxed_cast<const chaiscript::exception::eval_error&>(
+            error);
+    }
+}
+
+// Parsed with the same parser type the engine uses, so that errors report
+// the file name of the script
+const chaiscript::AST_Node& ChaiEngine::parse(
+    const std::string& script,
+    const std::string& filename)
+{
+    const ParsedKey key{filename, script};
+    auto it = parsed_.find(key);
+
+    if (parsed_.end() == it) {
+        if (OT_CHAI_MAX_PARSED_SCRIPTS <= parsed_.size()) {
+            parsed_.clear();
+        }
+
+        it = parsed_.emplace(key, parser_.parse(script, filename)).first;
+    }
+
+    OT_ASSERT(it->second);
+
+    return *it->second;
+}
+
+// The OT native functions which can be called from inside scripted clauses.
+// They are registered once per engine and forward to the objects bound for
+// the current execution.
+void ChaiEngine::register_native_calls()
 {
     using namespace chaiscript;
+    using Str = std::string;
+
+    chai_.add(fun(&OTScriptable::GetTime), "get_time");
+    chai_.add(
+        fun([this](Str party, Str clause) -> bool {
+            return scriptable().CanExecuteClause(party, clause);
+        }),
+        "party_may_execute_clause");
+    chai_.add(
+        fun([this](Str from, Str to, Str amount) -> bool {
+            return contract().MoveAcctFundsStr(from, to, amount);
+        }),
+        "move_funds");
+    chai_.add(
+        fun([this](Str from, Str to, Str amount) -> bool {
+            return contract().StashAcctFunds(from, to, amount);
+        }),
+        "stash_funds");
+    chai_.add(
+        fun([this](Str to, Str from, Str amount) -> bool {
+            return contract().UnstashAcctFunds(to, from, amount);
+        }),
+        "unstash_funds");
+    chai_.add(
+        fun([this](Str account) -> Str {
+            return contract().GetAcctBalance(account);
+        }),
+        "get_acct_balance");
+    chai_.add(
+        fun([this](Str account) -> Str {
+            return contract().GetInstrumentDefinitionIDofAcct(account);
+        }),
+        "get_acct_instrument_definition_id");
+    chai_.add(
+        fun([this](Str stash, Str unit) -> Str {
+            return contract().GetStashBalance(stash, unit);
+        }),
+        "get_stash_balance");
+    chai_.add(
+        fun([this](Str party) -> bool {
+            return contract().SendNoticeToParty(party);
+        }),
+        "send_notice");
+    chai_.add(
+        fun([this]() -> bool { return contract().SendANoticeToAllParties(); }),
+        "send_notice_to_parties");
+    chai_.add(
+        fun([this](Str seconds) -> void {
+            contract().SetRemainingTimer(seconds);
+        }),
+        "set_seconds_until_timer");
+    chai_.add(
+        fun([this]() -> Str { return contract().GetRemainingTimer(); }),
+        "get_remaining_timer");
+    chai_.add(
+        fun([this]() -> void { contract().DeactivateSmartContract(); }),
+        "deactivate_contract");
+    // Callback: param_party_name is available inside the script, which must
+    // return bool
+    chai_.add(
+        fun([this](Str party) -> bool {
+            return contract().CanCancelContract(party);
+        }),
+        "party_may_cancel_contract");
+}
 
-    OT_ASSERT(nullptr != chai_);
+// Script access to OTParty. Registered once per engine, like the native
+// calls.
+void ChaiEngine::register_types()
+{
+    using namespace chaiscript;
 
-    if (m_str_script.size() > 0) {
+    chai_.add(user_type<OTParty>(), "OTParty");
+    chai_.add(constructor<OTParty()>(), "OTParty");
+    chai_.add(
+        fun([](const OTParty& party) -> std::string {
+            return party.GetPartyName();
+        }),
+        "GetPartyName");
+    chai_.add(
+        fun([](const OTParty& party) -> std::string {
+            return party.GetNymID();
+        }),
+        "GetNymID");
+    chai_.add(
+        fun([](const OTParty& party) -> std::string {
+            return party.GetEntityID();
+        }),
+        "GetEntityID");
+    chai_.add(
+        fun([](const OTParty& party) -> std::string {
+            return party.GetPartyID();
+        }),
+        "GetPartyID");
+    chai_.add(fun(&OTParty::HasActiveAgent), "HasActiveAgent");
+}
 
-        /*
-        chai_->add(user_type<OTParty>(), "OTParty");
-        chai_->add(constructor<OTParty()>(), "OTParty");
-        chai_->add(constructor<OTParty(const OTParty&)>(), "OTParty");
-        chai_->add(fun<OTParty&(OTParty::*)(const
-        OTParty&)>(&OTParty::operator=), "=");
+bool ChaiEngine::Reset()
+{
+    scriptable_ = nullptr;
+    contract_ = nullptr;
+
+    try {
+        chai_.set_state(clean_state_);
+        chai_.set_locals(clean_locals_);
+    } catch (...) {
+
+        return false;
+    }
+
+    return true;
+}
+
+OTScriptable& ChaiEngine::scriptable() const
+{
+    if (nullptr == scriptable_) {
+        throw std::runtime_error("No scriptable bound to this engine");
+    }
+
+    return *scriptable_;
+}
 
-        chai_->add(fun(&OTParty::GetPartyName), "GetPartyName");
-        chai_->add(fun(&OTParty::GetNymID), "GetNymID");
-        chai_->add(fun(&OTParty::GetEntityID), "GetEntityID");
-        chai_->add(fun(&OTParty::GetPartyID), "GetPartyID");
-        chai_->add(fun(&OTParty::HasActiveAgent), "HasActiveAgent");
-        */
+namespace
+{
+class ChaiEnginePool
+{
+public:
+    std::unique_ptr<ChaiEngine> Get()
+    {
+        Lock lock(lock_);
+
+        if (false == idle_.empty()) {
+            auto output = std::move(idle_.back());
+            idle_.pop_back();
+
+            return output;
+        }
+
+        lock.unlock();
+
+        return std::make_unique<ChaiEngine>();
+    }
+
+    void Preload(const std::size_t count)
+    {
+        Lock lock(lock_);
 
-        // etc
+        while (idle_.size() < count) {
+            lock.unlock();
+            auto engine = std::make_unique<ChaiEngine>();
+            lock.lock();
+            idle_.emplace_back(std::move(engine));
+        }
+    }
+
+    void Return(std::unique_ptr<ChaiEngine>&& engine)
+    {
+        if ((false == bool(engine)) || (false == engine->Reset())) {
+
+            return;
+        }
 
-        //      chai_->add(m); // Here we add the OTParty class to the
-        //      chaiscript engine.
+        Lock lock(lock_);
+
+        if (OT_CHAI_MAX_IDLE_ENGINES > idle_.size()) {
+            idle_.emplace_back(std::move(engine));
+        }
+    }
+
+private:
+    std::mutex lock_{};
+    std::vector<std::unique_ptr<ChaiEngine>> idle_{};
+};
+
+ChaiEnginePool& engine_pool()
+{
+    static ChaiEnginePool pool{};
+
+    return pool;
+}
+}  // namespace
+
+void OTScriptChai::Preload(const std::size_t count)
+{
+    engine_pool().Preload(
+        std::min<std::size_t>(count, OT_CHAI_MAX_IDLE_ENGINES));
+}
+
+void OTScriptChai::SetScriptable(OTScriptable& scriptable)
+{
+    engine_->SetScriptable(&scriptable);
+}
+
+void OTScriptChai::SetSmartContract(OTSmartContract& contract)
+{
+    engine_->SetSmartContract(&contract);
+}
+
+bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
+{
+    using namespace chaiscript;
+
+    OT_ASSERT(engine_);
+    OT_ASSERT(nullptr != chai_);
+
+    if (m_str_script.size() > 0) {
 
         for (auto& it : m_mapParties) {
             OTParty* pParty = it.second;
@@ -250,35 +554,28 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
 
         try {
             if (nullptr == pReturnVar)  // Nothing to return.
-                chai_->eval(
-                    m_str_script.c_str(),
-                    exception_specification<const std::exception&>(),
-                    m_str_display_filename);
+                engine_->Eval(m_str_script, m_str_display_filename);
 
             else  // There's a return variable.
             {
                 switch (pReturnVar->GetType()) {
                     case OTVariable::Var_Integer: {
-                        int32_t nResult = chai_->eval<int32_t>(
-                            m_str_script.c_str(),
-                            exception_specification<const std::exception&>(),
-                            m_str_display_filename);
+                        int32_t nResult =
+                            chai_->boxed_cast<int32_t>(engine_->Eval(
+                                m_str_script, m_str_display_filename));
                         pReturnVar->SetValue(nResult);
                     } break;
 
                     case OTVariable::Var_Bool: {
-                        bool bResult = chai_->eval<bool>(
-                            m_str_script.c_str(),
-                            exception_specification<const std::exception&>(),
-                            m_str_display_filename);
+                        bool bResult = chai_->boxed_cast<bool>(engine_->Eval(
+                            m_str_script, m_str_display_filename));
                         pReturnVar->SetValue(bResult);
                     } break;
 
                     case OTVariable::Var_String: {
-                        std::string str_Result = chai_->eval<std::string>(
-                            m_str_script.c_str(),
-                            exception_specification<const std::exception&>(),
-                            m_str_display_filename);
+                        std::string str_Result =
+                            chai_->boxed_cast<std::string>(engine_->Eval(
+                                m_str_script, m_str_display_filename));
                         pReturnVar->SetValue(str_Result);
                     } break;
 
@@ -370,77 +667,41 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
     return true;
 }
 
-#if !defined(OT_USE_CHAI_STDLIB)
-
 OTScriptChai::OTScriptChai()
     : OTScript()
-    , chai_(new chaiscript::ChaiScript)
-{
-}
-
-OTScriptChai::OTScriptChai(const OTString& strValue)
-    : OTScript(strValue)
-    , chai_(new chaiscript::ChaiScript)
-{
-}
-
-OTScriptChai::OTScriptChai(const char* new_string)
-    : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
-{
-}
-
-OTScriptChai::OTScriptChai(const char* new_string, size_t sizeLength)
-    : OTScript(new_string, sizeLength)
-    , chai_(new chaiscript::ChaiScript)
-{
-}
-
-OTScriptChai::OTScriptChai(const std::string& new_string)
-    : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
-{
-}
-
-#else  // OT_USE_CHAI_STDLIB *is* defined...
-
-OTScriptChai::OTScriptChai()
-    : OTScript()
-    , chai_(new chaiscript::ChaiScript)
+    , engine_(engine_pool().Get())
+    , chai_(&engine_->chai_)
 {
 }
 
 OTScriptChai::OTScriptChai(const String& strValue)
     : OTScript(strValue)
-    , chai_(new chaiscript::ChaiScript)
+    , engine_(engine_pool().Get())
+    , chai_(&engine_->chai_)
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , engine_(engine_pool().Get())
+    , chai_(&engine_->chai_)
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string, size_t sizeLength)
     : OTScript(new_string, sizeLength)
-    , chai_(new chaiscript::ChaiScript)
+    , engine_(engine_pool().Get())
+    , chai_(&engine_->chai_)
 {
 }
 
 OTScriptChai::OTScriptChai(const std::string& new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , engine_(engine_pool().Get())
+    , chai_(&engine_->chai_)
 {
 }
 
-#endif  // defined(OT_USE_CHAI_STDLIB)
-
-OTScriptChai::~OTScriptChai()
-{
-    if (nullptr != chai_) delete chai_;
-
-    // chai = nullptr;  (It's const).
-}
+OTScriptChai::~OTScriptChai() { engine_pool().Return(std::move(engine_)); }
 }  // namespace opentxs
 #endif  // OT_SCRIPT_CHAI
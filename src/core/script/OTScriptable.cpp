@@ -318,21 +318,15 @@ void OTScriptable::RegisterOTNativeCallsWithScript(
     ANDROID_UNUSED OTScript& theScript)
 {
 #if OT_SCRIPT_CHAI
-    using namespace chaiscript;
-
     // In the future, this will be polymorphic.
     // But for now, I'm forcing things...
 
     OTScriptChai* pScript = dynamic_cast<OTScriptChai*>(&theScript);
 
     if (nullptr != pScript) {
-        OT_ASSERT(nullptr != pScript->chai_)
-
-        pScript->chai_->add(fun(&OTScriptable::GetTime), "get_time");
-
-        pScript->chai_->add(
-            fun(&OTScriptable::CanExecuteClause, this),
-            "party_may_execute_clause");
+        // The native calls are registered when the engine is created. This
+        // only binds them to this object.
+        pScript->SetScriptable(*this);
     } else
 #endif  // OT_SCRIPT_CHAI
     {
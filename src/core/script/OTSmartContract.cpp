@@ -736,19 +736,6 @@ DONE cron_activate        (Triggers when the smart contract is first activated.)
 // Cannot perform boxed_cast.
 // OTSmartContract::ExecuteClauses: Error while running script: process_clause
 
-// Class member, with string parameter.
-typedef bool (OTSmartContract::*OT_SM_RetBool_ThrStr)(
-    std::string from_acct_name,
-    std::string to_acct_name,
-    std::string str_Amount);
-
-// TEST RESULT: WORKS calling Chaiscript
-// Cron: Processing smart contract clauses for hook: cron_process
-// OTSmartContract::MoveAcctFunds: error: from_acct
-// (sSBcoTlTkYY8pPv6vh2KD6mIVrRdIwodgsWDoJzIfpV) not found on any party.
-// OTSmartContract::ExecuteClauses: Success executing script clause:
-// process_clause.
-
 // Class member, with std::int64_t parameter.
 // typedef bool (OTSmartContract::*OT_SM_RetBool_TwoStr_OneL)(const std::string
 // from_acct_name,
@@ -763,107 +750,23 @@ void OTSmartContract::RegisterOTNativeCallsWithScript(OTScript& theScript)
     OTScriptable::RegisterOTNativeCallsWithScript(theScript);
 
 #if OT_SCRIPT_CHAI
-    using namespace chaiscript;
-
     OTScriptChai* pScript = dynamic_cast<OTScriptChai*>(&theScript);
 
     if (nullptr != pScript) {
-        OT_ASSERT(nullptr != pScript->chai_)
-
-        // OT NATIVE FUNCTIONS
-        // (These functions can be called from INSIDE the scripted clauses.)
-        //                                                                                        //
-        // Parameters must match as described below. Return value will be as
-        // described below.
-        //
-        //      pScript->chai_->add(base_class<OTScriptable,
-        //      OTSmartContract>());
-
-        pScript->chai_->add(
-            fun<OT_SM_RetBool_ThrStr>(&OTSmartContract::MoveAcctFundsStr, this),
-            "move_funds");
-
-        pScript->chai_->add(
-            fun(&OTSmartContract::StashAcctFunds, this), "stash_funds");
-        pScript->chai_->add(
-            fun(&OTSmartContract::UnstashAcctFunds, this), "unstash_funds");
-        pScript->chai_->add(
-            fun(&OTSmartContract::GetAcctBalance, this), "get_acct_balance");
-        pScript->chai_->add(
-            fun(&OTSmartContract::GetInstrumentDefinitionIDofAcct, this),
-            "get_acct_instrument_definition_id");
-        pScript->chai_->add(
-            fun(&OTSmartContract::GetStashBalance, this), "get_stash_balance");
-        pScript->chai_->add(
-            fun(&OTSmartContract::SendNoticeToParty, this), "send_notice");
-        pScript->chai_->add(
-            fun(&OTSmartContract::SendANoticeToAllParties, this),
-            "send_notice_to_parties");
-        pScript->chai_->add(
-            fun(&OTSmartContract::SetRemainingTimer, this),
-            "set_seconds_until_timer");
-        pScript->chai_->add(
-            fun(&OTSmartContract::GetRemainingTimer, this),
-            "get_remaining_timer");
-
-        pScript->chai_->add(
-            fun(&OTSmartContract::DeactivateSmartContract, this),
-            "deactivate_contract");
-
-        // CALLBACKS
-        // (Called by OT at key moments) todo security: What if these are
-        // recursive? Need to lock down, put the smack down, on these smart
-        // contracts.
+        // The native functions (move_funds, stash_funds, send_notice, etc.)
+        // are registered when the engine is created; see OTScriptChai.cpp.
+        // This only binds them to this contract.
         //
-        // FYI:    pScript->chai_->add(fun(&(OTScriptable::CanExecuteClause),
-        // (*this)), "party_may_execute_clause");    // From OTScriptable (FYI)
-        // param_party_name and param_clause_name will be available inside
-        // script. Script must return bool.
-        // FYI:    #define SCRIPTABLE_CALLBACK_PARTY_MAY_EXECUTE
-        // "callback_party_may_execute_clause"   <=== THE CALLBACK WITH THIS
-        // NAME must be connected to a script clause, and then the clause will
-        // trigger when the callback is needed.
-
-        pScript->chai_->add(
-            fun(&OTSmartContract::CanCancelContract, this),
-            "party_may_cancel_contract");  // param_party_name
-                                           // will be available
-                                           // inside script.
-                                           // Script must return
-                                           // bool.
-        // FYI:    #define SMARTCONTRACT_CALLBACK_PARTY_MAY_CANCEL
-        // "callback_party_may_cancel_contract"  <=== THE CALLBACK WITH THIS
-        // NAME must be connected to a script clause, and then the clause will
-        // trigger when the callback is needed.
-
-        // Callback USAGE:    Your clause, in your smart contract, may have
-        // whatever name you want. (Within limits.)
-        //                    There must be a callback entry in the smart
-        // contract, linking your clause the the appropriate callback.
-        //                    The CALLBACK ENTRY uses the names
-        // "callback_party_may_execute_clause" and
-        // "callback_party_may_cancel_contract".
-        //                    If you want to call these from INSIDE YOUR SCRIPT,
-        // then use the names "party_may_execute_clause" and
-        // "party_may_cancel_contract".
-
         // HOOKS:
         //
         // Hooks are not native calls needing to be registered with the script.
-        // (Like the above functions are.)
         // Rather, hooks are SCRIPT CLAUSES, that you have a CHOICE to provide
-        // inside your SMART CONTRACT.
-        // *IF* you have provided those clauses, then OT *WILL* call them, at
-        // the appropriate times. (When
-        // specific events occur.) Specifically, Hook entries must be in your
-        // smartcontract, linking the below
-        // standard hooks to your clauses.
+        // inside your SMART CONTRACT. *IF* you have provided those clauses,
+        // then OT *WILL* call them, at the appropriate times.
         //
         // FYI:    #define SMARTCONTRACT_HOOK_ON_PROCESS        "cron_process"
-        // // Called regularly in OTSmartContract::ProcessCron() based on
-        // SMART_CONTRACT_PROCESS_INTERVAL.
         // FYI:    #define SMARTCONTRACT_HOOK_ON_ACTIVATE        "cron_activate"
-        // // Done. This is called when the contract is first activated.
+        pScript->SetSmartContract(*this);
     } else
 #endif  // OT_SCRIPT_CHAI
     {
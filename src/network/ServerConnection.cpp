@@ -52,13 +52,17 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
-#include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Proto.hpp"
 
 #include <chrono>
 #include <cstdint>
 
+#define SERVER_CONNECTION_MAX_IN_FLIGHT 16
+#define PIPELINE_POLL_MILLISECONDS 10
+#define PIPELINE_IDLE_MILLISECONDS 1000
+
 #define OT_METHOD "opentxs::ServerConnection::"
 
 namespace opentxs::network
@@ -82,15 +86,23 @@ ServerConnection::ServerConnection(
     , address_type_(zmq.DefaultAddressType())
     , remote_contract_(OT::App().Wallet().Server(Identifier(serverID)))
     , thread_(nullptr)
-    , socket_(zmq.Context().RequestSocket())
+    , pipeline_thread_(nullptr)
+    , socket_(zmq.Context().DealerSocket(true))
     , last_activity_(std::time(nullptr))
+    , running_(Flag::Factory(true))
     , socket_ready_(Flag::Factory(false))
     , status_(Flag::Factory(false))
     , use_proxy_(Flag::Factory(false))
+    , queue_lock_()
+    , queue_signal_()
+    , queue_()
+    , in_flight_()
 {
+    pipeline_thread_.reset(new std::thread(&ServerConnection::pipeline, this));
     thread_.reset(new std::thread(&ServerConnection::activity_timer, this));
 
     OT_ASSERT(remote_contract_)
+    OT_ASSERT(pipeline_thread_)
     OT_ASSERT(thread_)
 }
 
@@ -121,6 +133,52 @@ bool ServerConnection::EnableProxy()
     return true;
 }
 
+NetworkReplyMessage ServerConnection::decode_message(
+    NetworkReplyString&& input)
+{
+    NetworkReplyMessage output{input.first, nullptr};
+    auto& status = output.first;
+    auto& reply = output.second;
+    reply.reset(new Message);
+
+    OT_ASSERT(reply);
+
+    if (SendResult::VALID_REPLY == status) {
+        if (false == reply->LoadContractFromString(*input.second)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
+                  << "but unable to instantiate it as a Message." << std::endl;
+            reply.reset();
+            status = SendResult::INVALID_REPLY;
+        }
+    }
+
+    return output;
+}
+
+NetworkReplyString ServerConnection::decode_string(NetworkReplyRaw&& input)
+{
+    NetworkReplyString output{input.first, nullptr};
+    auto& status = output.first;
+    auto& reply = output.second;
+    reply.reset(new String);
+
+    OT_ASSERT(reply);
+
+    if (SendResult::VALID_REPLY == status) {
+        OTASCIIArmor armored;
+        armored.Set(input.second->c_str());
+
+        if (false == armored.GetString(*reply)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
+                  << "but unable to decode it into a String." << std::endl;
+            reply.reset();
+            status = SendResult::INVALID_REPLY;
+        }
+    }
+
+    return output;
+}
+
 std::string ServerConnection::endpoint() const
 {
     std::uint32_t port{0};
@@ -143,7 +201,57 @@ std::string ServerConnection::endpoint() const
     return endpoint;
 }
 
-zeromq::RequestSocket& ServerConnection::get_socket(const Lock& lock)
+void ServerConnection::expire_requests()
+{
+    const auto now = std::chrono::steady_clock::now();
+    auto it = in_flight_.begin();
+
+    while (in_flight_.end() != it) {
+        auto& request = it->second;
+
+        OT_ASSERT(request);
+
+        if (request->deadline_ > now) {
+            ++it;
+
+            continue;
+        }
+
+        otErr << OT_METHOD << __FUNCTION__ << ": Request " << it->first
+              << " timed out." << std::endl;
+        status_->Off();
+        reset_timer();
+        finish(request, SendResult::TIMEOUT);
+        it = in_flight_.erase(it);
+    }
+}
+
+void ServerConnection::fail_requests()
+{
+    for (auto& it : in_flight_) {
+        finish(it.second, SendResult::ERROR);
+    }
+
+    in_flight_.clear();
+}
+
+void ServerConnection::finish(
+    std::unique_ptr<Request>& request,
+    const SendResult status,
+    std::shared_ptr<std::string> reply)
+{
+    OT_ASSERT(request);
+
+    if (false == bool(reply)) {
+        reply.reset(new std::string);
+
+        OT_ASSERT(reply);
+    }
+
+    request->promise_.set_value(NetworkReplyRaw{status, reply});
+}
+
+zeromq::DealerSocket& ServerConnection::get_socket(const Lock& lock)
 {
     OT_ASSERT(verify_lock(lock))
 
@@ -155,6 +263,96 @@ zeromq::RequestSocket& ServerConnection::get_socket(const Lock& lock)
     return socket_;
 }
 
+std::deque<std::unique_ptr<ServerConnection::Request>> ServerConnection::
+    next_requests()
+{
+    std::deque<std::unique_ptr<Request>> output{};
+    Lock lock(queue_lock_);
+
+    if (queue_.empty() && in_flight_.empty()) {
+        queue_signal_.wait_for(
+            lock,
+            std::chrono::milliseconds(PIPELINE_IDLE_MILLISECONDS),
+            [&]() -> bool {
+                return (false == queue_.empty()) || (false == running_.get());
+            });
+    }
+
+    while ((false == queue_.empty()) &&
+           ((in_flight_.size() + output.size()) <
+            SERVER_CONNECTION_MAX_IN_FLIGHT)) {
+        output.emplace_back(std::move(queue_.front()));
+        queue_.pop_front();
+    }
+
+    return output;
+}
+
+void ServerConnection::pipeline()
+{
+    while (zmq_.Running() && running_.get()) {
+        auto requests = next_requests();
+
+        if (requests.empty() && in_flight_.empty()) {
+
+            continue;
+        }
+
+        Lock lock(lock_);
+
+        if (false == socket_ready_.get()) {
+            // Replies to anything sent on the old socket will never arrive
+            fail_requests();
+        }
+
+        auto& socket = get_socket(lock);
+        lock.unlock();
+        send_requests(socket, requests);
+        receive_replies(socket);
+        expire_requests();
+    }
+
+    Lock lock(queue_lock_);
+    running_->Off();
+    fail_requests();
+
+    for (auto& request : queue_) {
+        finish(request, SendResult::ERROR);
+    }
+
+    queue_.clear();
+}
+
+void ServerConnection::receive_replies(zeromq::DealerSocket& socket)
+{
+    auto timeout = std::chrono::milliseconds(PIPELINE_POLL_MILLISECONDS);
+    std::string id{};
+    std::string reply{};
+
+    while ((false == in_flight_.empty()) &&
+           socket.ReceiveReply(timeout, id, reply)) {
+        // Drain everything that is already queued before sending more
+        timeout = std::chrono::milliseconds(0);
+        auto it = in_flight_.find(id);
+
+        if (in_flight_.end() == it) {
+            otInfo << OT_METHOD << __FUNCTION__
+                   << ": Discarding reply to expired request " << id
+                   << std::endl;
+
+            continue;
+        }
+
+        status_->On();
+        reset_timer();
+        finish(
+            it->second,
+            SendResult::VALID_REPLY,
+            std::make_shared<std::string>(std::move(reply)));
+        in_flight_.erase(it);
+    }
+}
+
 void ServerConnection::reset_socket(const Lock& lock)
 {
     OT_ASSERT(verify_lock(lock))
@@ -169,104 +367,105 @@ void ServerConnection::reset_timer()
 
 NetworkReplyRaw ServerConnection::Send(const std::string& input)
 {
-    Lock lock(lock_);
-    NetworkReplyRaw output{SendResult::ERROR, nullptr};
-    auto& status = output.first;
-    auto& reply = output.second;
-    reply.reset(new std::string);
+    return SendAsync(input).get();
+}
 
-    OT_ASSERT(reply);
+NetworkReplyString ServerConnection::Send(const String& message)
+{
+    OTASCIIArmor envelope(message);
 
-    auto result =
-        get_socket(lock).SendRequest(network::zeromq::Message::Factory(input));
-    status = result.first;
-    network::zeromq::Message& message = result.second;
+    if (!envelope.Exists()) {
 
-    switch (status) {
-        case SendResult::ERROR: {
-            status_->Off();
-            reset_socket(lock);
-        } break;
-        case SendResult::TIMEOUT: {
-            status_->Off();
-            reset_timer();
-        } break;
-        case SendResult::VALID_REPLY: {
-            status_->On();
-            reset_timer();
-            reply.reset(new std::string(message));
-
-            OT_ASSERT(reply);
-        } break;
-        default: {
-            OT_FAIL;
-        }
+        return decode_string(NetworkReplyRaw{SendResult::ERROR, nullptr});
     }
 
-    return output;
+    return decode_string(Send(std::string(envelope.Get())));
 }
 
-NetworkReplyString ServerConnection::Send(const String& message)
+NetworkReplyMessage ServerConnection::Send(const Message& message)
 {
-    OTASCIIArmor envelope(message);
-    NetworkReplyString output{SendResult::ERROR, nullptr};
-    auto& status = output.first;
-    auto& reply = output.second;
-    reply.reset(new String);
+    return SendAsync(message).get();
+}
 
-    OT_ASSERT(reply);
+std::future<NetworkReplyRaw> ServerConnection::SendAsync(
+    const std::string& input)
+{
+    std::unique_ptr<Request> request(new Request);
 
-    if (!envelope.Exists()) {
-        return output;
-    }
+    OT_ASSERT(request);
 
-    auto rawOutput = Send(std::string(envelope.Get()));
-    status = rawOutput.first;
+    request->message_ = input;
+    auto output = request->promise_.get_future();
+    Lock lock(queue_lock_);
 
-    if (SendResult::VALID_REPLY == status) {
-        OTASCIIArmor armored;
-        armored.Set(rawOutput.second->c_str());
+    if (false == running_.get()) {
+        lock.unlock();
+        finish(request, SendResult::ERROR);
 
-        if (false == armored.GetString(*reply)) {
-            otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
-                  << "but unable to decode it into a String." << std::endl;
-            reply.reset();
-            status = SendResult::INVALID_REPLY;
-        }
+        return output;
     }
 
+    request->id_ = std::to_string(++next_request_);
+    queue_.emplace_back(std::move(request));
+    lock.unlock();
+    queue_signal_.notify_one();
+
     return output;
 }
 
-NetworkReplyMessage ServerConnection::Send(const Message& message)
+std::future<NetworkReplyMessage> ServerConnection::SendAsync(
+    const Message& message)
 {
-    NetworkReplyMessage output{SendResult::ERROR, nullptr};
-    auto& status = output.first;
-    auto& reply = output.second;
-    reply.reset(new Message);
-
-    OT_ASSERT(reply);
-
     String input;
     message.SaveContractRaw(input);
-    auto rawOutput = Send(input);
-    status = rawOutput.first;
+    OTASCIIArmor envelope(input);
 
-    if (SendResult::VALID_REPLY == status) {
-        if (false == reply->LoadContractFromString(*rawOutput.second)) {
-            otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
-                  << "but unable to instantiate it as a Message." << std::endl;
-            reply.reset();
-            status = SendResult::INVALID_REPLY;
-        }
+    if (!envelope.Exists()) {
+        std::promise<NetworkReplyMessage> output{};
+        output.set_value(decode_message(
+            decode_string(NetworkReplyRaw{SendResult::ERROR, nullptr})));
+
+        return output.get_future();
     }
 
-    return output;
+    auto raw = SendAsync(std::string(envelope.Get()));
+
+    // The reply is parsed by whichever thread waits on the future so that
+    // the pipeline thread only moves bytes
+    return std::async(
+        std::launch::deferred, [raw = std::move(raw)]() mutable {
+            return decode_message(decode_string(raw.get()));
+        });
+}
+
+void ServerConnection::send_requests(
+    zeromq::DealerSocket& socket,
+    std::deque<std::unique_ptr<Request>>& requests)
+{
+    for (auto& request : requests) {
+        OT_ASSERT(request);
+
+        if (false == socket.SendRequest(request->id_, request->message_)) {
+            status_->Off();
+            Lock lock(lock_);
+            reset_socket(lock);
+            lock.unlock();
+            finish(request, SendResult::ERROR);
+
+            continue;
+        }
+
+        request->deadline_ =
+            std::chrono::steady_clock::now() + zmq_.ReceiveTimeout();
+        request->message_.clear();
+        const auto id = request->id_;
+        in_flight_.emplace(id, std::move(request));
+    }
 }
 
 void ServerConnection::set_curve(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -277,7 +476,7 @@ void ServerConnection::set_curve(
 
 void ServerConnection::set_proxy(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -297,7 +496,7 @@ void ServerConnection::set_proxy(
 
 void ServerConnection::set_timeouts(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -307,9 +506,9 @@ void ServerConnection::set_timeouts(
     OT_ASSERT(set);
 }
 
-OTZMQRequestSocket ServerConnection::socket(const Lock& lock) const
+OTZMQDealerSocket ServerConnection::socket(const Lock& lock) const
 {
-    auto output = zmq_.Context().RequestSocket();
+    auto output = zmq_.Context().DealerSocket(true);
     set_proxy(lock, output);
     set_timeouts(lock, output);
     set_curve(lock, output);
@@ -342,6 +541,13 @@ void ServerConnection::activity_timer()
 
 ServerConnection::~ServerConnection()
 {
+    running_->Off();
+    queue_signal_.notify_all();
+
+    if (pipeline_thread_) {
+        pipeline_thread_->join();
+    }
+
     if (thread_) {
         thread_->join();
     }
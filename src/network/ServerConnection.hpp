@@ -46,7 +46,13 @@
 #include "opentxs/network/ServerConnection.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <ctime>
+#include <deque>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -63,6 +69,8 @@ public:
     NetworkReplyRaw Send(const std::string& message) override;
     NetworkReplyString Send(const String& message) override;
     NetworkReplyMessage Send(const Message& message) override;
+    std::future<NetworkReplyRaw> SendAsync(const std::string& message) override;
+    std::future<NetworkReplyMessage> SendAsync(const Message& message) override;
     bool Status() const override;
 
     ~ServerConnection();
@@ -70,27 +78,57 @@ public:
 private:
     friend opentxs::network::ServerConnection;
 
+    struct Request {
+        std::string id_{};
+        std::string message_{};
+        std::promise<NetworkReplyRaw> promise_{};
+        std::chrono::steady_clock::time_point deadline_{};
+    };
+
     const api::network::ZMQ& zmq_;
     const std::string server_id_{};
     proto::AddressType address_type_{proto::ADDRESSTYPE_ERROR};
     std::shared_ptr<const ServerContract> remote_contract_{nullptr};
     std::unique_ptr<std::thread> thread_{nullptr};
-    OTZMQRequestSocket socket_;
+    std::unique_ptr<std::thread> pipeline_thread_{nullptr};
+    OTZMQDealerSocket socket_;
     std::atomic<std::time_t> last_activity_{0};
+    OTFlag running_;
     OTFlag socket_ready_;
     OTFlag status_;
     OTFlag use_proxy_;
+    std::mutex queue_lock_;
+    std::condition_variable queue_signal_;
+    std::deque<std::unique_ptr<Request>> queue_;
+    std::uint64_t next_request_{0};
+    // Only accessed by the pipeline thread
+    std::map<std::string, std::unique_ptr<Request>> in_flight_;
+
+    static NetworkReplyMessage decode_message(NetworkReplyString&& input);
+    static NetworkReplyString decode_string(NetworkReplyRaw&& input);
+    static void finish(
+        std::unique_ptr<Request>& request,
+        const SendResult status,
+        std::shared_ptr<std::string> reply = nullptr);
 
     std::string endpoint() const;
-    void set_curve(const Lock& lock, zeromq::RequestSocket& socket) const;
-    void set_proxy(const Lock& lock, zeromq::RequestSocket& socket) const;
-    void set_timeouts(const Lock& lock, zeromq::RequestSocket& socket) const;
-    OTZMQRequestSocket socket(const Lock& lock) const;
+    void set_curve(const Lock& lock, zeromq::DealerSocket& socket) const;
+    void set_proxy(const Lock& lock, zeromq::DealerSocket& socket) const;
+    void set_timeouts(const Lock& lock, zeromq::DealerSocket& socket) const;
+    OTZMQDealerSocket socket(const Lock& lock) const;
 
     void activity_timer();
-    zeromq::RequestSocket& get_socket(const Lock& lock);
+    void expire_requests();
+    void fail_requests();
+    zeromq::DealerSocket& get_socket(const Lock& lock);
+    std::deque<std::unique_ptr<Request>> next_requests();
+    void pipeline();
+    void receive_replies(zeromq::DealerSocket& socket);
     void reset_socket(const Lock& lock);
     void reset_timer();
+    void send_requests(
+        zeromq::DealerSocket& socket,
+        std::deque<std::unique_ptr<Request>>& requests);
 
     ServerConnection(
         const opentxs::api::network::ZMQ& zmq,
@@ -50,6 +50,7 @@ class Context : virtual public zeromq::Context
 public:
     operator void*() const override;
 
+    OTZMQDealerSocket DealerSocket(const bool client) const override;
     OTZMQPairSocket PairSocket(const opentxs::network::zeromq::ListenCallback&
                                    callback) const override;
     OTZMQPairSocket PairSocket(
@@ -69,6 +70,7 @@ public:
     OTZMQPushSocket PushSocket(const bool client) const override;
     OTZMQReplySocket ReplySocket(const ReplyCallback& callback) const override;
     OTZMQRequestSocket RequestSocket() const override;
+    OTZMQRouterSocket RouterSocket() const override;
     OTZMQSubscribeSocket SubscribeSocket(
         const ListenCallback& callback) const override;
 
@@ -0,0 +1,188 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "DealerSocket.hpp"
+
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+
+#include <zmq.h>
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::DealerSocket::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQDealerSocket DealerSocket::Factory(
+    const class Context& context,
+    const bool client)
+{
+    return OTZMQDealerSocket(new implementation::DealerSocket(context, client));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+DealerSocket::DealerSocket(const zeromq::Context& context, const bool client)
+    : ot_super(context, SocketType::Dealer)
+    , CurveClient(lock_, socket_)
+    , client_(client)
+{
+}
+
+DealerSocket* DealerSocket::clone() const
+{
+    return new DealerSocket(context_, client_);
+}
+
+bool DealerSocket::ReceiveReply(
+    const std::chrono::milliseconds& timeout,
+    std::string& id,
+    std::string& reply) const
+{
+    OT_ASSERT(nullptr != socket_);
+
+    Lock lock(lock_);
+    zmq_pollitem_t poll[1];
+    poll[0].socket = socket_;
+    poll[0].events = ZMQ_POLLIN;
+    const auto events = zmq_poll(poll, 1, timeout.count());
+
+    if (0 == events) {
+
+        return false;
+    }
+
+    if (-1 == events) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Poll error: " << zmq_strerror(zmq_errno()) << std::endl;
+
+        return false;
+    }
+
+    // zmq delivers multipart messages atomically, so once the first frame is
+    // readable the rest of the envelope is already queued.
+    std::size_t frames{0};
+    bool delimited{false};
+    bool more{true};
+
+    while (more) {
+        auto frame = Message::Factory();
+        Message& message = frame;
+
+        if (-1 == zmq_msg_recv(message, socket_, ZMQ_DONTWAIT)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Receive error: "
+                  << zmq_strerror(zmq_errno()) << std::endl;
+
+            return false;
+        }
+
+        switch (frames) {
+            case 0: {
+                id = message;
+            } break;
+            case 1: {
+                delimited = (0 == message.size());
+            } break;
+            default: {
+                reply = message;
+            }
+        }
+
+        ++frames;
+        more = (1 == zmq_msg_more(message));
+    }
+
+    if ((3 != frames) || (false == delimited)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Discarding reply with "
+              << frames << " frames." << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool DealerSocket::SendRequest(
+    const std::string& id,
+    const std::string& message) const
+{
+    OT_ASSERT(nullptr != socket_);
+
+    Lock lock(lock_);
+    bool sent = (-1 != zmq_send(socket_, id.data(), id.size(), ZMQ_SNDMORE));
+
+    if (sent) {
+        sent = (-1 != zmq_send(socket_, nullptr, 0, ZMQ_SNDMORE));
+    }
+
+    if (sent) {
+        sent = (-1 != zmq_send(socket_, message.data(), message.size(), 0));
+    }
+
+    if (false == sent) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Send error: "
+              << zmq_strerror(zmq_errno()) << std::endl;
+    }
+
+    return sent;
+}
+
+bool DealerSocket::SetCurve(const ServerContract& contract) const
+{
+    return set_curve(contract);
+}
+
+bool DealerSocket::SetSocksProxy(const std::string& proxy) const
+{
+    return set_socks_proxy(proxy);
+}
+
+bool DealerSocket::Start(const std::string& endpoint) const
+{
+    if (client_) {
+
+        return start_client(endpoint);
+    }
+
+    Lock lock(lock_);
+
+    return bind(endpoint);
+}
+}  // namespace opentxs::network::zeromq::implementation
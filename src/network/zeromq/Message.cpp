@@ -62,6 +62,11 @@ OTZMQMessage Message::Factory(const std::string& input)
 {
     return OTZMQMessage(new implementation::Message(input));
 }
+
+OTZMQMessage Message::Factory(std::string&& input)
+{
+    return OTZMQMessage(new implementation::Message(std::move(input)));
+}
 }  // namespace opentxs::network::zeromq
 
 namespace opentxs::network::zeromq::implementation
@@ -108,6 +113,28 @@ Message::Message(const std::string& input)
     OT_ASSERT(0 == init);
 }
 
+// The string is moved to the heap and released by zeromq once the frame has
+// been sent
+Message::Message(std::string&& input)
+    : message_(new zmq_msg_t)
+{
+    OT_ASSERT(nullptr != message_);
+
+    auto* buffer = new std::string(std::move(input));
+
+    OT_ASSERT(nullptr != buffer);
+
+    const auto init = zmq_msg_init_data(
+        message_, &(*buffer)[0], buffer->size(), &Message::free_string, buffer);
+
+    OT_ASSERT(0 == init);
+}
+
+void Message::free_string(void*, void* hint)
+{
+    delete static_cast<std::string*>(hint);
+}
+
 Message::operator zmq_msg_t*() { return message_; }
 
 Message::operator std::string() const
@@ -62,11 +62,14 @@ private:
 
     zmq_msg_t* message_{nullptr};
 
+    static void free_string(void* data, void* hint);
+
     Message* clone() const override;
 
     Message();
     explicit Message(const Data& input);
     explicit Message(const std::string& input);
+    explicit Message(std::string&& input);
     Message(const Message&) = delete;
     Message(Message&&) = delete;
     Message& operator=(Message&&) = delete;
@@ -85,7 +85,7 @@ Proxy* Proxy::clone() const { return new Proxy(context_, frontend_, backend_); }
 
 void Proxy::proxy() const
 {
-    zmq_proxy_steerable(frontend_, backend_, nullptr, nullptr);
+    zmq_proxy_steerable(frontend_, backend_, nullptr, control_listener_.get());
 }
 
 Proxy::~Proxy()
@@ -76,9 +76,7 @@ Socket::MessageSendResult RequestSocket::SendRequest(opentxs::Data& input) const
 Socket::MessageSendResult RequestSocket::SendRequest(
     const std::string& input) const
 {
-    auto copy = input;
-
-    return SendRequest(Message::Factory(copy));
+    return SendRequest(Message::Factory(input));
 }
 
 Socket::MessageSendResult RequestSocket::SendRequest(
@@ -0,0 +1,81 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "RouterSocket.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <zmq.h>
+
+//#define OT_METHOD "opentxs::network::zeromq::implementation::RouterSocket::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQRouterSocket RouterSocket::Factory(const class Context& context)
+{
+    return OTZMQRouterSocket(new implementation::RouterSocket(context));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+RouterSocket::RouterSocket(const zeromq::Context& context)
+    : ot_super(context, SocketType::Router)
+    , CurveServer(lock_, socket_)
+{
+}
+
+RouterSocket* RouterSocket::clone() const
+{
+    return new RouterSocket(context_);
+}
+
+bool RouterSocket::SetCurve(const OTPassword& key) const
+{
+    return set_curve(key);
+}
+
+bool RouterSocket::Start(const std::string& endpoint) const
+{
+    Lock lock(lock_);
+
+    return bind(endpoint);
+}
+}  // namespace opentxs::network::zeromq::implementation
@@ -79,6 +79,8 @@ const std::map<SocketType, int> Socket::types_{
     {SocketType::Pull, ZMQ_PULL},
     {SocketType::Push, ZMQ_PUSH},
     {SocketType::Pair, ZMQ_PAIR},
+    {SocketType::Router, ZMQ_ROUTER},
+    {SocketType::Dealer, ZMQ_DEALER},
 };
 
 Socket::Socket(const class Context& context, const SocketType type)
@@ -192,6 +192,18 @@ bool ConfigLoader::load(
             static_cast<int32_t>(lValue));
     }
 
+    {
+        const char* szComment = "; worker_threads is the number of client "
+                                "requests the server processes concurrently. "
+                                "Set to 0 to use one thread per core.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "heartbeat", "worker_threads", 0, lValue, bIsNewKey, szComment);
+        ServerSettings::SetWorkerThreads(static_cast<int32_t>(lValue));
+    }
+
     // PERMISSIONS
 
     {
@@ -0,0 +1,464 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/DividendCheckpoint.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <memory>
+#include <sstream>
+
+#define OT_DIVIDEND_BATCH_SIZE 256
+#define OT_DIVIDEND_FOLDER "dividends"
+#define OT_DIVIDEND_INDEX "dividends.idx"
+#define OT_DIVIDEND_PLAN_EXTENSION ".plan"
+#define OT_DIVIDEND_BATCH_SEPARATOR "."
+#define OT_DIVIDEND_LEFTOVER "leftover"
+#define OT_DIVIDEND_PLANNED "planned"
+
+#define OT_METHOD "opentxs::server::DividendCheckpoint::"
+
+namespace opentxs::server
+{
+namespace
+{
+using Map = std::unique_ptr<OTDB::StringMap>;
+
+Map create_map()
+{
+    Map output{dynamic_cast<OTDB::StringMap*>(
+        OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP))};
+
+    OT_ASSERT(output);
+
+    return output;
+}
+
+Map load_index(const std::string& notaryID)
+{
+    if (false ==
+        OTDB::Exists(OTFolders::Receipt().Get(), notaryID, OT_DIVIDEND_INDEX)) {
+
+        return create_map();
+    }
+
+    std::unique_ptr<OTDB::Storable> storable(OTDB::QueryObject(
+        OTDB::STORED_OBJ_STRING_MAP,
+        OTFolders::Receipt().Get(),
+        notaryID,
+        OT_DIVIDEND_INDEX));
+    Map output{dynamic_cast<OTDB::StringMap*>(storable.get())};
+
+    if (output) {
+        storable.release();
+    } else {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load "
+              << OT_DIVIDEND_INDEX << std::endl;
+    }
+
+    return output;
+}
+
+Map load_map(const std::string& notaryID, const std::string& name)
+{
+    std::unique_ptr<OTDB::Storable> storable(OTDB::QueryObject(
+        OTDB::STORED_OBJ_STRING_MAP,
+        OTFolders::Receipt().Get(),
+        notaryID,
+        OT_DIVIDEND_FOLDER,
+        name));
+    Map output{dynamic_cast<OTDB::StringMap*>(storable.get())};
+
+    if (output) {
+        storable.release();
+    } else {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load " << name
+              << std::endl;
+    }
+
+    return output;
+}
+
+bool store_map(
+    OTDB::StringMap& map,
+    const std::string& notaryID,
+    const std::string& name)
+{
+    if (false == OTDB::StoreObject(
+                     map,
+                     OTFolders::Receipt().Get(),
+                     notaryID,
+                     OT_DIVIDEND_FOLDER,
+                     name)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save " << name
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+}  // namespace
+
+DividendCheckpoint::DividendCheckpoint(
+    const Identifier& notaryID,
+    const TransactionNumber number,
+    const Parameters& parameters)
+    : notary_id_(String(notaryID).Get())
+    , number_(number)
+    , parameters_(parameters)
+    , planned_(false)
+    , plan_()
+    , batches_()
+    , leftover_()
+{
+}
+
+std::string DividendCheckpoint::batch_name(const std::size_t index) const
+{
+    return header_name() + OT_DIVIDEND_BATCH_SEPARATOR + std::to_string(index);
+}
+
+bool DividendCheckpoint::decode(const std::string& input, Payment& payment)
+{
+    std::istringstream stream(input);
+    char comma1{0};
+    char comma2{0};
+    char state{0};
+    stream >> payment.amount_ >> comma1 >> payment.number_ >> comma2 >> state;
+
+    if (stream.fail() || (',' != comma1) || (',' != comma2)) {
+
+        return false;
+    }
+
+    payment.state_ = static_cast<State>(state);
+
+    return true;
+}
+
+std::string DividendCheckpoint::encode(const Payment& payment)
+{
+    return std::to_string(payment.amount_) + "," +
+           std::to_string(payment.number_) + "," +
+           static_cast<char>(payment.state_);
+}
+
+bool DividendCheckpoint::erase(const std::string& name) const
+{
+    if (false == exists(name)) {
+
+        return true;
+    }
+
+    return OTDB::EraseValueByKey(
+        OTFolders::Receipt().Get(), notary_id_, OT_DIVIDEND_FOLDER, name);
+}
+
+bool DividendCheckpoint::Erase() const
+{
+    bool output{true};
+
+    // The header goes last, so a checkpoint which was only partly erased is
+    // still found by the next restart
+    for (std::size_t i = 0; i < batches_.size(); ++i) {
+        output &= erase(batch_name(i));
+    }
+
+    output &= erase(plan_name());
+    output &= erase(header_name());
+
+    if (false == output) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to erase checkpoint for payout " << number_
+              << std::endl;
+
+        return false;
+    }
+
+    auto index = load_index(notary_id_);
+
+    if (false == bool(index)) {
+
+        return false;
+    }
+
+    if (0 == index->the_map.erase(std::to_string(number_))) {
+
+        return true;
+    }
+
+    return OTDB::StoreObject(
+        *index, OTFolders::Receipt().Get(), notary_id_, OT_DIVIDEND_INDEX);
+}
+
+bool DividendCheckpoint::Exists() const { return exists(header_name()); }
+
+bool DividendCheckpoint::exists(const std::string& name) const
+{
+    return OTDB::Exists(
+        OTFolders::Receipt().Get(), notary_id_, OT_DIVIDEND_FOLDER, name);
+}
+
+std::string DividendCheckpoint::header_name() const
+{
+    return std::to_string(number_);
+}
+
+bool DividendCheckpoint::Index(const Identifier& sharesUnitID) const
+{
+    auto index = load_index(notary_id_);
+
+    if (false == bool(index)) {
+
+        return false;
+    }
+
+    index->the_map[std::to_string(number_)] = String(sharesUnitID).Get();
+
+    if (false == OTDB::StoreObject(
+                     *index,
+                     OTFolders::Receipt().Get(),
+                     notary_id_,
+                     OT_DIVIDEND_INDEX)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to index payout "
+              << number_ << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+std::map<TransactionNumber, std::string> DividendCheckpoint::List(
+    const Identifier& notaryID)
+{
+    std::map<TransactionNumber, std::string> output{};
+    auto index = load_index(String(notaryID).Get());
+
+    if (false == bool(index)) {
+
+        return output;
+    }
+
+    for (const auto& it : index->the_map) {
+        output.emplace(String::StringToLong(it.first), it.second);
+    }
+
+    return output;
+}
+
+bool DividendCheckpoint::Load()
+{
+    if (false == LoadHeader()) {
+
+        return false;
+    }
+
+    if (false == planned_) {
+
+        return true;
+    }
+
+    auto plan = load_map(notary_id_, plan_name());
+
+    if (false == bool(plan)) {
+
+        return false;
+    }
+
+    for (const auto& it : plan->the_map) {
+        Payment payment{};
+        payment.amount_ = String::StringToLong(it.second);
+        plan_.emplace(it.first, payment);
+    }
+
+    make_batches();
+
+    for (std::size_t i = 0; i < batches_.size(); ++i) {
+        const auto name = batch_name(i);
+
+        // A batch without a file has not been started
+        if (false == exists(name)) {
+
+            continue;
+        }
+
+        auto batch = load_map(notary_id_, name);
+
+        if (false == bool(batch)) {
+
+            return false;
+        }
+
+        for (const auto& it : batch->the_map) {
+            auto payment = plan_.find(it.first);
+
+            if ((plan_.end() == payment) ||
+                (false == decode(it.second, payment->second))) {
+                otErr << OT_METHOD << __FUNCTION__ << ": Invalid entry "
+                      << it.first << " in batch " << i << " of payout "
+                      << number_ << std::endl;
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool DividendCheckpoint::LoadHeader()
+{
+    if (false == Exists()) {
+
+        return false;
+    }
+
+    auto header = load_map(notary_id_, header_name());
+
+    if (false == bool(header)) {
+
+        return false;
+    }
+
+    parameters_.clear();
+    plan_.clear();
+    batches_.clear();
+    leftover_ = Payment{};
+    planned_ = false;
+
+    for (const auto& it : header->the_map) {
+        const auto& key = it.first;
+
+        if (OT_DIVIDEND_PLANNED == key) {
+            planned_ = true;
+        } else if (OT_DIVIDEND_LEFTOVER == key) {
+            if (false == decode(it.second, leftover_)) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Invalid leftover in checkpoint for payout "
+                      << number_ << std::endl;
+
+                return false;
+            }
+        } else {
+            parameters_.emplace(key, it.second);
+        }
+    }
+
+    return true;
+}
+
+void DividendCheckpoint::make_batches()
+{
+    batches_.clear();
+
+    for (auto& it : plan_) {
+        if (batches_.empty() ||
+            (OT_DIVIDEND_BATCH_SIZE <= batches_.back().size())) {
+            batches_.emplace_back();
+            batches_.back().reserve(OT_DIVIDEND_BATCH_SIZE);
+        }
+
+        batches_.back().emplace_back(&it);
+    }
+}
+
+std::string DividendCheckpoint::plan_name() const
+{
+    return header_name() + OT_DIVIDEND_PLAN_EXTENSION;
+}
+
+bool DividendCheckpoint::SaveBatch(const std::size_t index) const
+{
+    OT_ASSERT(index < batches_.size());
+
+    auto batch = create_map();
+
+    for (const auto* it : batches_.at(index)) {
+        batch->the_map[it->first] = encode(it->second);
+    }
+
+    return store_map(*batch, notary_id_, batch_name(index));
+}
+
+bool DividendCheckpoint::SaveHeader() const
+{
+    auto header = create_map();
+    auto& map = header->the_map;
+    map = parameters_;
+
+    if (planned_) {
+        map[OT_DIVIDEND_PLANNED] = "1";
+    }
+
+    if (State::Planned != leftover_.state_) {
+        map[OT_DIVIDEND_LEFTOVER] = encode(leftover_);
+    }
+
+    return store_map(*header, notary_id_, header_name());
+}
+
+bool DividendCheckpoint::SavePlan()
+{
+    auto plan = create_map();
+
+    for (const auto& it : plan_) {
+        plan->the_map[it.first] = std::to_string(it.second.amount_);
+    }
+
+    // The plan is saved before the header marks it as planned, so a restart
+    // in between plans again
+    if (false == store_map(*plan, notary_id_, plan_name())) {
+
+        return false;
+    }
+
+    make_batches();
+    planned_ = true;
+
+    return SaveHeader();
+}
+}  // namespace opentxs::server
@@ -0,0 +1,764 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/DividendPayout.hpp"
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/consensus/ClientContext.hpp"
+#include "opentxs/core/contract/UnitDefinition.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/Parallel.hpp"
+#include "opentxs/core/Account.hpp"
+#include "opentxs/core/Cheque.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/ext/OTPayment.hpp"
+#include "opentxs/server/Server.hpp"
+#include "opentxs/server/Transactor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#define OT_DIVIDEND_ACCOUNTS_PER_THREAD 64
+#define OT_DIVIDEND_LOAD_CHUNK 4096
+#define OT_DIVIDEND_PROGRESS_STEPS 4
+#define OT_DIVIDEND_PAYER "payer"
+#define OT_DIVIDEND_SHARES "shares"
+#define OT_DIVIDEND_PAYOUT "payout"
+#define OT_DIVIDEND_VOUCHER_ACCOUNT "voucher_account"
+#define OT_DIVIDEND_MEMO "memo"
+#define OT_DIVIDEND_PER_SHARE "per_share"
+#define OT_DIVIDEND_TOTAL_COST "total_cost"
+
+#define OT_METHOD "opentxs::server::DividendPayout::"
+
+namespace opentxs::server
+{
+// Every voucher is drawn on the voucher account and issued by the server nym.
+class DividendPayout::ServerServices : public DividendPayout::Services
+{
+public:
+    const Identifier& NotaryID() const override
+    {
+        return server_.m_strNotaryID;
+    }
+
+    // The server nym owns the voucher account, so it must hold the number on
+    // every voucher in order to verify it when the voucher is deposited.
+    bool IssueNumber(TransactionNumber& number) const override
+    {
+        const auto& serverNym = server_.m_nymServer;
+        auto context = server_.wallet_.mutable_ClientContext(
+            serverNym.ID(), serverNym.ID());
+
+        return server_.transactor_.issueNextTransactionNumberToNym(
+            context.It(), number);
+    }
+
+    void Notify(const Identifier& nymID, const std::string& text)
+        const override
+    {
+        const String message(text.c_str());
+        const bool sent = server_.DropMessageToNymbox(
+            server_.m_strNotaryID,
+            server_.m_nymServer.ID(),
+            nymID,
+            OTTransaction::message,
+            nullptr,
+            &message);
+
+        if (false == sent) {
+            otErr << OT_METHOD << "ServerServices::" << __FUNCTION__
+                  << ": Failed to notify nym " << String(nymID) << std::endl;
+        }
+    }
+
+    bool Pay(
+        const Identifier& recipient,
+        const Identifier& unitID,
+        const Identifier& voucherAccountID,
+        const String& memo,
+        const std::int64_t amount,
+        const TransactionNumber number) const override
+    {
+        const auto& serverNym = server_.m_nymServer;
+        const Identifier serverNymID(serverNym);
+        const time64_t validFrom = OTTimeGetCurrentTime();
+        const time64_t validTo = OTTimeAddTimeInterval(
+            validFrom,
+            OTTimeGetSecondsFromTime(OT_TIME_SIX_MONTHS_IN_SECONDS));
+        Cheque voucher(server_.m_strNotaryID, unitID);
+        const bool issued = voucher.IssueCheque(
+            amount,
+            number,
+            validFrom,
+            validTo,
+            voucherAccountID,
+            serverNymID,
+            memo,
+            &recipient);
+
+        if (false == issued) {
+
+            return false;
+        }
+
+        voucher.SetAsVoucher(serverNymID, voucherAccountID);
+        voucher.SignContract(serverNym);
+        voucher.SaveContract();
+        const String serialized(voucher);
+        OTPayment instrument(serialized);
+
+        return server_.SendInstrumentToNym(
+            server_.m_strNotaryID,
+            serverNymID,
+            recipient,
+            &instrument,
+            "payDividend");
+    }
+
+    std::shared_ptr<const UnitDefinition> Unit(
+        const Identifier& unitID) const override
+    {
+        return server_.wallet_.UnitDefinition(unitID);
+    }
+
+    explicit ServerServices(Server& server)
+        : server_(server)
+    {
+    }
+
+    ~ServerServices() = default;
+
+private:
+    Server& server_;
+};
+
+DividendPayout::DividendPayout(
+    Server& server,
+    const Identifier& notaryID,
+    const Identifier& payerNymID,
+    const Identifier& sharesUnitID,
+    const Identifier& payoutUnitID,
+    const Identifier& voucherAccountID,
+    const String& memo,
+    const std::int64_t payoutPerShare,
+    const std::int64_t totalCost,
+    const TransactionNumber payoutNumber)
+    : server_services_(new ServerServices(server))
+    , services_(*server_services_)
+    , notary_id_(notaryID)
+    , payer_nym_id_(payerNymID)
+    , shares_unit_id_(sharesUnitID)
+    , payout_unit_id_(payoutUnitID)
+    , voucher_account_id_(voucherAccountID)
+    , memo_(memo)
+    , payout_per_share_(payoutPerShare)
+    , total_cost_(totalCost)
+    , payout_number_(payoutNumber)
+    , checkpoint_(
+          notaryID,
+          payoutNumber,
+          parameters(
+              payerNymID,
+              sharesUnitID,
+              payoutUnitID,
+              voucherAccountID,
+              memo,
+              payoutPerShare,
+              totalCost))
+    , reported_(0)
+{
+    OT_ASSERT(server_services_);
+}
+
+DividendPayout::DividendPayout(
+    const Services& services,
+    const Identifier& payerNymID,
+    const Identifier& sharesUnitID,
+    const Identifier& payoutUnitID,
+    const Identifier& voucherAccountID,
+    const String& memo,
+    const std::int64_t payoutPerShare,
+    const std::int64_t totalCost,
+    const TransactionNumber payoutNumber)
+    : server_services_(nullptr)
+    , services_(services)
+    , notary_id_(services.NotaryID())
+    , payer_nym_id_(payerNymID)
+    , shares_unit_id_(sharesUnitID)
+    , payout_unit_id_(payoutUnitID)
+    , voucher_account_id_(voucherAccountID)
+    , memo_(memo)
+    , payout_per_share_(payoutPerShare)
+    , total_cost_(totalCost)
+    , payout_number_(payoutNumber)
+    , checkpoint_(
+          notary_id_,
+          payoutNumber,
+          parameters(
+              payerNymID,
+              sharesUnitID,
+              payoutUnitID,
+              voucherAccountID,
+              memo,
+              payoutPerShare,
+              totalCost))
+    , reported_(0)
+{
+}
+
+std::int64_t DividendPayout::amount(const State state) const
+{
+    std::int64_t output{0};
+
+    for (const auto& it : checkpoint_.Payments()) {
+        const auto& payment = it.second;
+
+        if (state == payment.state_) {
+            output += payment.amount_;
+        }
+    }
+
+    return output;
+}
+
+std::int64_t DividendPayout::AmountLeftOver() const
+{
+    const auto& leftover = checkpoint_.Leftover();
+
+    if (State::Returned != leftover.state_) {
+
+        return 0;
+    }
+
+    return leftover.amount_;
+}
+
+std::int64_t DividendPayout::AmountPaidOut() const
+{
+    return amount(State::Paid);
+}
+
+std::int64_t DividendPayout::AmountReturned() const
+{
+    return amount(State::Returned);
+}
+
+bool DividendPayout::issue_numbers(const std::vector<Payment*>& payments) const
+{
+    for (auto* payment : payments) {
+        OT_ASSERT(nullptr != payment);
+
+        if (0 != payment->number_) {
+
+            continue;
+        }
+
+        TransactionNumber number{0};
+
+        if (false == services_.IssueNumber(number)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed issuing a voucher number for payout "
+                  << payout_number_ << std::endl;
+
+            return false;
+        }
+
+        payment->number_ = number;
+    }
+
+    return true;
+}
+
+bool DividendPayout::make_plan(
+    const UnitDefinition& shares,
+    mapOfAccounts* loadedAccounts)
+{
+    auto& plan = checkpoint_.Payments();
+    std::vector<std::string> accounts{};
+    std::size_t count{0};
+    std::atomic<std::size_t> failed{0};
+    auto load = [&]() -> void {
+        std::vector<std::string> owners(accounts.size());
+        std::vector<std::int64_t> balances(accounts.size(), 0);
+
+        // Only reads the loaded accounts, so the workers can share them.
+        auto read = [&](const std::size_t i) -> void {
+            const Identifier accountID(accounts[i]);
+            const Account* account{nullptr};
+            std::unique_ptr<Account> angel{nullptr};
+
+            if (nullptr != loadedAccounts) {
+                const auto it = loadedAccounts->find(accounts[i]);
+
+                if ((loadedAccounts->end() != it) && (nullptr != it->second) &&
+                    (accountID == it->second->GetPurportedAccountID())) {
+                    account = it->second;
+                }
+            }
+
+            if (nullptr == account) {
+                angel.reset(
+                    Account::LoadExistingAccount(accountID, notary_id_));
+                account = angel.get();
+            }
+
+            if (nullptr == account) {
+                otErr << OT_METHOD << "make_plan: Failed loading account "
+                      << accounts[i] << std::endl;
+                ++failed;
+
+                return;
+            }
+
+            owners[i] = String(account->GetNymID()).Get();
+            balances[i] = account->GetBalance();
+        };
+
+        Parallel(accounts.size(), OT_DIVIDEND_ACCOUNTS_PER_THREAD, read);
+
+        for (std::size_t i = 0; i < accounts.size(); ++i) {
+            // The issuer account has a negative balance, and empty accounts
+            // are owed nothing.
+            if (0 >= balances[i]) {
+
+                continue;
+            }
+
+            plan[owners[i]].amount_ += balances[i] * payout_per_share_;
+        }
+
+        count += accounts.size();
+        accounts.clear();
+    };
+
+    plan.clear();
+
+    // The balance in the registry is only a hint, so every account is loaded.
+    shares.VisitAccountRecords(
+        [&](const std::string& accountID, const std::int64_t) -> bool {
+            accounts.emplace_back(accountID);
+
+            if (OT_DIVIDEND_LOAD_CHUNK <= accounts.size()) {
+                load();
+            }
+
+            return true;
+        });
+    load();
+
+    otWarn << OT_METHOD << __FUNCTION__ << ": Payout " << payout_number_
+           << " will pay " << plan.size() << " owners of " << count
+           << " accounts." << std::endl;
+
+    return (0 == failed.load());
+}
+
+void DividendPayout::notify_payer(const std::string& text) const
+{
+    services_.Notify(payer_nym_id_, text);
+}
+
+// A voucher which is sent again after a restart reuses its number, so at most
+// one copy of it can ever be deposited.
+bool DividendPayout::pay(const Identifier& recipient, const Payment& payment)
+    const
+{
+    const bool paid = services_.Pay(
+        recipient,
+        payout_unit_id_,
+        voucher_account_id_,
+        memo_,
+        payment.amount_,
+        payment.number_);
+
+    if (false == paid) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed paying "
+              << payment.amount_ << " of " << String(payout_unit_id_)
+              << " to nym " << String(recipient) << std::endl;
+    }
+
+    return paid;
+}
+
+bool DividendPayout::pay_shareholders(const Progress& progress)
+{
+    const auto& batches = checkpoint_.Batches();
+    const auto total = checkpoint_.Payments().size();
+    std::size_t done{0};
+    bool output{true};
+
+    for (std::size_t index = 0; index < batches.size(); ++index) {
+        const auto& batch = batches[index];
+        std::vector<DividendCheckpoint::Plan::value_type*> unpaid{};
+        std::vector<Payment*> payments{};
+
+        // Pending payments may have been delivered before a restart. Sending
+        // them again is harmless, since they keep the same number.
+        for (auto* it : batch) {
+            const auto state = it->second.state_;
+
+            if ((State::Planned == state) || (State::Pending == state)) {
+                unpaid.emplace_back(it);
+                payments.emplace_back(&it->second);
+            }
+        }
+
+        if (false == unpaid.empty()) {
+            if (false == issue_numbers(payments)) {
+
+                return false;
+            }
+
+            for (auto* payment : payments) {
+                payment->state_ = State::Pending;
+            }
+
+            if (false == checkpoint_.SaveBatch(index)) {
+
+                return false;
+            }
+
+            // Every voucher is signed by the server nym, so they are issued
+            // one at a time
+            for (auto* it : unpaid) {
+                auto& payment = it->second;
+
+                if (pay(Identifier(it->first), payment)) {
+                    payment.state_ = State::Paid;
+                } else {
+                    payment.state_ = State::Undelivered;
+                    output = false;
+                }
+            }
+
+            if (false == checkpoint_.SaveBatch(index)) {
+
+                return false;
+            }
+        }
+
+        done += batch.size();
+
+        if (progress) {
+            progress(done, total);
+        }
+
+        report_progress(done, total);
+    }
+
+    return output;
+}
+
+DividendCheckpoint::Parameters DividendPayout::parameters(
+    const Identifier& payerNymID,
+    const Identifier& sharesUnitID,
+    const Identifier& payoutUnitID,
+    const Identifier& voucherAccountID,
+    const String& memo,
+    const std::int64_t payoutPerShare,
+    const std::int64_t totalCost)
+{
+    DividendCheckpoint::Parameters output{};
+    output[OT_DIVIDEND_PAYER] = String(payerNymID).Get();
+    output[OT_DIVIDEND_SHARES] = String(sharesUnitID).Get();
+    output[OT_DIVIDEND_PAYOUT] = String(payoutUnitID).Get();
+    output[OT_DIVIDEND_VOUCHER_ACCOUNT] = String(voucherAccountID).Get();
+    output[OT_DIVIDEND_MEMO] = memo.Get();
+    output[OT_DIVIDEND_PER_SHARE] = std::to_string(payoutPerShare);
+    output[OT_DIVIDEND_TOTAL_COST] = std::to_string(totalCost);
+
+    return output;
+}
+
+// Tells the payer each time another quarter of the shareholders has been
+// handled. The end of the payout is reported separately, with the totals.
+void DividendPayout::report_progress(
+    const std::size_t done,
+    const std::size_t total)
+{
+    if (0 == total) {
+
+        return;
+    }
+
+    const std::size_t step = (done * OT_DIVIDEND_PROGRESS_STEPS) / total;
+
+    if ((step <= reported_) || (OT_DIVIDEND_PROGRESS_STEPS <= step)) {
+
+        return;
+    }
+
+    reported_ = step;
+    notify_payer(
+        "Dividend payout " + std::to_string(payout_number_) + ": paid " +
+        std::to_string(done) + " of " + std::to_string(total) +
+        " shareholders.");
+}
+
+void DividendPayout::Resume(Server& server)
+{
+    const ServerServices services(server);
+    Resume(services);
+}
+
+void DividendPayout::Resume(const Services& services)
+{
+    const auto& notaryID = services.NotaryID();
+
+    for (const auto& it : DividendCheckpoint::List(notaryID)) {
+        const auto number = it.first;
+        DividendCheckpoint header(notaryID, number);
+
+        if (false == header.Exists()) {
+            // The payout failed before its checkpoint was written, so nothing
+            // was sent.
+            header.Erase();
+
+            continue;
+        }
+
+        if (false == header.LoadHeader()) {
+
+            continue;
+        }
+
+        const auto& map = header.Params();
+        auto field = [&map](const char* key) -> String {
+            const auto found = map.find(key);
+
+            if (map.end() == found) {
+
+                return String();
+            }
+
+            return String(found->second);
+        };
+        DividendPayout payout(
+            services,
+            Identifier(field(OT_DIVIDEND_PAYER)),
+            Identifier(field(OT_DIVIDEND_SHARES)),
+            Identifier(field(OT_DIVIDEND_PAYOUT)),
+            Identifier(field(OT_DIVIDEND_VOUCHER_ACCOUNT)),
+            field(OT_DIVIDEND_MEMO),
+            field(OT_DIVIDEND_PER_SHARE).ToLong(),
+            field(OT_DIVIDEND_TOTAL_COST).ToLong(),
+            number);
+
+        if (false == payout.checkpoint_.Load()) {
+
+            continue;
+        }
+
+        Log::vOutput(
+            0,
+            "%s%s: Resuming dividend payout %" PRId64 ".\n",
+            OT_METHOD,
+            __FUNCTION__,
+            number);
+        auto shares = services.Unit(payout.shares_unit_id_);
+        payout.run(shares.get(), nullptr, [number](
+                                              const std::size_t done,
+                                              const std::size_t total) {
+            otWarn << OT_METHOD << "Resume: Payout " << number << ": paid "
+                   << done << " of " << total << " shareholders." << std::endl;
+        });
+    }
+}
+
+bool DividendPayout::return_funds()
+{
+    const auto& payer = payer_nym_id_;
+    auto& leftover = checkpoint_.Leftover();
+    bool output{true};
+
+    // Once the leftover is known, every undelivered payment is already
+    // included in it.
+    if (State::Planned == leftover.state_) {
+        const auto& batches = checkpoint_.Batches();
+
+        for (std::size_t index = 0; index < batches.size(); ++index) {
+            bool changed{false};
+
+            for (auto* it : batches[index]) {
+                auto& payment = it->second;
+
+                if (State::Undelivered != payment.state_) {
+
+                    continue;
+                }
+
+                if (pay(payer, payment)) {
+                    payment.state_ = State::Returned;
+                    changed = true;
+                } else {
+                    output = false;
+                }
+            }
+
+            if (changed && (false == checkpoint_.SaveBatch(index))) {
+
+                return false;
+            }
+        }
+
+        leftover.amount_ = total_cost_ - (AmountPaidOut() + AmountReturned());
+
+        if (0 < leftover.amount_) {
+            if (false == issue_numbers({&leftover})) {
+
+                return false;
+            }
+
+            leftover.state_ = State::Pending;
+        } else {
+            leftover.state_ = State::Returned;
+        }
+
+        if (false == checkpoint_.SaveHeader()) {
+
+            return false;
+        }
+    }
+
+    if (State::Pending == leftover.state_) {
+        Log::vOutput(
+            0,
+            "%s%s: After dividend payout %" PRId64 ", with %" PRId64
+            " units removed initially, there were %" PRId64
+            " units remaining. (Returning them to sender...)\n",
+            OT_METHOD,
+            __FUNCTION__,
+            payout_number_,
+            total_cost_,
+            leftover.amount_);
+
+        if (false == pay(payer, leftover)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed returning leftover funds of " << leftover.amount_
+                  << " to nym " << String(payer) << std::endl;
+
+            return false;
+        }
+
+        leftover.state_ = State::Returned;
+
+        if (false == checkpoint_.SaveHeader()) {
+
+            return false;
+        }
+    }
+
+    return output;
+}
+
+bool DividendPayout::Run(
+    const UnitDefinition& shares,
+    mapOfAccounts* loadedAccounts,
+    const Progress& progress)
+{
+    // The parameters are recorded before the index entry, so a payout found
+    // in the index can always be resumed.
+    if (false == checkpoint_.SaveHeader()) {
+
+        return false;
+    }
+
+    if (false == checkpoint_.Index(shares_unit_id_)) {
+
+        return false;
+    }
+
+    return run(&shares, loadedAccounts, progress);
+}
+
+bool DividendPayout::run(
+    const UnitDefinition* shares,
+    mapOfAccounts* loadedAccounts,
+    const Progress& progress)
+{
+    bool output{true};
+
+    if (false == checkpoint_.Planned()) {
+        if (nullptr == shares) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Missing share unit definition for payout "
+                  << payout_number_ << std::endl;
+
+            return false;
+        }
+
+        output &= make_plan(*shares, loadedAccounts);
+
+        if (false == checkpoint_.SavePlan()) {
+
+            return false;
+        }
+    }
+
+    if (false == pay_shareholders(progress)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Some vouchers for payout "
+              << payout_number_ << " were not delivered." << std::endl;
+        output = false;
+    }
+
+    // Funds which could not be accounted for stay in the checkpoint so the
+    // next restart can try again.
+    if (false == return_funds()) {
+
+        return false;
+    }
+
+    notify_payer(
+        "Dividend payout " + std::to_string(payout_number_) +
+        " is finished. Paid out " + std::to_string(AmountPaidOut()) +
+        ", returned " + std::to_string(AmountReturned()) +
+        " which could not be delivered and " +
+        std::to_string(AmountLeftOver()) + " left over.");
+    checkpoint_.Erase();
+
+    return output;
+}
+}  // namespace opentxs::server
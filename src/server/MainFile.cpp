@@ -94,7 +94,7 @@ bool MainFile::SaveMainFileToString(String& strMainFile)
     tag.add_attribute("notaryID", String(server_.m_strNotaryID).Get());
     tag.add_attribute("serverNymID", server_.m_strServerNymID.Get());
     tag.add_attribute(
-        "transactionNum", formatLong(server_.transactor_.transactionNumber()));
+        "transactionNum", formatLong(server_.transactor_.reservedNumber()));
 
     if (cachedKey.IsGenerated())  // If it exists, then serialize it.
     {
@@ -370,8 +370,8 @@ bool MainFile::LoadMainFile(bool bReadOnly)
 
                         String strTransactionNumber;  // The server issues
                                                       // transaction numbers and
-                                                      // stores the counter here
-                                                      // for the latest one.
+                                                      // stores the highest
+                                                      // reserved one here.
                         strTransactionNumber =
                             xml->getAttributeValue("transactionNum");
                         server_.transactor_.transactionNumber(
@@ -381,7 +381,7 @@ bool MainFile::LoadMainFile(bool bReadOnly)
                             0,
                             "\nLoading Open Transactions server. File version: "
                             "%s\n"
-                            " Last Issued Transaction Number: %" PRId64
+                            " Reserved Transaction Numbers: %" PRId64
                             "\n Notary ID:     "
                             " %s\n Server Nym ID: %s\n",
                             version_.c_str(),
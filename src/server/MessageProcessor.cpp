@@ -43,26 +43,58 @@
 #include "opentxs/api/network/ZMQ.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/Proxy.hpp"
 #include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/server/Server.hpp"
+#include "opentxs/server/ServerSettings.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <algorithm>
+#include <functional>
 #include <ostream>
+#include <shared_mutex>
 #include <string>
 
+#define CRON_MAX_WAIT_MILLISECONDS 1000
+#define WORKER_ENDPOINT_PREFIX "inproc://opentxs/notary/worker/"
+
 #define OT_METHOD "opentxs::MessageProcessor::"
 
 namespace opentxs::server
 {
+// These commands only read shared server state or modify the sending nym's own
+// context and boxes, so they are safe to process concurrently with each other.
+// Anything not listed here may deliver to another user's boxes, modify the
+// markets or issue new contracts and therefore runs exclusively.
+const std::set<MessageType> MessageProcessor::parallel_commands_{
+    MessageType::pingNotary,
+    MessageType::registerNym,
+    MessageType::getRequestNumber,
+    MessageType::getTransactionNumbers,
+    MessageType::checkNym,
+    MessageType::getNymbox,
+    MessageType::getBoxReceipt,
+    MessageType::getAccountData,
+    MessageType::queryInstrumentDefinitions,
+    MessageType::getInstrumentDefinition,
+    MessageType::getMint,
+    MessageType::getMarketList,
+    MessageType::getMarketOffers,
+    MessageType::getMarketRecentTrades,
+    MessageType::getNymMarketOffers,
+};
 
 MessageProcessor::MessageProcessor(
     Server& server,
@@ -75,7 +107,15 @@ MessageProcessor::MessageProcessor(
           [this](const network::zeromq::Message& incoming) -> OTZMQMessage {
               return this->processSocket(incoming);
           }))
-    , reply_socket_(context.ReplySocket(reply_socket_callback_.get()))
+    , frontend_(context.RouterSocket())
+    , backend_(context.DealerSocket(true))
+    , worker_endpoint_(
+          std::string(WORKER_ENDPOINT_PREFIX) + Identifier::Random().str() +
+          "/")
+    , workers_()
+    , proxy_(nullptr)
+    , stripes_()
+    , cron_wakeup_()
     , thread_(nullptr)
 {
 }
@@ -86,6 +126,9 @@ void MessageProcessor::cleanup()
         thread_->join();
         thread_.reset();
     }
+
+    proxy_.reset();
+    workers_.clear();
 }
 
 void MessageProcessor::init(const int port, const OTPassword& privkey)
@@ -94,58 +137,118 @@ void MessageProcessor::init(const int port, const OTPassword& privkey)
         OT_FAIL;
     }
 
-    const auto set = reply_socket_->SetCurve(privkey);
+    const auto set = frontend_->SetCurve(privkey);
 
     OT_ASSERT(set);
 
     const auto endpoint = std::string("tcp://*:") + std::to_string(port);
-    const auto bound = reply_socket_->Start(endpoint);
+    const auto bound = frontend_->Start(endpoint);
 
     OT_ASSERT(bound);
+
+    std::size_t threads = std::max(0, ServerSettings::GetWorkerThreads());
+
+    if (0 == threads) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(threads);
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        const auto workerEndpoint = worker_endpoint_ + std::to_string(i);
+        workers_.emplace_back(
+            context_.ReplySocket(reply_socket_callback_.get()));
+        auto& worker = workers_.back();
+        const auto started = worker->Start(workerEndpoint);
+
+        OT_ASSERT(started);
+
+        const auto connected = backend_->Start(workerEndpoint);
+
+        OT_ASSERT(connected);
+    }
+
+    proxy_.reset(new OTZMQProxy(context_.Proxy(frontend_.get(), backend_.get())));
+
+    OT_ASSERT(proxy_);
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Processing requests with "
+          << threads << " worker threads." << std::endl;
+}
+
+std::vector<Lock> MessageProcessor::lock_stripes(const Message& request) const
+{
+    std::vector<std::size_t> indices{stripe(request.m_strNymID)};
+
+    if (request.m_strAcctID.Exists()) {
+        indices.emplace_back(stripe(request.m_strAcctID));
+    }
+
+    // Always acquire stripes in ascending order to avoid deadlocks
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    std::vector<Lock> output{};
+
+    for (const auto& index : indices) {
+        output.emplace_back(stripes_.at(index));
+    }
+
+    return output;
 }
 
 void MessageProcessor::run()
 {
     while (running_) {
-        // timeout is the time left until the next cron should execute.
+        // Held from computing the timeout until the wait begins, so a wakeup
+        // sent in between is not lost
+        Lock lock(lock_);
+        // timeout is the time left until the next cron item is due.
         const auto timeout = server_.computeTimeout();
 
         if (timeout <= 0) {
-            // ProcessCron and processSocket must not run simultaneously
-            Lock lock(lock_);
+            lock.unlock();
+            // Cron items move funds between accounts that are only known
+            // once each item runs, and requests add and remove cron items,
+            // so cron can not take a narrower lock than the requests which
+            // also run exclusively.
+            eLock exclusive(shared_lock_);
             server_.ProcessCron();
+
+            continue;
         }
 
-        Log::Sleep(std::chrono::milliseconds(50));
+        // The wait is bounded so that shutdown is noticed promptly
+        const auto wait = std::chrono::milliseconds(
+            std::min<std::int64_t>(timeout, CRON_MAX_WAIT_MILLISECONDS));
+        cron_wakeup_.wait_for(lock, wait);
     }
 }
 
 OTZMQMessage MessageProcessor::processSocket(
     const network::zeromq::Message& incoming)
 {
-    // ProcessCron and processSocket must not run simultaneously
-    Lock lock(lock_);
     std::string reply{};
-    bool error = processMessage(std::string(incoming), reply);
+    bool error = processMessage(incoming, reply);
 
     if (error) {
         reply = "";
     }
 
-    return network::zeromq::Message::Factory(reply);
+    return network::zeromq::Message::Factory(std::move(reply));
 }
 
 bool MessageProcessor::processMessage(
-    const std::string& messageString,
+    const network::zeromq::Message& incoming,
     std::string& reply)
 {
-    if (messageString.size() < 1) {
+    if (incoming.size() < 1) {
 
         return true;
     }
 
+    // Parse directly from the received frame
     OTASCIIArmor armored;
-    armored.MemSet(messageString.data(), messageString.size());
+    armored.MemSet(static_cast<const char*>(incoming.data()), incoming.size());
     String serialized;
     armored.GetString(serialized);
     Message request;
@@ -165,8 +268,7 @@ bool MessageProcessor::processMessage(
     }
 
     Message repy{};
-    const bool processed =
-        server_.userCommandProcessor_.ProcessUserCommand(request, repy);
+    const bool processed = process_command(request, repy);
 
     if (false == processed) {
         otWarn << OT_METHOD << __FUNCTION__
@@ -188,7 +290,9 @@ bool MessageProcessor::processMessage(
         return true;
     }
 
-    OTASCIIArmor armoredReply(serializedReply);
+    // Replies are compressed for the wire, not for storage
+    OTASCIIArmor armoredReply;
+    armoredReply.SetString(serializedReply, true, ArmorCompression::Fast);
 
     if (false == armoredReply.Exists()) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to armor reply."
@@ -202,6 +306,27 @@ bool MessageProcessor::processMessage(
     return false;
 }
 
+bool MessageProcessor::process_command(const Message& request, Message& reply)
+{
+    const auto type = Message::Type(request.m_strCommand.Get());
+
+    if (parallel_commands_.count(type)) {
+        sLock shared(shared_lock_);
+        const auto stripes = lock_stripes(request);
+
+        return server_.userCommandProcessor_.ProcessUserCommand(request, reply);
+    }
+
+    eLock exclusive(shared_lock_);
+    const auto output =
+        server_.userCommandProcessor_.ProcessUserCommand(request, reply);
+    exclusive.unlock();
+    Lock lock(lock_);
+    cron_wakeup_.notify_one();
+
+    return output;
+}
+
 void MessageProcessor::Start()
 {
     if (false == bool(thread_)) {
@@ -209,5 +334,10 @@ void MessageProcessor::Start()
     }
 }
 
+std::size_t MessageProcessor::stripe(const String& id) const
+{
+    return std::hash<std::string>{}(id.Get()) % stripes_.size();
+}
+
 MessageProcessor::~MessageProcessor() {}
 }  // namespace opentxs::server
@@ -73,9 +73,9 @@
 #include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/OTPayment.hpp"
+#include "opentxs/server/DividendPayout.hpp"
 #include "opentxs/server/Macros.hpp"
 #include "opentxs/server/Server.hpp"
-#include "opentxs/server/PayDividendVisitor.hpp"
 #include "opentxs/server/ServerSettings.hpp"
 #include "opentxs/server/Transactor.hpp"
 
@@ -83,10 +83,12 @@
 #include <cstdint>
 #include <deque>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #define OT_METHOD "opentxs::Notary::"
 
@@ -96,6 +98,143 @@ namespace opentxs::server
 typedef std::list<Account*> listOfAccounts;
 #if OT_CASH
 typedef std::deque<Token*> dequeOfTokenPtrs;
+
+namespace
+{
+// Lucre signatures are made per mint series, so the tokens of each series
+// can be signed in parallel. Tokens which can not be signed are left false,
+// and NotarizeWithdrawal reports the reason when it reaches them.
+std::vector<bool> sign_tokens(
+    const opentxs::api::Server& mint,
+    const Nym& theNotary,
+    const Identifier& unitID,
+    const std::vector<Token*>& tokens,
+    std::vector<String>& signatures)
+{
+    std::vector<bool> output(tokens.size(), false);
+    std::map<std::int32_t, std::vector<std::size_t>> series{};
+    signatures.assign(tokens.size(), String());
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const auto& pToken = tokens[i];
+
+        if (pToken->GetInstrumentDefinitionID() != unitID) {
+
+            continue;
+        }
+
+        series[pToken->GetSeries()].push_back(i);
+    }
+
+    for (const auto& it : series) {
+        const auto& indices = it.second;
+        auto pMint = mint.GetPrivateMint(unitID, it.first);
+
+        if (false == bool(pMint)) {
+
+            continue;
+        }
+
+        if (nullptr == pMint->GetCashReserveAccount()) {
+
+            continue;
+        }
+
+        if (pMint->Expired()) {
+
+            continue;
+        }
+
+        std::vector<Token*> batch{};
+        std::vector<String> batchSignatures{};
+
+        for (const auto& index : indices) {
+            batch.push_back(tokens[index]);
+        }
+
+        const auto results =
+            pMint->SignTokens(theNotary, batch, batchSignatures, 0);
+
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            output[indices[i]] = results[i];
+            signatures[indices[i]] = batchSignatures[i];
+        }
+    }
+
+    return output;
+}
+
+// Verifies the Lucre coins of a deposit, one mint series at a time. Tokens
+// without spendable data, or for another unit or notary, are left false and
+// NotarizeDeposit reports the reason when it reaches them.
+std::vector<bool> verify_tokens(
+    const opentxs::api::Server& mint,
+    const Nym& theNotary,
+    const Identifier& notaryID,
+    const Identifier& unitID,
+    const std::vector<std::unique_ptr<Token>>& tokens,
+    const std::vector<String>& spendable)
+{
+    OT_ASSERT(tokens.size() == spendable.size())
+
+    std::vector<bool> output(tokens.size(), false);
+    std::map<std::int32_t, std::vector<std::size_t>> series{};
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const auto& pToken = tokens[i];
+
+        if (false == spendable[i].Exists()) {
+
+            continue;
+        }
+
+        if (pToken->GetInstrumentDefinitionID() != unitID) {
+
+            continue;
+        }
+
+        if (pToken->GetNotaryID() != notaryID) {
+
+            continue;
+        }
+
+        series[pToken->GetSeries()].push_back(i);
+    }
+
+    for (const auto& it : series) {
+        const auto& indices = it.second;
+        auto pMint = mint.GetPrivateMint(unitID, it.first);
+
+        if (false == bool(pMint)) {
+
+            continue;
+        }
+
+        // Spent records of an expired series may already have been deleted
+        if (OTTimeGetCurrentTime() > pMint->GetValidTo()) {
+
+            continue;
+        }
+
+        std::vector<String> batch{};
+        std::vector<std::int64_t> denominations{};
+
+        for (const auto& index : indices) {
+            batch.push_back(spendable[index]);
+            denominations.push_back(tokens[index]->GetDenomination());
+        }
+
+        const auto results =
+            pMint->VerifyTokens(theNotary, batch, denominations);
+
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            output[indices[i]] = results[i];
+        }
+    }
+
+    return output;
+}
+}  // namespace
 #endif  // OT_CASH
 
 Notary::Notary(
@@ -1168,11 +1307,29 @@ void Notary::NotarizeWithdrawal(
 
                 // Pull the token(s) out of the purse that was received from the
                 // client.
+                std::vector<Token*> tokens{};
+
                 while ((pToken = thePurse.Pop(server_.m_nymServer)) !=
                        nullptr) {
                     // We are responsible to cleanup pToken
                     // So I grab a copy here for later...
                     theDeque.push_front(pToken);
+                    tokens.push_back(pToken);
+                }
+
+                // Signing is the slow part, so every token is signed up front
+                // across several threads. The loop below checks each token
+                // and applies its signature.
+                std::vector<String> signatures{};
+                const auto signedTokens = sign_tokens(
+                    mint_,
+                    server_.m_nymServer,
+                    INSTRUMENT_DEFINITION_ID,
+                    tokens,
+                    signatures);
+
+                for (std::size_t index = 0; index < tokens.size(); ++index) {
+                    pToken = tokens[index];
 
                     pMint = mint_.GetPrivateMint(
                         INSTRUMENT_DEFINITION_ID, pToken->GetSeries());
@@ -1214,8 +1371,6 @@ void Notary::NotarizeWithdrawal(
                         bSuccess = false;
                         break;  // Once there's a failure, we ditch the loop.
                     } else {
-                        String theStringReturnVal;
-
                         if (pToken->GetInstrumentDefinitionID() !=
                             INSTRUMENT_DEFINITION_ID) {
                             const String str1(
@@ -1235,26 +1390,20 @@ void Notary::NotarizeWithdrawal(
                         // TokenIndex is for cash systems that send multiple
                         // proto-tokens, so the Mint
                         // knows which proto-token has been chosen for signing.
-                        // But Lucre only uses a single proto-token, so the
-                        // token index is always 0.
+                        // But Lucre only uses a single proto-token, so
+                        // sign_tokens always uses token index 0.
                         //
-                        else if (!(pMint->SignToken(
-                                     server_.m_nymServer,
-                                     *pToken,
-                                     theStringReturnVal,
-                                     0)))  // nTokenIndex = 0 //
-                        // ******************************************
-                        {
+                        else if (!signedTokens[index]) {
                             bSuccess = false;
                             Log::vError(
                                 "%s: Failure in call: "
-                                "pMint->SignToken(server_.m_nymServer, "
-                                "*pToken, theStringReturnVal, 0). "
+                                "pMint->SignTokens(server_.m_nymServer, "
+                                "tokens, signatures, 0). "
                                 "(Returning.)\n",
                                 __FUNCTION__);
                             break;
                         } else {
-                            OTASCIIArmor theArmorReturnVal(theStringReturnVal);
+                            OTASCIIArmor theArmorReturnVal(signatures[index]);
 
                             pToken->ReleaseSignatures();  // this releases the
                                                           // normal signatures,
@@ -1962,13 +2111,16 @@ void Notary::NotarizePayDividend(
                                 //
                                 // PAY THE SHAREHOLDERS
                                 //
-                                // Here's where we actually loop through the
-                                // asset accounts for the share type,
-                                // and send a voucher to the owner of each one.
+                                // The payout loads the share accounts and
+                                // sends one voucher, drawn on
+                                // VOUCHER_ACCOUNT_ID, to each owner Nym. (In
+                                // the amount of lAmountPerShare * number of
+                                // shares owned.) Anything which can't be
+                                // delivered, and anything left over, is
+                                // returned to the payer.
                                 //
-                                // This way, the actionPayDividend won't
-                                // possibly load these accounts twice.
-                                // We make them available here this way.
+                                // The accounts already loaded here are passed
+                                // in, so the payout won't load them twice.
                                 //
                                 mapOfAccounts theAccounts;
                                 theAccounts.insert(
@@ -1983,74 +2135,40 @@ void Notary::NotarizePayDividend(
                                         strVoucherAcctID.Get(),
                                         &theVoucherReserveAcct));
 
-                                PayDividendVisitor actionPayDividend(
+                                const TransactionNumber lPayoutNumber =
+                                    tranIn.GetTransactionNum();
+                                DividendPayout thePayout(
+                                    server_,
                                     NOTARY_ID,
                                     NYM_ID,
+                                    SHARES_INSTRUMENT_DEFINITION_ID,
                                     PAYOUT_INSTRUMENT_DEFINITION_ID,
                                     VOUCHER_ACCOUNT_ID,
                                     strInReferenceTo,  // Memo for each voucher
                                                        // (containing original
                                                        // payout request pItem)
-                                    server_,
                                     lAmountPerShare,
-                                    &theAccounts);
-
-                                // Loops through all the accounts for a given
-                                // instrument definition
-                                // (PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                // and triggers
-                                // actionPayDividend for each one. This sends
-                                // the owner nym for each, a voucher drawn on
-                                // VOUCHER_ACCOUNT_ID. (In the amount of
-                                // lAmountPerShare * number of shares in
-                                // account.)
-                                //
-                                const bool bForEachAcct =
-                                    pSharesContract->VisitAccountRecords(
-                                        actionPayDividend);  // <================
-                                                             // pay all the
-                                                             // dividends here.
-
-                                // TODO: Since the above line of code loops
-                                // through all the accounts and loads them
-                                // up, transforms them, and saves them again, we
-                                // cannot use our own loaded accounts below
-                                // this point. (They could overwrite
-                                // themselves.) theSourceAccount especially, was
-                                // passed in
-                                // from above -- so how can we possible warn the
-                                // caller than he cannot save this account
-                                // without
-                                // overwriting work we have done in this
-                                // function?
-                                //
-                                // Aside from any more elegant solution, the
-                                // only way to make it work in this case would
-                                // be to
-                                // make a map or list of all the accounts that
-                                // are already loaded in memory (such as
-                                // theSourceAccount)
-                                // and PASS THEM IN to the above
-                                // VisitAccountRecords call. This way it would
-                                // have the option to use
-                                // the "already loaded" versions, where
-                                // appropriate, instead of loading them twice.
-                                // (As it is,
-                                // theSourceAccount is not used below this
-                                // point, though we couldn't preven the caller
-                                // from using it.)
-                                //
-                                // Therefore we need to have some central system
-                                // where accounts can be loaded, locked, saved,
-                                // etc.
-                                // So we cannot ever overwrite ourselves BY
-                                // DESIGN. (And the same for other data types as
-                                // well, like Nyms.)
-                                // Todo.
-                                //
-                                if (!bForEachAcct)  // todo failsafe. Handle
-                                                    // this
-                                                    // better.
+                                    lTotalCostOfDividend,
+                                    lPayoutNumber);
+
+                                const bool bPaid = thePayout.Run(
+                                    *pSharesContract,
+                                    &theAccounts,
+                                    [&](const std::size_t done,
+                                        const std::size_t total) {
+                                        Log::Record(
+                                            1,
+                                            "dividend_progress",
+                                            {{"nym", strNymID.Get()},
+                                             {"payout",
+                                              std::to_string(lPayoutNumber)},
+                                             {"paid", std::to_string(done)},
+                                             {"total",
+                                              std::to_string(total)}});
+                                    });
+
+                                if (!bPaid)  // todo failsafe. Handle this
+                                             // better.
                                 {
                                     Log::vError(
                                         "%s: ERROR: After moving funds for "
@@ -2059,208 +2177,21 @@ void Notary::NotarizePayDividend(
                                         "to the payout recipients.\n",
                                         szFunc);
                                 }
-                                //
-                                // REFUND ANY LEFTOVERS
-                                //
-                                const int64_t lLeftovers =
-                                    lTotalCostOfDividend -
-                                    (actionPayDividend.GetAmountPaidOut() +
-                                     actionPayDividend.GetAmountReturned());
-                                if (lLeftovers > 0) {
-                                    // Of the total amount removed from the
-                                    // sender's account, and after paying all
-                                    // dividends,
-                                    // there was a leftover amount that wasn't
-                                    // paid to anybody. Therefore, we should pay
-                                    // it back
-                                    // to the sender himself, now.
-                                    //
-                                    Log::vOutput(
-                                        0,
-                                        "%s: After dividend payout, with "
-                                        "%" PRId64 " units removed initially, "
-                                        "there were %" PRId64
-                                        " units remaining. "
-                                        "(Returning them to sender...)\n",
-                                        szFunc,
-                                        lTotalCostOfDividend,
-                                        lLeftovers);
-                                    Cheque theVoucher(
-                                        NOTARY_ID,
-                                        PAYOUT_INSTRUMENT_DEFINITION_ID);
-
-                                    // 10 minutes ==    600 Seconds
-                                    // 1 hour    ==     3600 Seconds
-                                    // 1 day    ==    86400 Seconds
-                                    // 30 days    ==  2592000 Seconds
-                                    // 3 months ==  7776000 Seconds
-                                    // 6 months == 15552000 Seconds
-
-                                    const time64_t VALID_FROM =
-                                        OTTimeGetCurrentTime();  // This time is
-                                                                 // set to TODAY
-                                                                 // NOW
-                                    const time64_t VALID_TO =
-                                        OTTimeAddTimeInterval(
-                                            VALID_FROM,
-                                            OTTimeGetSecondsFromTime(
-                                                OT_TIME_SIX_MONTHS_IN_SECONDS));  // This time occurs in 180 days (6 months).  Todo hardcoding.
 
-                                    int64_t lNewTransactionNumber = 0;
-                                    const bool bGotNextTransNum =
-                                        server_.transactor_
-                                            .issueNextTransactionNumberToNym(
-                                                context, lNewTransactionNumber);
-                                    // We save the
-                                    // transaction
-                                    // number on the server Nym (normally we'd
-                                    // discard it) because
-                                    // when the cheque is deposited, the server
-                                    // nym, as the owner of
-                                    // the voucher account, needs to verify the
-                                    // transaction # on the
-                                    // cheque (to prevent double-spending of
-                                    // cheques.)
-                                    if (bGotNextTransNum) {
-                                        const Identifier NOTARY_NYM_ID(
-                                            server_.m_nymServer);
-                                        const bool bIssueVoucher =
-                                            theVoucher.IssueCheque(
-                                                lLeftovers,  // The amount of
-                                                             // the
-                                                             // cheque.
-                                                lNewTransactionNumber,  // Requiring
-                                                                        // a
-                                                // transaction
-                                                // number
-                                                // prevents
-                                                // double-spending
-                                                // of
-                                                // cheques.
-                                                VALID_FROM,  // The expiration
-                                                             // date
-                                                // (valid from/to dates)
-                                                // of the cheque
-                                                VALID_TO,  // Vouchers are
-                                                // automatically starting
-                                                // today and lasting 6
-                                                // months.
-                                                VOUCHER_ACCOUNT_ID,  // The
-                                                                     // asset
-                                                // account the
-                                                // cheque is
-                                                // drawn on.
-                                                NOTARY_NYM_ID,  // Nym ID of the
-                                                // sender (in this
-                                                // case the server
-                                                // nym.)
-                                                strInReferenceTo,  // Optional
-                                                                   // memo
-                                                // field. Includes
-                                                // item note and
-                                                // request memo.
-                                                &NYM_ID);
-
-                                        // All account crediting / debiting
-                                        // happens in the caller, in Server.
-                                        //    (AND it happens only ONCE, to
-                                        // cover ALL vouchers.)
-                                        // Then in here, the voucher either gets
-                                        // send to the recipient, or if error,
-                                        // sent back home to
-                                        // the issuer Nym. (ALL the funds are
-                                        // removed, then the vouchers are sent
-                                        // one way or the other.)
-                                        // Any returned vouchers, obviously
-                                        // serve to notify the dividend payer of
-                                        // where the errors were
-                                        // (as well as give him the opportunity
-                                        // to get his money back.)
-                                        //
-                                        bool bSent = false;
-                                        if (bIssueVoucher) {
-                                            theVoucher.SetAsVoucher(
-                                                NOTARY_NYM_ID,
-                                                VOUCHER_ACCOUNT_ID);  // All
-                                                                      // this
-                                                                      // does is
-                                                                      // set the
-                                            // voucher's
-                                            // internal
-                                            // contract
-                                            // string
-                                            theVoucher.SignContract(
-                                                server_.m_nymServer);  // to
-                                            // "VOUCHER"
-                                            // instead of
-                                            // "CHEQUE".
-                                            theVoucher.SaveContract();
-
-                                            // Send the voucher to the payments
-                                            // inbox of the recipient.
-                                            //
-                                            const String strVoucher(theVoucher);
-                                            OTPayment thePayment(strVoucher);
-
-                                            // calls DropMessageToNymbox
-                                            bSent = server_.SendInstrumentToNym(
-                                                NOTARY_ID,
-                                                NOTARY_NYM_ID,  // sender
-                                                                // nym
-                                                NYM_ID,         // recipient nym
-                                                                // (returning to
-                                                // original sender.)
-                                                &thePayment,
-                                                "payDividend");  // todo:
-                                            // hardcoding.
-                                        }
-                                        // If we didn't send it, then we need to
-                                        // return the funds to where they came
-                                        // from.
-                                        //
-                                        if (!bSent) {
-                                            const String
-                                                strPayoutInstrumentDefinitionID(
-                                                    PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                                strSenderNymID(NYM_ID);
-                                            Log::vError(
-                                                "%s: ERROR failed issuing "
-                                                "voucher (to return leftovers "
-                                                "back to "
-                                                "the dividend payout "
-                                                "initiator.) WAS TRYING TO PAY "
-                                                "%" PRId64 " of instrument "
-                                                "definition %s to "
-                                                "Nym "
-                                                "%s.\n",
-                                                szFunc,
-                                                lLeftovers,
-                                                strPayoutInstrumentDefinitionID
-                                                    .Get(),
-                                                strSenderNymID.Get());
-                                        }   // if !bSent
-                                    } else  // !bGotNextTransNum
-                                    {
-                                        const String
-                                            strPayoutInstrumentDefinitionID(
-                                                PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                            strRecipientNymID(NYM_ID);
-                                        Log::vError(
-                                            "%s: ERROR!! Failed issuing next "
-                                            "transaction "
-                                            "number while trying to send a "
-                                            "voucher (while returning leftover "
-                                            "funds, after paying dividends.) "
-                                            "WAS TRYING TO PAY %" PRId64
-                                            " of asset "
-                                            "type %s to Nym %s.\n",
-                                            szFunc,
-                                            lLeftovers,
-                                            strPayoutInstrumentDefinitionID
-                                                .Get(),
-                                            strRecipientNymID.Get());
-                                    }
-                                }
+                                Log::Record(
+                                    0,
+                                    "dividend_paid",
+                                    {{"nym", strNymID.Get()},
+                                     {"payout", std::to_string(lPayoutNumber)},
+                                     {"paid",
+                                      std::to_string(
+                                          thePayout.AmountPaidOut())},
+                                     {"returned",
+                                      std::to_string(
+                                          thePayout.AmountReturned())},
+                                     {"leftover",
+                                      std::to_string(
+                                          thePayout.AmountLeftOver())}});
                             }  // else
                         }
                         // else{} // TODO log that there was a problem with the
@@ -3944,6 +3875,9 @@ void Notary::NotarizeDeposit(
 
                 // Pull the token(s) out of the purse that was received from the
                 // client.
+                std::vector<std::unique_ptr<Token>> tokens{};
+                std::vector<String> spendable{};
+
                 while (true) {
                     std::unique_ptr<Token> pToken(
                         thePurse.Pop(server_.m_nymServer));
@@ -3951,19 +3885,58 @@ void Notary::NotarizeDeposit(
                         break;
                     }
 
+                    String strSpendableToken;
+
+                    // An empty string means the spendable token data could
+                    // not be retrieved. That is reported in the loop below.
+                    if (!pToken->GetSpendableString(
+                            server_.m_nymServer, strSpendableToken)) {
+                        strSpendableToken.Release();
+                    }
+
+                    tokens.push_back(std::move(pToken));
+                    spendable.push_back(strSpendableToken);
+                }
+
+                // Verifying the Lucre coins is the slow part, so every token
+                // is verified up front across several threads. The loop below
+                // checks the results in order.
+                const auto verifiedTokens = verify_tokens(
+                    mint_,
+                    server_.m_nymServer,
+                    NOTARY_ID,
+                    INSTRUMENT_DEFINITION_ID,
+                    tokens,
+                    spendable);
+
+                for (std::size_t index = 0; index < tokens.size(); ++index) {
+                    auto& pToken = tokens[index];
+
                     pMint = mint_.GetPrivateMint(
                         INSTRUMENT_DEFINITION_ID, pToken->GetSeries());
 
                     if (false == bool(pMint)) {
                         Log::Error("Notary::NotarizeDeposit: Unable to get "
                                    "or load Mint.\n");
+                        bSuccess = false;
+                        break;
+                    } else if (OTTimeGetCurrentTime() > pMint->GetValidTo()) {
+                        // The spent token records of a series are deleted
+                        // once it is past valid-to, so its tokens must never
+                        // be accepted again.
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Series %d has "
+                            "expired. \n",
+                            pToken->GetSeries());
+                        bSuccess = false;
                         break;
                     } else if (
                         (pMintCashReserveAcct =
                              pMint->GetCashReserveAccount()) != nullptr) {
-                        String strSpendableToken;
-                        bool bToken = pToken->GetSpendableString(
-                            server_.m_nymServer, strSpendableToken);
+                        String& strSpendableToken = spendable[index];
+                        const bool bToken = strSpendableToken.Exists();
 
                         if (!bToken)  // if failure getting the spendable token
                                       // data from the token object
@@ -4011,10 +3984,7 @@ void Notary::NotarizeDeposit(
                         // finally verified in Lucre
                         // using the appropriate Mint private key.)
                         //
-                        else if (!(pMint->VerifyToken(
-                                     server_.m_nymServer,
-                                     strSpendableToken,
-                                     pToken->GetDenomination()))) {
+                        else if (!verifiedTokens[index]) {
                             bSuccess = false;
                             Log::vOutput(
                                 0,
@@ -84,12 +84,9 @@ ReplyMessage::ReplyMessage(
     init_ = init();
 }
 
-std::set<RequestNumber> ReplyMessage::Acknowledged() const
+const IntervalSet& ReplyMessage::Acknowledged() const
 {
-    std::set<RequestNumber> output{};
-    original_.m_AcknowledgedReplies.Output(output);
-
-    return output;
+    return original_.m_AcknowledgedReplies.Numbers();
 }
 
 void ReplyMessage::attach_request()
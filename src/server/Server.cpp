@@ -53,6 +53,9 @@
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTCachedKey.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
+#if OT_SCRIPT_CHAI
+#include "opentxs/core/script/OTScriptChai.hpp"
+#endif
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/OTDataFolder.hpp"
 #include "opentxs/core/util/OTPaths.hpp"
@@ -66,6 +69,7 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/OTPayment.hpp"
 #include "opentxs/server/ConfigLoader.hpp"
+#include "opentxs/server/DividendPayout.hpp"
 #include "opentxs/server/Transactor.hpp"
 
 #ifndef WIN32
@@ -86,6 +90,7 @@
 #define SERVER_CONFIG_BIND_KEY "bindip"
 #define SERVER_CONFIG_COMMAND_KEY "command"
 #define SERVER_CONFIG_NOTIFY_KEY "notification"
+#define SERVER_SCRIPT_ENGINES 2
 
 #define OT_METHOD "opentxs::Server::"
 
@@ -607,6 +612,16 @@ void Server::Init(bool readOnly)
         }
     }
 
+    // Finish any dividend payouts which were interrupted by a shutdown.
+    if (false == readOnly) {
+        DividendPayout::Resume(*this);
+    }
+
+#if OT_SCRIPT_CHAI
+    // Smart contract hooks run from cron, so have engines ready for them.
+    OTScriptChai::Preload(SERVER_SCRIPT_ENGINES);
+#endif
+
     auto password = crypto_.Encode().Nonce(16);
     String notUsed;
     bool ignored;
@@ -632,7 +647,7 @@ bool Server::SendInstrumentToNym(
     const OTPayment* pPayment,
     const char* szCommand)
 {
-    OT_ASSERT(nullptr == pPayment);
+    OT_ASSERT(nullptr != pPayment);
     OT_ASSERT(pPayment->IsValid());
     // If a payment was passed in (for us to use it to construct pMsg, which is
     // nullptr in the case where payment isn't nullptr)
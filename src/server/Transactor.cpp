@@ -59,11 +59,16 @@
 #include <string>
 #include <utility>
 
+// Numbers reserved in the main file per write. At most this many numbers are
+// skipped if the server stops without issuing the whole block.
+#define OT_TRANSACTION_NUMBER_BLOCK 1000
+
 namespace opentxs::server
 {
 
 Transactor::Transactor(Server* server)
     : transactionNumber_(0)
+    , reservedNumber_(0)
     , server_(server)
 {
 }
@@ -81,22 +86,24 @@ Transactor::~Transactor() {}
 bool Transactor::issueNextTransactionNumber(
     TransactionNumber& lTransactionNumber)
 {
-    // transactionNumber_ stores the last VALID AND ISSUED transaction number.
-    // So first, we increment that, since we don't want to issue the same number
-    // twice.
-    transactionNumber_++;
+    Lock lock(lock_);
 
-    // Next, we save it to file.
-    if (!server_->mainFile_.SaveMainFile()) {
-        Log::Error("Error saving main server file.\n");
-        transactionNumber_--;
-        return false;
+    // Numbers are served from memory until the reserved block is exhausted.
+    // Only then is the main file rewritten, with a new ceiling.
+    if (transactionNumber_ >= reservedNumber_) {
+        if (!reserve_numbers(lock)) {
+            Log::Error("Error saving main server file.\n");
+
+            return false;
+        }
     }
 
-    // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
+    // transactionNumber_ stores the last VALID AND ISSUED transaction number.
+    // So we increment that, since we don't want to issue the same number
+    // twice.
+    transactionNumber_++;
     lTransactionNumber = transactionNumber_;
+
     return true;
 }
 
@@ -115,20 +122,38 @@ bool Transactor::issueNextTransactionNumberToNym(
     // it is recorded in his Nym file before being sent to the client (where it
     // is also recorded in his Nym file.)  That way the server always knows
     // which numbers are valid for each Nym.
-    if (!context.IssueNumber(transactionNumber_)) {
+    if (!context.IssueNumber(lTransactionNumber)) {
         Log::Error("Error adding transaction number to Nym file.\n");
-        transactionNumber_--;
-        // Save it back how it was, since we're not issuing this number after
-        // all.
-        server_->mainFile_.SaveMainFile();
+        Lock lock(lock_);
+
+        // Put it back, since we're not issuing this number after all. If
+        // another request has been issued a number in the meantime then this
+        // one is simply skipped. The reservation in the main file still covers
+        // it, so nothing needs to be saved.
+        if (transactionNumber_ == lTransactionNumber) {
+            transactionNumber_--;
+        }
 
         return false;
     }
 
-    // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
-    lTransactionNumber = transactionNumber_;
+    return true;
+}
+
+// Durably raises the ceiling before any number beneath it is handed out, so a
+// number is never reissued after a crash.
+bool Transactor::reserve_numbers(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    const auto previous = reservedNumber_;
+    reservedNumber_ = transactionNumber_ + OT_TRANSACTION_NUMBER_BLOCK;
+
+    if (!server_->mainFile_.SaveMainFile()) {
+        reservedNumber_ = previous;
+
+        return false;
+    }
 
     return true;
 }
@@ -297,16 +297,16 @@ void UserCommandProcessor::check_acknowledgements(ReplyMessage& reply) const
 
     // The server reads the list of acknowledged replies from the incoming
     // client message... If we add any acknowledged replies to the server-side
-    // list, we will want to save (at the end.)
-    auto numlist_ack_reply = reply.Acknowledged();
+    // list, we will want to save (at the end.) The list is walked range by
+    // range rather than copied into a std::set.
+    const auto& acknowledged = reply.Acknowledged();
     const auto nymID = context.RemoteNym().ID();
     Ledger nymbox(nymID, nymID, NOTARY_ID);
 
     if (nymbox.LoadNymbox() && nymbox.VerifySignature(server_.m_nymServer)) {
         bool bIsDirtyNymbox = false;
 
-        for (auto& it : numlist_ack_reply) {
-            const std::int64_t lRequestNum = it;
+        for (const auto& lRequestNum : acknowledged) {
             // If the # already appears on its internal list, then it does
             // nothing. (It must have already done
             // whatever it needed to do, since it already has the number
@@ -356,7 +356,7 @@ void UserCommandProcessor::check_acknowledgements(ReplyMessage& reply) const
         }
     }
 
-    context.FinishAcknowledgements(numlist_ack_reply);
+    context.FinishAcknowledgements(acknowledged);
     reply.SetAcknowledgments(context);
 }
 
@@ -0,0 +1,117 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/storage/ObjectCache.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+namespace opentxs::storage
+{
+ObjectCache::ObjectCache(const std::size_t limit)
+    : limit_(limit)
+    , lock_()
+    , lru_()
+    , index_()
+    , size_(0)
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+void ObjectCache::add(
+    const Key& key,
+    const Object& object,
+    const std::size_t size) const
+{
+    if (size > limit_) {
+
+        return;
+    }
+
+    Lock lock(lock_);
+    auto it = index_.find(key);
+
+    if (index_.end() != it) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+
+        return;
+    }
+
+    lru_.emplace_front(key, object, size);
+    index_.emplace(key, lru_.begin());
+    size_ += size;
+    trim(lock);
+}
+
+ObjectCache::Object ObjectCache::get(const Key& key) const
+{
+    Lock lock(lock_);
+    auto it = index_.find(key);
+
+    if (index_.end() == it) {
+        lock.unlock();
+        ++misses_;
+
+        return {};
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    auto output = std::get<1>(*it->second);
+    lock.unlock();
+    ++hits_;
+
+    return output;
+}
+
+void ObjectCache::trim(const Lock& lock) const
+{
+    OT_ASSERT(lock.mutex() == &lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    while (size_ > limit_) {
+        OT_ASSERT(false == lru_.empty());
+
+        const auto& entry = lru_.back();
+        size_ -= std::get<2>(entry);
+        index_.erase(std::get<0>(entry));
+        lru_.pop_back();
+    }
+}
+}  // namespace opentxs::storage
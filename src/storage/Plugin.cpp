@@ -117,7 +117,7 @@ bool Plugin::Migrate(
     const bool targetBucket{current_bucket_};
     auto sourceBucket = targetBucket;
 
-    if (&to == this) {
+    if (&to.Target() == this) {
         sourceBucket = !targetBucket;
     }
 
@@ -168,9 +168,9 @@ void Plugin::Store(
     const bool bucket,
     std::promise<bool>& promise) const
 {
-    std::thread thread(
-        &Plugin::store, this, isTransaction, key, value, bucket, &promise);
-    thread.detach();
+    // Concurrency is provided by the caller (see StorageWriteQueue) rather
+    // than by starting a thread for every object
+    store(isTransaction, key, value, bucket, &promise);
 }
 
 bool Plugin::Store(
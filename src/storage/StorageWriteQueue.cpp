@@ -0,0 +1,173 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/storage/StorageWriteQueue.hpp"
+
+#include "opentxs/api/storage/Plugin.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include <algorithm>
+
+#define OT_METHOD "opentxs::StorageWriteQueue::"
+
+namespace opentxs
+{
+StorageWriteQueue::StorageWriteQueue(
+    const std::size_t threads,
+    const std::size_t capacity)
+    : capacity_(std::max(std::size_t(1), capacity))
+    , lock_()
+    , has_work_()
+    , has_space_()
+    , queue_()
+    , index_()
+    , running_(true)
+    , threads_()
+{
+    const auto count = std::max(std::size_t(1), threads);
+    threads_.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        threads_.emplace_back(&StorageWriteQueue::worker, this);
+    }
+}
+
+void StorageWriteQueue::Push(
+    const api::storage::Plugin& plugin,
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>& promise)
+{
+    const JobKey id{&plugin, isTransaction, bucket, key};
+    Lock lock(lock_);
+    auto it = index_.find(id);
+
+    if (index_.end() != it) {
+        auto& job = *it->second;
+        job.value_ = value;
+        job.promises_.emplace_back(&promise);
+
+        return;
+    }
+
+    has_space_.wait(lock, [this]() -> bool {
+        return (false == running_) || (queue_.size() < capacity_);
+    });
+
+    if (false == running_) {
+        lock.unlock();
+        otErr << OT_METHOD << __FUNCTION__ << ": Shutting down." << std::endl;
+        promise.set_value(false);
+
+        return;
+    }
+
+    // The queue may have been modified while this thread was waiting
+    it = index_.find(id);
+
+    if (index_.end() != it) {
+        auto& job = *it->second;
+        job.value_ = value;
+        job.promises_.emplace_back(&promise);
+
+        return;
+    }
+
+    queue_.push_back(Job{&plugin, isTransaction, key, value, bucket, {}});
+    auto job = std::prev(queue_.end());
+    job->promises_.emplace_back(&promise);
+    index_.emplace(id, job);
+    lock.unlock();
+    has_work_.notify_one();
+}
+
+void StorageWriteQueue::worker()
+{
+    Lock lock(lock_);
+
+    while (true) {
+        has_work_.wait(lock, [this]() -> bool {
+            return (false == running_) || (false == queue_.empty());
+        });
+
+        if (queue_.empty()) {
+
+            return;
+        }
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        index_.erase(
+            JobKey{job.plugin_, job.transaction_, job.bucket_, job.key_});
+        lock.unlock();
+        has_space_.notify_one();
+
+        OT_ASSERT(nullptr != job.plugin_);
+
+        const bool output = job.plugin_->Store(
+            job.transaction_, job.key_, job.value_, job.bucket_);
+
+        for (auto& promise : job.promises_) {
+            OT_ASSERT(nullptr != promise);
+
+            promise->set_value(output);
+        }
+
+        lock.lock();
+    }
+}
+
+StorageWriteQueue::~StorageWriteQueue()
+{
+    Lock lock(lock_);
+    running_ = false;
+    lock.unlock();
+    has_work_.notify_all();
+    has_space_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+}  // namespace opentxs
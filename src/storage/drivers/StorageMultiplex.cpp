@@ -40,6 +40,7 @@
 #include "opentxs/storage/drivers/StorageMultiplex.hpp"
 
 #include "opentxs/api/storage/Plugin.hpp"
+#include "opentxs/api/storage/Storage.hpp"
 #if OT_STORAGE_FS
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
@@ -79,10 +80,23 @@ StorageMultiplex::StorageMultiplex(
     , backup_plugins_()
     , digest_(hash)
     , random_(random)
+    , write_queue_(config.write_threads_, config.write_queue_size_)
+    , cache_(config.object_cache_size_)
+    , batch_lock_()
+    , flush_lock_()
+    , batch_active_(false)
+    , pending_()
+    , flushing_()
 {
     Init_StorageMultiplex(primary, migrate, previous);
 }
 
+void StorageMultiplex::BeginBatch() const
+{
+    Lock lock(batch_lock_);
+    batch_active_ = true;
+}
+
 std::string StorageMultiplex::best_root(bool& primaryOutOfSync)
 {
     OT_ASSERT(primary_plugin_);
@@ -157,6 +171,56 @@ bool StorageMultiplex::EmptyBucket(const bool bucket) const
     return primary_plugin_->EmptyBucket(bucket);
 }
 
+void StorageMultiplex::EndBatch() const
+{
+    Lock lock(batch_lock_);
+    batch_active_ = false;
+    lock.unlock();
+    flush();
+}
+
+// Writes each pending index node once, to the current bucket. Only one flush
+// runs at a time, so a root is never stored before the nodes of an earlier
+// flush are written. The nodes stay visible to loads while they are written,
+// but batch_lock_ is not held during the writes. Nodes which could not be
+// written stay pending so that a later flush can retry them.
+bool StorageMultiplex::flush() const
+{
+    Lock flushLock(flush_lock_);
+    Lock lock(batch_lock_);
+
+    OT_ASSERT(flushing_.empty());
+
+    flushing_.swap(pending_);
+    lock.unlock();
+    const bool bucket{primary_bucket_};
+    std::vector<std::string> failed{};
+
+    for (const auto& it : flushing_) {
+        const auto& key = it.first;
+        const auto& value = it.second.second;
+
+        if (false == Store(true, key, value, bucket)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to write node "
+                  << key << std::endl;
+            failed.push_back(key);
+        }
+    }
+
+    lock.lock();
+
+    for (const auto& key : failed) {
+        const auto& node = flushing_.at(key);
+        auto& retry = pending_[key];
+        retry.first += node.first;
+        retry.second = node.second;
+    }
+
+    flushing_.clear();
+
+    return failed.empty();
+}
+
 void StorageMultiplex::init(
     const std::string& primary,
     std::unique_ptr<opentxs::api::storage::Plugin>& plugin)
@@ -265,6 +329,11 @@ bool StorageMultiplex::Load(
 {
     OT_ASSERT(primary_plugin_);
 
+    if (load_pending(key, value)) {
+
+        return true;
+    }
+
     if (primary_plugin_->Load(key, checking, value)) {
 
         return true;
@@ -313,6 +382,12 @@ bool StorageMultiplex::LoadFromBucket(
 {
     OT_ASSERT(primary_plugin_);
 
+    // Pending nodes will be written to the current bucket
+    if ((bucket == primary_bucket_) && load_pending(key, value)) {
+
+        return true;
+    }
+
     if (primary_plugin_->LoadFromBucket(key, value, bucket)) {
 
         return true;
@@ -330,6 +405,25 @@ bool StorageMultiplex::LoadFromBucket(
     return false;
 }
 
+bool StorageMultiplex::load_pending(
+    const std::string& key,
+    std::string& value) const
+{
+    Lock lock(batch_lock_);
+
+    for (const auto* nodes : {&pending_, &flushing_}) {
+        const auto it = nodes->find(key);
+
+        if (nodes->end() != it) {
+            value = it->second.second;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
 std::string StorageMultiplex::LoadRoot() const
 {
     OT_ASSERT(primary_plugin_);
@@ -361,6 +455,20 @@ bool StorageMultiplex::Migrate(
 {
     OT_ASSERT(primary_plugin_);
 
+    std::string value{};
+
+    if (load_pending(key, value)) {
+        // The node will reach the current bucket when the batch is flushed
+        if (&to == this) {
+
+            return true;
+        }
+
+        std::string notUsed{};
+
+        return to.Store(false, value, notUsed);
+    }
+
     if (primary_plugin_->Migrate(key, to)) {
 
         return true;
@@ -427,6 +535,26 @@ opentxs::api::storage::Driver& StorageMultiplex::Primary()
     return *primary_plugin_;
 }
 
+void StorageMultiplex::release_pending(
+    const Lock& lock,
+    const std::string& key) const
+{
+    OT_ASSERT(lock.mutex() == &batch_lock_);
+
+    auto it = pending_.find(key);
+
+    if (pending_.end() == it) {
+
+        return;
+    }
+
+    auto& count = it->second.first;
+
+    if (0 == --count) {
+        pending_.erase(it);
+    }
+}
+
 bool StorageMultiplex::Store(
     const bool isTransaction,
     const std::string& key,
@@ -435,23 +563,22 @@ bool StorageMultiplex::Store(
 {
     OT_ASSERT(primary_plugin_);
 
-    std::vector<std::promise<bool>> promises{};
+    // Backup plugins are written by the queue while the primary plugin is
+    // written on the calling thread
+    std::vector<std::promise<bool>> promises(backup_plugins_.size());
     std::vector<std::future<bool>> futures{};
-    promises.push_back(std::promise<bool>());
-    auto& primaryPromise = promises.back();
-    futures.push_back(primaryPromise.get_future());
-    primary_plugin_->Store(isTransaction, key, value, bucket, primaryPromise);
+    auto promise = promises.begin();
 
     for (const auto& plugin : backup_plugins_) {
         OT_ASSERT(plugin);
 
-        promises.push_back(std::promise<bool>());
-        auto& promise = promises.back();
-        futures.push_back(promise.get_future());
-        plugin->Store(isTransaction, key, value, bucket, promise);
+        futures.push_back(promise->get_future());
+        write_queue_.Push(
+            *plugin, isTransaction, key, value, bucket, *promise);
+        ++promise;
     }
 
-    bool output = false;
+    bool output = primary_plugin_->Store(isTransaction, key, value, bucket);
 
     for (auto& future : futures) {
         output |= future.get();
@@ -490,8 +617,51 @@ bool StorageMultiplex::Store(
     return output;
 }
 
+// While a batch is active, each version of an index node only replaces the
+// version it superseded in memory. A node is only written once the root which
+// refers to it is stored.
+bool StorageMultiplex::StoreNode(const std::string& value, std::string& key)
+    const
+{
+    Lock lock(batch_lock_);
+
+    if (false == batch_active_) {
+        lock.unlock();
+
+        return Store(true, value, key);
+    }
+
+    std::string hash{};
+
+    if ((false == bool(digest_)) ||
+        (false == digest_(storage_.HashType(), value, hash))) {
+
+        return false;
+    }
+
+    auto& node = pending_[hash];
+    ++node.first;
+    node.second = value;
+    release_pending(lock, key);
+    key = hash;
+
+    return true;
+}
+
 bool StorageMultiplex::StoreRoot(const bool commit, const std::string& hash)
     const
+{
+    // Every node the root refers to must be written first
+    if (false == flush()) {
+
+        return false;
+    }
+
+    return store_root(commit, hash);
+}
+
+bool StorageMultiplex::store_root(const bool commit, const std::string& hash)
+    const
 {
     OT_ASSERT(primary_plugin_);
 
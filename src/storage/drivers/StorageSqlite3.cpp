@@ -45,13 +45,26 @@
 
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <set>
 #include <string>
 
+#define SQLITE3_BUSY_TIMEOUT_MILLISECONDS 5000
+#define SQLITE3_DEFAULT_SYNCHRONOUS "NORMAL"
+
 #define OT_METHOD "opentxs::StorageSqlite3::"
 
 namespace opentxs
 {
+namespace
+{
+// The values accepted by PRAGMA synchronous
+const std::set<std::string> synchronous_modes_{
+    "OFF", "NORMAL", "FULL", "EXTRA", "0", "1", "2", "3"};
+}  // namespace
+
 StorageSqlite3::StorageSqlite3(
     const api::storage::Storage& storage,
     const StorageConfig& config,
@@ -63,48 +76,94 @@ StorageSqlite3::StorageSqlite3(
     , transaction_lock_()
     , transaction_bucket_(Flag::Factory(false))
     , pending_()
-    , db_(nullptr)
+    , write_lock_()
+    , writer_()
+    , reader_lock_()
+    , reader_available_()
+    , readers_()
+    , idle_readers_()
 {
     Init_StorageSqlite3();
 }
 
-std::string StorageSqlite3::bind_key(
-    const std::string& source,
-    const std::string& key,
-    const std::size_t start) const
+void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
+
+void StorageSqlite3::Cleanup_StorageSqlite3()
 {
-    sqlite3_stmt* statement{nullptr};
-    sqlite3_prepare_v2(db_, source.c_str(), -1, &statement, nullptr);
-    sqlite3_bind_text(statement, start, key.c_str(), key.size(), SQLITE_STATIC);
-    const std::string output = sqlite3_expanded_sql(statement);
-    sqlite3_finalize(statement);
+    Lock readerLock(reader_lock_);
 
-    return output;
-}
+    for (auto& connection : readers_) {
+        OT_ASSERT(connection);
 
-void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
+        close(*connection);
+    }
 
-void StorageSqlite3::Cleanup_StorageSqlite3() { sqlite3_close(db_); }
+    idle_readers_.clear();
+    readerLock.unlock();
+    Lock writeLock(write_lock_);
+    close(writer_);
+}
 
-void StorageSqlite3::commit(std::stringstream& sql) const
+void StorageSqlite3::close(Connection& connection) const
 {
-    sql << "COMMIT TRANSACTION;";
+    for (auto& it : connection.statements_) {
+        sqlite3_finalize(it.second);
+    }
+
+    connection.statements_.clear();
+
+    if (nullptr != connection.db_) {
+        sqlite3_close(connection.db_);
+        connection.db_ = nullptr;
+    }
 }
 
 bool StorageSqlite3::commit_transaction(const std::string& rootHash) const
 {
-    Lock lock(transaction_lock_);
-    std::stringstream sql{};
-    start_transaction(sql);
-    set_data(sql);
-    set_root(rootHash, sql);
-    commit(sql);
+    Lock transactionLock(transaction_lock_);
+    Lock lock(write_lock_);
+    const std::string tablename{GetTableName(transaction_bucket_.get())};
+
+    if (false == exec(writer_, "BEGIN TRANSACTION;")) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to start transaction."
+              << std::endl;
+
+        return false;
+    }
+
+    bool success{true};
+
+    for (const auto& it : pending_) {
+        const auto& key = it.first;
+        const auto& value = it.second;
+        success = upsert(lock, key, tablename, value);
+
+        if (false == success) {
+            break;
+        }
+    }
+
+    if (success) {
+        success = upsert(
+            lock,
+            config_.sqlite3_root_key_,
+            config_.sqlite3_control_table_,
+            rootHash);
+    }
+
     pending_.clear();
-    otInfo << sql.str() << std::endl;
 
-    return (
-        SQLITE_OK ==
-        sqlite3_exec(db_, sql.str().c_str(), nullptr, nullptr, nullptr));
+    if (success) {
+        success = exec(writer_, "COMMIT TRANSACTION;");
+    }
+
+    if (false == success) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to commit transaction."
+              << std::endl;
+        exec(writer_, "ROLLBACK TRANSACTION;");
+    }
+
+    return success;
 }
 
 bool StorageSqlite3::Create(const std::string& tablename) const
@@ -112,9 +171,9 @@ bool StorageSqlite3::Create(const std::string& tablename) const
     const std::string createTable = "create table if not exists ";
     const std::string tableFormat = " (k text PRIMARY KEY, v BLOB);";
     const std::string sql = createTable + "`" + tablename + "`" + tableFormat;
+    Lock lock(write_lock_);
 
-    return (
-        SQLITE_OK == sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr));
+    return exec(writer_, sql);
 }
 
 bool StorageSqlite3::EmptyBucket(const bool bucket) const
@@ -122,6 +181,24 @@ bool StorageSqlite3::EmptyBucket(const bool bucket) const
     return Purge(GetTableName(bucket));
 }
 
+bool StorageSqlite3::exec(Connection& connection, const std::string& sql) const
+{
+    OT_ASSERT(nullptr != connection.db_);
+
+    char* error{nullptr};
+    const auto result =
+        sqlite3_exec(connection.db_, sql.c_str(), nullptr, nullptr, &error);
+
+    if (SQLITE_OK != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << sql << " failed: "
+              << ((nullptr == error) ? "" : error) << std::endl;
+    }
+
+    sqlite3_free(error);
+
+    return (SQLITE_OK == result);
+}
+
 std::string StorageSqlite3::GetTableName(const bool bucket) const
 {
     return bucket ? config_.sqlite3_secondary_bucket_
@@ -130,25 +207,57 @@ std::string StorageSqlite3::GetTableName(const bool bucket) const
 
 void StorageSqlite3::Init_StorageSqlite3()
 {
-    const std::string filename = folder_ + "/" + config_.sqlite3_db_file_;
-
-    if (SQLITE_OK ==
-        sqlite3_open_v2(
-            filename.c_str(),
-            &db_,
-            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX,
-            nullptr)) {
-        sqlite3_exec(
-            db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
-        Create(config_.sqlite3_primary_bucket_);
-        Create(config_.sqlite3_secondary_bucket_);
-        Create(config_.sqlite3_control_table_);
-    } else {
+    if (false == open(writer_, true)) {
         otErr << OT_METHOD << __FUNCTION__ << "Failed to initialize database."
               << std::endl;
 
         OT_FAIL
     }
+
+    // The configured value is pasted into a PRAGMA, so only known values
+    // are used
+    std::string synchronous = config_.sqlite3_synchronous_;
+    std::transform(
+        synchronous.begin(),
+        synchronous.end(),
+        synchronous.begin(),
+        [](const unsigned char c) -> char { return std::toupper(c); });
+
+    if (0 == synchronous_modes_.count(synchronous)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid synchronous mode "
+              << config_.sqlite3_synchronous_ << ". Using "
+              << SQLITE3_DEFAULT_SYNCHRONOUS << " instead." << std::endl;
+        synchronous = SQLITE3_DEFAULT_SYNCHRONOUS;
+    }
+
+    {
+        Lock lock(write_lock_);
+        exec(writer_, "PRAGMA journal_mode=WAL;");
+        exec(writer_, "PRAGMA synchronous=" + synchronous + ";");
+    }
+
+    Create(config_.sqlite3_primary_bucket_);
+    Create(config_.sqlite3_secondary_bucket_);
+    Create(config_.sqlite3_control_table_);
+    const auto count =
+        std::max(std::int64_t(1), config_.sqlite3_read_connections_);
+
+    for (std::int64_t i = 0; i < count; ++i) {
+        readers_.emplace_back(new Connection);
+        auto& connection = readers_.back();
+
+        OT_ASSERT(connection);
+
+        if (false == open(*connection, false)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << "Failed to open read connection." << std::endl;
+
+            OT_FAIL
+        }
+
+        exec(*connection, "PRAGMA query_only=1;");
+        idle_readers_.emplace_back(connection.get());
+    }
 }
 
 bool StorageSqlite3::LoadFromBucket(
@@ -172,136 +281,132 @@ std::string StorageSqlite3::LoadRoot() const
     return "";
 }
 
+bool StorageSqlite3::open(Connection& connection, const bool create) const
+{
+    const std::string filename = folder_ + "/" + config_.sqlite3_db_file_;
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_NOMUTEX;
+
+    if (create) {
+        flags |= SQLITE_OPEN_CREATE;
+    }
+
+    const auto opened =
+        sqlite3_open_v2(filename.c_str(), &connection.db_, flags, nullptr);
+
+    if (SQLITE_OK != opened) {
+
+        return false;
+    }
+
+    sqlite3_busy_timeout(connection.db_, SQLITE3_BUSY_TIMEOUT_MILLISECONDS);
+
+    return true;
+}
+
 bool StorageSqlite3::Purge(const std::string& tablename) const
 {
     const std::string sql = "DROP TABLE `" + tablename + "`;";
+    Lock lock(write_lock_);
+
+    if (exec(writer_, sql)) {
+        lock.unlock();
 
-    if (SQLITE_OK ==
-        sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr)) {
         return Create(tablename);
     }
 
     return false;
 }
 
+// Blocks until a read connection is available. The connection is returned to
+// the pool when the Reader goes out of scope.
+StorageSqlite3::Reader StorageSqlite3::reader() const
+{
+    Lock lock(reader_lock_);
+    reader_available_.wait(lock, [this]() -> bool {
+        return false == idle_readers_.empty();
+    });
+    auto* connection = idle_readers_.back();
+    idle_readers_.pop_back();
+
+    return Reader(connection, [this](Connection* in) -> void {
+        Lock lock(reader_lock_);
+        idle_readers_.emplace_back(in);
+        lock.unlock();
+        reader_available_.notify_one();
+    });
+}
+
 bool StorageSqlite3::Select(
     const std::string& key,
     const std::string& tablename,
     std::string& value) const
 {
-    sqlite3_stmt* statement{nullptr};
-    const std::string query =
-        "SELECT v FROM '" + tablename + "' WHERE k GLOB ?1;";
-    const auto sql = bind_key(query, key, 1);
-    sqlite3_prepare_v2(db_, sql.c_str(), -1, &statement, 0);
-    otInfo << sql << std::endl;
-    auto result = sqlite3_step(statement);
+    auto connection = reader();
+
+    OT_ASSERT(connection);
+
+    auto* select = statement(
+        *connection, "SELECT v FROM `" + tablename + "` WHERE k = ?1;");
+
+    if (nullptr == select) {
+
+        return false;
+    }
+
+    sqlite3_bind_text(select, 1, key.c_str(), key.size(), SQLITE_STATIC);
+    const auto result = sqlite3_step(select);
     bool success = false;
-    std::size_t retry{3};
-
-    while (0 < retry) {
-        switch (result) {
-            case SQLITE_DONE:
-            case SQLITE_ROW: {
-                retry = 0;
-                const auto size = sqlite3_column_bytes(statement, 0);
-                success = (0 < size);
-
-                if (success) {
-                    const auto pResult = sqlite3_column_blob(statement, 0);
-                    value.assign(static_cast<const char*>(pResult), size);
-                }
-            } break;
-            case SQLITE_BUSY: {
-                otErr << OT_METHOD << __FUNCTION__ << ": Busy" << std::endl;
-                result = sqlite3_step(statement);
-                --retry;
-            } break;
-            default: {
-                otErr << OT_METHOD << __FUNCTION__ << ": Unknown error ("
-                      << result << ")" << std::endl;
-                result = sqlite3_step(statement);
-                --retry;
+
+    switch (result) {
+        case SQLITE_DONE:
+        case SQLITE_ROW: {
+            const auto size = sqlite3_column_bytes(select, 0);
+            success = (0 < size);
+
+            if (success) {
+                const auto pResult = sqlite3_column_blob(select, 0);
+                value.assign(static_cast<const char*>(pResult), size);
             }
+        } break;
+        default: {
+            otErr << OT_METHOD << __FUNCTION__ << ": Unknown error (" << result
+                  << ")" << std::endl;
         }
     }
 
-    sqlite3_finalize(statement);
+    sqlite3_reset(select);
+    sqlite3_clear_bindings(select);
 
     return success;
 }
 
-void StorageSqlite3::set_data(std::stringstream& sql) const
+// Returns a cached prepared statement, preparing it on first use.
+sqlite3_stmt* StorageSqlite3::statement(
+    Connection& connection,
+    const std::string& sql) const
 {
-    sqlite3_stmt* data{nullptr};
-    std::stringstream dataSQL{};
-    const std::string tablename{GetTableName(transaction_bucket_.get())};
-    dataSQL << "INSERT OR REPLACE INTO '" << tablename << "' (k, v) VALUES ";
-    std::size_t counter{0};
-    const auto size = pending_.size();
-
-    for (std::size_t i = 0; i < size; ++i) {
-        dataSQL << "(?" << ++counter << ", ?";
-        dataSQL << ++counter << ")";
-
-        if (counter < (2 * size)) {
-            dataSQL << ", ";
-        } else {
-            dataSQL << "; ";
-        }
-    }
+    auto it = connection.statements_.find(sql);
 
-    sqlite3_prepare_v2(db_, dataSQL.str().c_str(), -1, &data, 0);
-    counter = 0;
+    if (connection.statements_.end() != it) {
 
-    for (const auto& it : pending_) {
-        const auto& key = it.first;
-        const auto& value = it.second;
-        auto bound = sqlite3_bind_text(
-            data, ++counter, key.c_str(), key.size(), SQLITE_STATIC);
+        return it->second;
+    }
 
-        OT_ASSERT(SQLITE_OK == bound);
+    sqlite3_stmt* output{nullptr};
+    const auto prepared =
+        sqlite3_prepare_v2(connection.db_, sql.c_str(), -1, &output, nullptr);
 
-        bound = sqlite3_bind_blob(
-            data, ++counter, value.c_str(), value.size(), SQLITE_STATIC);
+    if (SQLITE_OK != prepared) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to prepare " << sql
+              << ": " << sqlite3_errmsg(connection.db_) << std::endl;
+        sqlite3_finalize(output);
 
-        OT_ASSERT(SQLITE_OK == bound);
+        return nullptr;
     }
 
-    sql << sqlite3_expanded_sql(data) << " ";
-    sqlite3_finalize(data);
-}
+    connection.statements_.emplace(sql, output);
 
-void StorageSqlite3::set_root(
-    const std::string& rootHash,
-    std::stringstream& sql) const
-{
-    sqlite3_stmt* root{nullptr};
-    std::stringstream rootSQL{};
-    rootSQL << "INSERT OR REPLACE INTO '" << config_.sqlite3_control_table_
-            << "'  (k, v) VALUES (?1, ?2); ";
-    sqlite3_prepare_v2(db_, rootSQL.str().c_str(), -1, &root, 0);
-    auto bound = sqlite3_bind_text(
-        root,
-        1,
-        config_.sqlite3_root_key_.c_str(),
-        config_.sqlite3_root_key_.size(),
-        SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    bound = sqlite3_bind_blob(
-        root, 2, rootHash.c_str(), rootHash.size(), SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    sql << sqlite3_expanded_sql(root) << " ";
-    sqlite3_finalize(root);
-}
-
-void StorageSqlite3::start_transaction(std::stringstream& sql) const
-{
-    sql << "BEGIN TRANSACTION; ";
+    return output;
 }
 
 void StorageSqlite3::store(
@@ -340,16 +445,34 @@ bool StorageSqlite3::Upsert(
     const std::string& tablename,
     const std::string& value) const
 {
-    sqlite3_stmt* statement;
-    const std::string query =
-        "insert or replace into `" + tablename + "` (k, v) values (?1, ?2);";
-
-    sqlite3_prepare_v2(db_, query.c_str(), -1, &statement, 0);
-    sqlite3_bind_text(statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
-    sqlite3_bind_blob(statement, 2, value.c_str(), value.size(), SQLITE_STATIC);
-    otInfo << sqlite3_expanded_sql(statement) << std::endl;
-    const auto result = sqlite3_step(statement);
-    sqlite3_finalize(statement);
+    Lock lock(write_lock_);
+
+    return upsert(lock, key, tablename, value);
+}
+
+bool StorageSqlite3::upsert(
+    const Lock& lock,
+    const std::string& key,
+    const std::string& tablename,
+    const std::string& value) const
+{
+    OT_ASSERT(lock.mutex() == &write_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    auto* upsert = statement(
+        writer_,
+        "insert or replace into `" + tablename + "` (k, v) values (?1, ?2);");
+
+    if (nullptr == upsert) {
+
+        return false;
+    }
+
+    sqlite3_bind_text(upsert, 1, key.c_str(), key.size(), SQLITE_STATIC);
+    sqlite3_bind_blob(upsert, 2, value.c_str(), value.size(), SQLITE_STATIC);
+    const auto result = sqlite3_step(upsert);
+    sqlite3_reset(upsert);
+    sqlite3_clear_bindings(upsert);
 
     return (result == SQLITE_DONE);
 }
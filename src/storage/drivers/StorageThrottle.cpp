@@ -0,0 +1,148 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/storage/drivers/StorageThrottle.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace opentxs
+{
+StorageThrottle::StorageThrottle(
+    const opentxs::api::storage::Driver& driver,
+    const std::int64_t objectsPerSecond)
+    : driver_(driver)
+    , interval_(
+          (0 < objectsPerSecond) ? (1000000 / objectsPerSecond) : 0)
+    , lock_()
+    , next_(std::chrono::steady_clock::now())
+{
+}
+
+bool StorageThrottle::EmptyBucket(const bool bucket) const
+{
+    return driver_.EmptyBucket(bucket);
+}
+
+bool StorageThrottle::Load(
+    const std::string& key,
+    const bool checking,
+    std::string& value) const
+{
+    return driver_.Load(key, checking, value);
+}
+
+bool StorageThrottle::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const
+{
+    return driver_.LoadFromBucket(key, value, bucket);
+}
+
+std::string StorageThrottle::LoadRoot() const { return driver_.LoadRoot(); }
+
+bool StorageThrottle::Migrate(
+    const std::string& key,
+    const opentxs::api::storage::Driver& to) const
+{
+    return driver_.Migrate(key, to);
+}
+
+bool StorageThrottle::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket) const
+{
+    wait();
+
+    return driver_.Store(isTransaction, key, value, bucket);
+}
+
+void StorageThrottle::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>& promise) const
+{
+    wait();
+    driver_.Store(isTransaction, key, value, bucket, promise);
+}
+
+bool StorageThrottle::Store(
+    const bool isTransaction,
+    const std::string& value,
+    std::string& key) const
+{
+    wait();
+
+    return driver_.Store(isTransaction, value, key);
+}
+
+bool StorageThrottle::StoreRoot(const bool commit, const std::string& hash)
+    const
+{
+    return driver_.StoreRoot(commit, hash);
+}
+
+const opentxs::api::storage::Driver& StorageThrottle::Target() const
+{
+    return driver_.Target();
+}
+
+void StorageThrottle::wait() const
+{
+    if (0 == interval_.count()) {
+
+        return;
+    }
+
+    Lock lock(lock_);
+    next_ = std::max(next_, std::chrono::steady_clock::now());
+    const auto until = next_;
+    next_ += interval_;
+    lock.unlock();
+    std::this_thread::sleep_until(until);
+}
+}  // namespace opentxs
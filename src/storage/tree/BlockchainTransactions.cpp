@@ -120,7 +120,7 @@ bool BlockchainTransactions::save(const Lock& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageBlockchainTransactions BlockchainTransactions::serialize() const
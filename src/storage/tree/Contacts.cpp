@@ -332,7 +332,7 @@ bool Contacts::save(const Lock& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 bool Contacts::Save() const
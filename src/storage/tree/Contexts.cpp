@@ -108,7 +108,7 @@ bool Contexts::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageNymList Contexts::serialize() const
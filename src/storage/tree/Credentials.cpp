@@ -166,7 +166,7 @@ bool Credentials::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageCredentials Credentials::serialize() const
@@ -109,7 +109,7 @@ bool Issuers::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageIssuers Issuers::serialize() const
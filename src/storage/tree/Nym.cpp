@@ -656,7 +656,7 @@ bool Nym::save(const Lock& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 void Nym::save(PeerReplies* input, const Lock& lock, StorageBox type)
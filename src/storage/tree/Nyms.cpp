@@ -240,7 +240,7 @@ bool Nyms::save(const Lock& lock) const
 
     OT_ASSERT(CURRENT_VERSION == serialized.version())
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 void Nyms::save(class Nym* nym, const Lock& lock, const std::string& id)
@@ -136,7 +136,7 @@ bool PeerReplies::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageNymList PeerReplies::serialize() const
@@ -107,7 +107,7 @@ bool PeerRequests::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageNymList PeerRequests::serialize() const
@@ -56,6 +56,7 @@
 #include "opentxs/Proto.hpp"
 
 #define CURRENT_VERSION 2
+#define GC_CURSOR_KEY "gc_cursor"
 
 #define OT_METHOD "opentxs::storage::Root::"
 
@@ -118,17 +119,42 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
     }
 
     lock.unlock();
-    bool success{false};
+    const auto start = std::time(nullptr);
+    const bool newLocation = !oldLocation;
+    bool success{true};
+    std::size_t slice{0};
+    std::size_t slices{0};
 
     if (Node::check_hash(gc_root_)) {
         const class Tree tree(driver_, gc_root_);
-        success = tree.Migrate(*to);
+        slices = tree.GCSlices();
+
+        if (resume) {
+            slice = load_gc_cursor(newLocation);
+            otErr << OT_METHOD << __FUNCTION__ << ": Resuming at slice "
+                  << slice << " of " << slices << "." << std::endl;
+        }
+
+        while (slice < slices) {
+            if (false == tree.Migrate(slice, *to)) {
+                success = false;
+
+                break;
+            }
+
+            save_gc_cursor(++slice, newLocation);
+            otInfo << OT_METHOD << __FUNCTION__ << ": Migrated " << slice
+                   << " of " << slices << " slices." << std::endl;
+        }
+    } else {
+        success = false;
     }
 
     if (success) {
         driver_.EmptyBucket(oldLocation);
     } else {
-        otErr << OT_METHOD << __FUNCTION__ << ": Garbage collection failed. "
+        otErr << OT_METHOD << __FUNCTION__ << ": Garbage collection failed at "
+              << "slice " << slice << " of " << slices << ". "
               << "Will retry next cycle." << std::endl;
     }
 
@@ -141,8 +167,9 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
     driver_.StoreRoot(true, root_);
     lock.unlock();
     gcLock.unlock();
-    otErr << OT_METHOD << __FUNCTION__ << ": Finished garbage collection."
-          << std::endl;
+    otErr << OT_METHOD << __FUNCTION__ << ": Finished garbage collection ("
+          << slices << " slices in " << (std::time(nullptr) - start)
+          << " seconds)." << std::endl;
 }
 
 void Root::init(const std::string& hash)
@@ -171,6 +198,34 @@ void Root::init(const std::string& hash)
     tree_root_ = normalize_hash(serialized->items());
 }
 
+// The cursor is stored in the destination bucket and is only valid for the
+// tree which was being collected when it was written
+std::size_t Root::load_gc_cursor(const bool bucket) const
+{
+    std::string value{};
+
+    if (false == driver_.LoadFromBucket(GC_CURSOR_KEY, value, bucket)) {
+
+        return 0;
+    }
+
+    const auto separator = value.find(' ');
+
+    if ((std::string::npos == separator) ||
+        (value.substr(0, separator) != gc_root_)) {
+
+        return 0;
+    }
+
+    try {
+
+        return std::stoull(value.substr(separator + 1));
+    } catch (...) {
+
+        return 0;
+    }
+}
+
 bool Root::Migrate(const opentxs::api::storage::Driver& to) const
 {
     if (0 == gc_interval_) {
@@ -219,6 +274,11 @@ bool Root::save(const Lock& lock, const opentxs::api::storage::Driver& to) const
         return false;
     }
 
+    if (&to == &driver_) {
+
+        return store_node(serialized);
+    }
+
     return to.StoreProto(serialized, root_);
 }
 
@@ -246,6 +306,16 @@ void Root::save(class Tree* tree, const Lock& lock)
     OT_ASSERT(saved);
 }
 
+void Root::save_gc_cursor(const std::size_t slice, const bool bucket) const
+{
+    const std::string value = gc_root_ + " " + std::to_string(slice);
+
+    if (false == driver_.Store(false, GC_CURSOR_KEY, value, bucket)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to save garbage collection progress." << std::endl;
+    }
+}
+
 bool Root::Save(const opentxs::api::storage::Driver& to) const
 {
     Lock lock(write_lock_);
@@ -122,7 +122,7 @@ bool Seeds::save(const std::unique_lock<std::mutex>& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageSeeds Seeds::serialize() const
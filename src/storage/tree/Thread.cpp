@@ -295,7 +295,7 @@ bool Thread::save(const Lock& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 proto::StorageThread Thread::serialize(const Lock& lock) const
@@ -56,6 +56,7 @@ namespace storage
 {
 
 #define CURRENT_VERSION 3
+#define FIXED_GC_SLICES 6
 
 #define OT_METHOD "opentxs::storage::Tree::"
 
@@ -228,21 +229,84 @@ void Tree::init(const std::string& hash)
     unit_root_ = normalize_hash(serialized->units());
 }
 
+std::size_t Tree::GCSlices() const
+{
+    // The final slice contains the nym list and the tree itself
+    return FIXED_GC_SLICES + nyms()->item_map_.size() + 1;
+}
+
 bool Tree::Migrate(const opentxs::api::storage::Driver& to) const
 {
     bool output{true};
-    output &= blockchain()->Migrate(to);
-    output &= contacts()->Migrate(to);
-    output &= credentials()->Migrate(to);
-    output &= nyms()->Migrate(to);
-    output &= seeds()->Migrate(to);
-    output &= servers()->Migrate(to);
-    output &= units()->Migrate(to);
-    output &= migrate(root_, to);
+    const auto slices = GCSlices();
+
+    for (std::size_t slice = 0; slice < slices; ++slice) {
+        output &= Migrate(slice, to);
+    }
 
     return output;
 }
 
+bool Tree::Migrate(
+    const std::size_t slice,
+    const opentxs::api::storage::Driver& to) const
+{
+    switch (slice) {
+        case 0: {
+
+            return blockchain()->Migrate(to);
+        }
+        case 1: {
+
+            return contacts()->Migrate(to);
+        }
+        case 2: {
+
+            return credentials()->Migrate(to);
+        }
+        case 3: {
+
+            return seeds()->Migrate(to);
+        }
+        case 4: {
+
+            return servers()->Migrate(to);
+        }
+        case 5: {
+
+            return units()->Migrate(to);
+        }
+        default: {
+        }
+    }
+
+    const auto* nymList = nyms();
+
+    OT_ASSERT(nullptr != nymList);
+
+    const auto& items = nymList->item_map_;
+    const auto index = slice - FIXED_GC_SLICES;
+
+    if (index < items.size()) {
+        const auto& id = std::next(items.begin(), index)->first;
+
+        return nymList->nym(id)->Migrate(to);
+    }
+
+    if (index == items.size()) {
+        bool output{true};
+        output &= migrate(nymList->root_, to);
+        output &= migrate(root_, to);
+
+        return output;
+    }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Invalid slice " << slice
+          << std::endl;
+
+    return false;
+}
+
 Editor<BlockchainTransactions> Tree::mutable_Blockchain()
 {
     std::function<void(BlockchainTransactions*, Lock&)> callback =
@@ -335,7 +399,7 @@ bool Tree::save(const Lock& lock) const
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_node(serialized);
 }
 
 void Tree::save(BlockchainTransactions* blockchain, const Lock& lock)
@@ -0,0 +1,152 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Blockchain.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/core/crypto/AsymmetricKeySecp256k1.hpp"
+#include "opentxs/core/crypto/Bip32.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string words_{"abandon abandon abandon abandon abandon abandon "
+                         "abandon abandon abandon abandon abandon about"};
+// m/44'/0'/0'/0/0 for words_ with an empty passphrase
+const std::string first_address_{"1LqBGSKuX5yYUonjxT5qGfpUsXKYYWeabA"};
+const std::uint32_t address_count_{40};
+const std::uint8_t bitcoin_prefix_{0x00};
+
+// Derives the address the way Blockchain did before the chain keys were
+// cached: the full private child key from the seed, one index at a time.
+std::string seed_address(const proto::HDPath& path, const std::uint32_t index)
+{
+    auto& crypto = OT::App().Crypto();
+    const auto serialized =
+        crypto.BIP32().AccountChildKey(path, EXTERNAL_CHAIN, index);
+
+    if (false == bool(serialized)) {
+
+        return {};
+    }
+
+    std::unique_ptr<OTAsymmetricKey> key(
+        OTAsymmetricKey::KeyFactory(*serialized));
+    const auto ecKey = dynamic_cast<const AsymmetricKeySecp256k1*>(key.get());
+
+    if (nullptr == ecKey) {
+
+        return {};
+    }
+
+    auto pubkey = Data::Factory();
+    auto sha256 = Data::Factory();
+    auto pubkeyHash = Data::Factory();
+
+    if (false == ecKey->GetPublicKey(pubkey)) {
+
+        return {};
+    }
+
+    if (!crypto.Hash().Digest(proto::HASHTYPE_SHA256, pubkey, sha256)) {
+
+        return {};
+    }
+
+    if (!crypto.Hash().Digest(proto::HASHTYPE_RIMEMD160, sha256, pubkeyHash)) {
+
+        return {};
+    }
+
+    auto preimage = Data::Factory(&bitcoin_prefix_, sizeof(bitcoin_prefix_));
+    preimage += pubkeyHash;
+
+    return crypto.Encode().IdentifierEncode(preimage);
+}
+}  // namespace
+
+TEST(Blockchain, chain_key_matches_seed_derivation)
+{
+    auto& exec = OT::App().API().Exec();
+    auto& blockchain = OT::App().Blockchain();
+    const auto fingerprint = exec.Wallet_ImportSeed(words_, "");
+
+    ASSERT_FALSE(fingerprint.empty());
+
+    const Identifier nymID(exec.CreateNymHD(
+        proto::CITEMTYPE_INDIVIDUAL, "blockchain", fingerprint, 0));
+
+    ASSERT_FALSE(nymID.empty());
+
+    const auto accountID = blockchain.NewAccount(
+        nymID, BlockchainAccountType::BIP44, proto::CITEMTYPE_BTC);
+
+    ASSERT_FALSE(accountID.empty());
+
+    const auto addresses =
+        blockchain.AllocateAddresses(nymID, accountID, address_count_);
+    const auto account = blockchain.Account(nymID, accountID);
+
+    ASSERT_EQ(address_count_, addresses.size());
+    ASSERT_TRUE(bool(account));
+    EXPECT_EQ(first_address_, addresses.front().address());
+
+    for (std::uint32_t i = 0; i < address_count_; ++i) {
+        const auto& address = addresses[i];
+
+        EXPECT_EQ(i, address.index());
+        EXPECT_EQ(seed_address(account->path(), i), address.address());
+    }
+}
@@ -0,0 +1,141 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/cash/SpentTokens.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+Identifier make_token(const std::uint8_t first, const std::uint8_t last)
+{
+    std::vector<std::uint8_t> bytes(32, 0x5a);
+    bytes.front() = first;
+    bytes.back() = last;
+    Identifier output;
+    output.Assign(bytes.data(), bytes.size());
+
+    return output;
+}
+
+class Test_SpentTokens : public ::testing::Test
+{
+public:
+    // Spent token files stay in the data folder after a test ends
+    const Identifier unit_{Identifier::Random()};
+    const std::int32_t series_{0};
+};
+}  // namespace
+
+TEST_F(Test_SpentTokens, record_and_lookup)
+{
+    const auto token = make_token(1, 1);
+    const auto other = make_token(2, 2);
+
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_, token));
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_TRUE(SpentTokens::Contains(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_, other));
+}
+
+TEST_F(Test_SpentTokens, insert_twice_fails)
+{
+    const auto token = make_token(3, 3);
+
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_TRUE(SpentTokens::Contains(unit_, series_, token));
+}
+
+TEST_F(Test_SpentTokens, series_are_separate)
+{
+    const auto token = make_token(4, 4);
+
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_ + 1, token));
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_ + 1, token));
+}
+
+TEST_F(Test_SpentTokens, bloom_false_positive)
+{
+    // The Bloom filter only looks at the first 16 bytes of a token, so these
+    // two tokens set the same bits and the lookup has to fall through to the
+    // stored records
+    const auto token = make_token(5, 1);
+    const auto collision = make_token(5, 2);
+
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_, collision));
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, collision));
+    ASSERT_TRUE(SpentTokens::Contains(unit_, series_, collision));
+}
+
+TEST_F(Test_SpentTokens, expire)
+{
+    const auto token = make_token(6, 6);
+
+    ASSERT_FALSE(SpentTokens::Expire(unit_, series_));
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+    ASSERT_TRUE(SpentTokens::Expire(unit_, series_));
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Expire(unit_, series_));
+}
+
+TEST_F(Test_SpentTokens, reload)
+{
+    const auto token = make_token(7, 7);
+    const auto collision = make_token(7, 8);
+
+    ASSERT_TRUE(SpentTokens::Insert(unit_, series_, token));
+
+    // Loading more series than are kept in memory forces this one to be
+    // evicted, so the next lookup reads it back from disk
+    for (std::int32_t i = 1; i < 64; ++i) {
+        ASSERT_FALSE(SpentTokens::Contains(unit_, series_ + i, token));
+    }
+
+    ASSERT_TRUE(SpentTokens::Contains(unit_, series_, token));
+    ASSERT_FALSE(SpentTokens::Contains(unit_, series_, collision));
+    ASSERT_FALSE(SpentTokens::Insert(unit_, series_, token));
+}
@@ -0,0 +1,231 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+Identifier make_id(const std::vector<std::uint8_t>& bytes)
+{
+    Identifier output;
+    output.Assign(bytes.data(), bytes.size());
+
+    return output;
+}
+
+std::vector<Identifier> random_ids(const std::size_t count)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<Identifier> output{};
+    output.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::vector<std::uint8_t> bytes(20);
+
+        for (auto& value : bytes) {
+            value = static_cast<std::uint8_t>(byte(generator));
+        }
+
+        output.emplace_back(make_id(bytes));
+    }
+
+    return output;
+}
+}  // namespace
+
+TEST(Identifier, empty_identifiers_are_equal)
+{
+    const Identifier one;
+    const Identifier two;
+    ASSERT_TRUE(one == two);
+    ASSERT_FALSE(one < two);
+    ASSERT_EQ(std::hash<Identifier>()(one), std::hash<Identifier>()(two));
+}
+
+TEST(Identifier, compare_by_digest)
+{
+    const auto low = make_id({1, 2, 3});
+    const auto high = make_id({1, 2, 4});
+    const auto copy = make_id({1, 2, 3});
+
+    ASSERT_TRUE(low == copy);
+    ASSERT_TRUE(low != high);
+    ASSERT_TRUE(low < high);
+    ASSERT_TRUE(high > low);
+    ASSERT_TRUE(low <= copy);
+    ASSERT_TRUE(low >= copy);
+    ASSERT_EQ(std::hash<Identifier>()(low), std::hash<Identifier>()(copy));
+}
+
+TEST(Identifier, shorter_prefix_sorts_first)
+{
+    const auto shorter = make_id({1, 2});
+    const auto longer = make_id({1, 2, 0});
+
+    ASSERT_TRUE(shorter < longer);
+    ASSERT_TRUE(shorter != longer);
+}
+
+TEST(Identifier, empty_sorts_first)
+{
+    const Identifier empty;
+    const auto id = make_id({0});
+
+    ASSERT_TRUE(empty < id);
+    ASSERT_FALSE(id < empty);
+}
+
+TEST(Identifier, copy_and_assign)
+{
+    const auto id = make_id({9, 8, 7});
+    Identifier copy(id);
+    Identifier assigned;
+    assigned = id;
+
+    ASSERT_TRUE(id == copy);
+    ASSERT_TRUE(id == assigned);
+}
+
+TEST(Identifier, map_keys)
+{
+    const auto ids = random_ids(1000);
+    std::map<Identifier, std::size_t> ordered{};
+    std::unordered_map<Identifier, std::size_t> unordered{};
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ordered.emplace(ids[i], i);
+        unordered.emplace(ids[i], i);
+    }
+
+    ASSERT_EQ(ids.size(), ordered.size());
+    ASSERT_EQ(ids.size(), unordered.size());
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(i, ordered.at(ids[i]));
+        ASSERT_EQ(i, unordered.at(ids[i]));
+    }
+}
+
+// Not a pass/fail test: reports the cost of map lookups keyed by Identifier.
+// Run with --gtest_also_run_disabled_tests.
+TEST(Identifier, DISABLED_map_lookup_benchmark)
+{
+    const std::size_t count{10000};
+    const std::size_t rounds{20};
+    const auto ids = random_ids(count);
+    std::map<Identifier, std::size_t> ordered{};
+    std::unordered_map<Identifier, std::size_t> unordered{};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ordered.emplace(ids[i], i);
+        unordered.emplace(ids[i], i);
+    }
+
+    ASSERT_EQ(ordered.size(), count);
+    ASSERT_EQ(unordered.size(), count);
+
+    std::size_t found{0};
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (const auto& id : ids) {
+            found += ordered.count(id);
+        }
+    }
+
+    const auto orderedTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (const auto& id : ids) {
+            found += unordered.count(id);
+        }
+    }
+
+    const auto unorderedTime = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(found, 2 * count * rounds);
+
+    const auto perLookup = [&](const std::chrono::nanoseconds& time) {
+        return time.count() / static_cast<double>(count * rounds);
+    };
+
+    std::cout << "std::map lookup: " << perLookup(orderedTime) << " ns"
+              << std::endl
+              << "std::unordered_map lookup: " << perLookup(unorderedTime)
+              << " ns" << std::endl;
+}
+
+TEST(Identifier, str_follows_changes)
+{
+    Identifier id;
+
+    ASSERT_TRUE(id.CalculateDigest(String("first")));
+
+    const auto first = id.str();
+
+    ASSERT_FALSE(first.empty());
+    ASSERT_TRUE(id.CalculateDigest(String("second")));
+
+    const auto second = id.str();
+
+    ASSERT_NE(first, second);
+    ASSERT_EQ(second, String(id).Get());
+
+    id.SetString(first);
+
+    ASSERT_EQ(first, id.str());
+    ASSERT_EQ(first, String(id).Get());
+
+    id.SetString(String(second.c_str()));
+
+    ASSERT_EQ(second, id.str());
+}
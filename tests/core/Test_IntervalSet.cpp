@@ -0,0 +1,143 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+#include "opentxs/core/IntervalSet.hpp"
+#include "opentxs/core/NumList.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+TEST(IntervalSet, default_accessors)
+{
+    IntervalSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.size(), 0);
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_EQ(set.Encode(), "");
+}
+
+TEST(IntervalSet, insert_merges_adjacent)
+{
+    IntervalSet set;
+    ASSERT_TRUE(set.insert(1).second);
+    ASSERT_TRUE(set.insert(3).second);
+    ASSERT_EQ(set.Ranges().size(), 2);
+    ASSERT_TRUE(set.insert(2).second);
+    ASSERT_FALSE(set.insert(2).second);
+    ASSERT_EQ(set.Ranges().size(), 1);
+    ASSERT_EQ(set.size(), 3);
+    ASSERT_EQ(set.Encode(), "1-3");
+}
+
+TEST(IntervalSet, erase_splits_range)
+{
+    IntervalSet set;
+    ASSERT_EQ(set.InsertRange(5, 10), 6);
+    ASSERT_EQ(set.erase(7), 1);
+    ASSERT_EQ(set.erase(7), 0);
+    ASSERT_EQ(set.count(7), 0);
+    ASSERT_EQ(set.count(8), 1);
+    ASSERT_EQ(set.size(), 5);
+    ASSERT_EQ(set.Encode(), "5-6,8-10");
+}
+
+TEST(IntervalSet, insert_range_counts_new_elements)
+{
+    IntervalSet set;
+    set.insert(3);
+    set.insert(8);
+    ASSERT_EQ(set.InsertRange(1, 9), 7);
+    ASSERT_EQ(set.Encode(), "1-9");
+    ASSERT_EQ(set.InsertRange(2, 4), 0);
+}
+
+TEST(IntervalSet, iterates_in_order)
+{
+    const std::set<IntervalSet::value_type> expected{1, 2, 3, 7, 9, 10};
+    const IntervalSet set(expected);
+    ASSERT_EQ(set.Set(), expected);
+    ASSERT_EQ(set.size(), expected.size());
+    ASSERT_EQ(*set.find(9), 9);
+    ASSERT_TRUE(set.find(4) == set.end());
+}
+
+TEST(IntervalSet, decode_reads_both_forms)
+{
+    IntervalSet ranges, plain;
+    ASSERT_TRUE(IntervalSet::Decode("1-3,7,9-10", ranges));
+    ASSERT_TRUE(IntervalSet::Decode("1,2,3, 7 9,10", plain));
+    ASSERT_TRUE(ranges == plain);
+
+    IntervalSet invalid;
+    ASSERT_FALSE(IntervalSet::Decode("5-3", invalid));
+    ASSERT_FALSE(IntervalSet::Decode("1-", invalid));
+    ASSERT_FALSE(IntervalSet::Decode("1,a", invalid));
+}
+
+TEST(IntervalSet, decode_can_refuse_ranges)
+{
+    IntervalSet plain, refused;
+    ASSERT_TRUE(IntervalSet::Decode("1,2,3", plain, false));
+    ASSERT_EQ(plain.size(), 3);
+    ASSERT_FALSE(IntervalSet::Decode("1-9223372036854775806", refused, false));
+    ASSERT_TRUE(refused.empty());
+}
+
+TEST(NumList, ranges_only_in_local_storage)
+{
+    NumList list;
+    ASSERT_TRUE(list.AddRanges(String("4-7,20")));
+    ASSERT_EQ(list.Count(), 5);
+
+    String plain, ranges;
+    ASSERT_TRUE(list.Output(plain));
+    ASSERT_STREQ(plain.Get(), "4,5,6,7,20");
+    ASSERT_TRUE(list.OutputRanges(ranges));
+    ASSERT_STREQ(ranges.Get(), "4-7,20");
+
+    NumList copy(plain);
+    ASSERT_TRUE(copy.Verify(list));
+
+    NumList wire;
+    ASSERT_FALSE(wire.Add(ranges));
+    ASSERT_EQ(wire.Count(), 0);
+}
@@ -0,0 +1,228 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/Contract.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::size_t batch_size_{100};
+const std::size_t bad_signature_{37};
+
+class TestContract : public Contract
+{
+public:
+    explicit TestContract(const std::string& text)
+        : Contract()
+    {
+        m_xmlUnsigned.Set(text.c_str());
+    }
+
+    void Tamper() { m_xmlUnsigned.Concatenate("tampered"); }
+};
+
+ConstNym signer()
+{
+    static ConstNym nym{nullptr};
+
+    if (false == bool(nym)) {
+        const auto nymID = OT::App().API().Exec().CreateNymHD(
+            proto::CITEMTYPE_INDIVIDUAL, "batch signer");
+        nym = OT::App().Wallet().Nym(Identifier(nymID));
+    }
+
+    return nym;
+}
+
+class Test_VerifyBatch : public ::testing::Test
+{
+public:
+    ConstNym nym_{signer()};
+    std::vector<OTData> plaintext_{};
+    std::vector<OTData> signature_{};
+
+    // Signs batch_size_ different messages with the nym's signing key
+    void sign()
+    {
+        ASSERT_TRUE(bool(nym_));
+
+        const auto& key = nym_->GetPrivateSignKey();
+
+        for (std::size_t i = 0; i < batch_size_; ++i) {
+            const std::string message = "message " + std::to_string(i);
+            plaintext_.emplace_back(
+                Data::Factory(message.c_str(), message.size()));
+            signature_.emplace_back(Data::Factory());
+
+            ASSERT_TRUE(key.engine().Sign(
+                plaintext_.back(),
+                key,
+                key.SigHashType(),
+                signature_.back()));
+        }
+    }
+
+    std::vector<SignatureCheck> batch() const
+    {
+        const auto& key = nym_->GetPublicSignKey();
+        std::vector<SignatureCheck> output{};
+
+        for (std::size_t i = 0; i < plaintext_.size(); ++i) {
+            output.push_back({&plaintext_[i].get(),
+                              &key,
+                              &signature_[i].get(),
+                              key.SigHashType()});
+        }
+
+        return output;
+    }
+
+    std::vector<bool> one_by_one() const
+    {
+        std::vector<bool> output{};
+
+        for (const auto& item : batch()) {
+            output.push_back(item.key_->engine().Verify(
+                *item.plaintext_,
+                *item.key_,
+                *item.signature_,
+                item.hash_type_));
+        }
+
+        return output;
+    }
+};
+}  // namespace
+
+TEST_F(Test_VerifyBatch, empty)
+{
+    EXPECT_TRUE(OT::App().Crypto().VerifyBatch({}).empty());
+}
+
+TEST_F(Test_VerifyBatch, all_good)
+{
+    sign();
+    const auto expected = one_by_one();
+    const auto results = OT::App().Crypto().VerifyBatch(batch());
+
+    ASSERT_EQ(batch_size_, results.size());
+    EXPECT_EQ(expected, results);
+
+    for (const bool result : results) {
+        EXPECT_TRUE(result);
+    }
+}
+
+TEST_F(Test_VerifyBatch, one_bad_signature)
+{
+    sign();
+    auto& bad = signature_[bad_signature_];
+    std::vector<std::uint8_t> bytes(
+        static_cast<const std::uint8_t*>(bad->GetPointer()),
+        static_cast<const std::uint8_t*>(bad->GetPointer()) + bad->GetSize());
+    bytes.back() ^= 0x01;
+    bad->Assign(bytes.data(), bytes.size());
+    const auto expected = one_by_one();
+    const auto results = OT::App().Crypto().VerifyBatch(batch());
+
+    ASSERT_EQ(batch_size_, results.size());
+    EXPECT_EQ(expected, results);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(bad_signature_ != i, results[i]);
+    }
+}
+
+TEST_F(Test_VerifyBatch, incomplete_item)
+{
+    sign();
+    auto items = batch();
+    items[bad_signature_].key_ = nullptr;
+    const auto results = OT::App().Crypto().VerifyBatch(items);
+
+    ASSERT_EQ(batch_size_, results.size());
+    EXPECT_FALSE(results[bad_signature_]);
+    EXPECT_TRUE(results[0]);
+}
+
+TEST_F(Test_VerifyBatch, contract_signatures)
+{
+    ASSERT_TRUE(bool(nym_));
+
+    std::vector<std::unique_ptr<TestContract>> contracts{};
+    std::vector<const Contract*> pointers{};
+
+    for (std::size_t i = 0; i < batch_size_; ++i) {
+        contracts.emplace_back(
+            new TestContract("contract " + std::to_string(i)));
+
+        ASSERT_TRUE(contracts.back()->SignContract(*nym_));
+
+        pointers.push_back(contracts.back().get());
+    }
+
+    contracts[bad_signature_]->Tamper();
+    const auto results = Contract::VerifySignatures(pointers, *nym_);
+
+    ASSERT_EQ(batch_size_, results.size());
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(contracts[i]->VerifySignature(*nym_), results[i]);
+        EXPECT_EQ(bad_signature_ != i, results[i]);
+    }
+}
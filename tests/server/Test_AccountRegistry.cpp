@@ -0,0 +1,186 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/AccountRegistry.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+class Test_AccountRegistry : public ::testing::Test
+{
+public:
+    // The registry is static, shared by every test in the process
+    const Identifier unit_{Identifier::Random()};
+    const Identifier issuer_{Identifier::Random()};
+    const Identifier alice_{Identifier::Random()};
+    const Identifier bob_{Identifier::Random()};
+
+    void add_accounts()
+    {
+        ASSERT_TRUE(AccountRegistry::Add(unit_, issuer_, true, -150));
+        ASSERT_TRUE(AccountRegistry::Add(unit_, alice_, false, 100));
+        ASSERT_TRUE(AccountRegistry::Add(unit_, bob_, false, 50));
+    }
+};
+}  // namespace
+
+TEST_F(Test_AccountRegistry, add)
+{
+    add_accounts();
+
+    ASSERT_EQ(3u, AccountRegistry::Count(unit_));
+    // The issuer balance is not in circulation
+    ASSERT_EQ(150, AccountRegistry::TotalBalance(unit_));
+    ASSERT_TRUE(AccountRegistry::Exists(unit_, alice_));
+
+    Identifier unit{};
+
+    ASSERT_TRUE(AccountRegistry::Unit(bob_, unit));
+    ASSERT_EQ(unit_, unit);
+}
+
+TEST_F(Test_AccountRegistry, add_twice)
+{
+    add_accounts();
+
+    ASSERT_TRUE(AccountRegistry::Add(unit_, alice_, false, 100));
+    ASSERT_EQ(3u, AccountRegistry::Count(unit_));
+    ASSERT_EQ(150, AccountRegistry::TotalBalance(unit_));
+}
+
+TEST_F(Test_AccountRegistry, erase)
+{
+    add_accounts();
+
+    ASSERT_TRUE(AccountRegistry::Erase(unit_, bob_));
+    ASSERT_EQ(2u, AccountRegistry::Count(unit_));
+    ASSERT_EQ(100, AccountRegistry::TotalBalance(unit_));
+    ASSERT_FALSE(AccountRegistry::Exists(unit_, bob_));
+
+    Identifier unit{};
+
+    ASSERT_FALSE(AccountRegistry::Unit(bob_, unit));
+    // Erasing an account which is not registered is not an error
+    ASSERT_TRUE(AccountRegistry::Erase(unit_, bob_));
+}
+
+TEST_F(Test_AccountRegistry, update)
+{
+    add_accounts();
+
+    ASSERT_TRUE(AccountRegistry::Update(unit_, alice_, false, 70));
+    ASSERT_TRUE(AccountRegistry::Update(unit_, bob_, false, 80));
+    ASSERT_TRUE(AccountRegistry::Update(unit_, issuer_, true, -150));
+    ASSERT_EQ(150, AccountRegistry::TotalBalance(unit_));
+    ASSERT_EQ(3u, AccountRegistry::Count(unit_));
+}
+
+TEST_F(Test_AccountRegistry, update_unregistered)
+{
+    add_accounts();
+    const auto other = Identifier::Random();
+
+    ASSERT_TRUE(AccountRegistry::Update(unit_, other, false, 1000));
+    ASSERT_TRUE(AccountRegistry::Flush());
+    ASSERT_FALSE(AccountRegistry::Exists(unit_, other));
+    ASSERT_EQ(3u, AccountRegistry::Count(unit_));
+    ASSERT_EQ(150, AccountRegistry::TotalBalance(unit_));
+}
+
+// More updates than fit in one batch, so some are written by Update itself
+TEST_F(Test_AccountRegistry, update_batches)
+{
+    add_accounts();
+
+    for (std::int64_t i = 1; i <= 1000; ++i) {
+        ASSERT_TRUE(AccountRegistry::Update(unit_, alice_, false, i));
+        ASSERT_TRUE(AccountRegistry::Update(
+            unit_, Identifier::Random(), false, i));
+    }
+
+    ASSERT_EQ(1050, AccountRegistry::TotalBalance(unit_));
+    ASSERT_EQ(3u, AccountRegistry::Count(unit_));
+}
+
+TEST_F(Test_AccountRegistry, visit)
+{
+    add_accounts();
+    ASSERT_TRUE(AccountRegistry::Update(unit_, bob_, false, 60));
+
+    std::map<std::string, std::int64_t> visited{};
+
+    ASSERT_TRUE(AccountRegistry::Visit(
+        unit_,
+        [&](const std::string& accountID, const std::int64_t balance) -> bool {
+            visited.emplace(accountID, balance);
+
+            return true;
+        }));
+    ASSERT_EQ(3u, visited.size());
+    ASSERT_EQ(-150, visited.at(issuer_.str()));
+    ASSERT_EQ(100, visited.at(alice_.str()));
+    ASSERT_EQ(60, visited.at(bob_.str()));
+
+    std::size_t count{0};
+
+    ASSERT_TRUE(AccountRegistry::Visit(
+        unit_, [&](const std::string&, const std::int64_t) -> bool {
+            ++count;
+
+            return false;
+        }));
+    ASSERT_EQ(1u, count);
+}
+
+TEST_F(Test_AccountRegistry, units_are_separate)
+{
+    add_accounts();
+    const auto other = Identifier::Random();
+
+    ASSERT_EQ(0u, AccountRegistry::Count(other));
+    ASSERT_EQ(0, AccountRegistry::TotalBalance(other));
+    ASSERT_FALSE(AccountRegistry::Exists(other, alice_));
+}
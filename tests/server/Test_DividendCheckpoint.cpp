@@ -0,0 +1,214 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/DividendCheckpoint.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace opentxs;
+using namespace opentxs::server;
+
+namespace
+{
+using State = DividendCheckpoint::State;
+
+class Test_DividendCheckpoint : public ::testing::Test
+{
+public:
+    const Identifier notary_{Identifier::Random()};
+    const Identifier shares_{Identifier::Random()};
+    const TransactionNumber number_{1000};
+    const DividendCheckpoint::Parameters parameters_{{"payer", "alice"},
+                                                     {"per_share", "2"}};
+
+    // Plans a payout of 600 owners, which is two full batches and a partial
+    // one
+    void plan(DividendCheckpoint& checkpoint)
+    {
+        auto& payments = checkpoint.Payments();
+
+        for (std::int64_t i = 0; i < 600; ++i) {
+            payments[std::to_string(100000 + i)].amount_ = i + 1;
+        }
+
+        ASSERT_TRUE(checkpoint.SaveHeader());
+        ASSERT_TRUE(checkpoint.Index(shares_));
+        ASSERT_TRUE(checkpoint.SavePlan());
+    }
+
+    void set_batch(
+        DividendCheckpoint& checkpoint,
+        const std::size_t index,
+        const State state)
+    {
+        for (auto* it : checkpoint.Batches().at(index)) {
+            it->second.number_ = 5000 + it->second.amount_;
+            it->second.state_ = state;
+        }
+    }
+};
+}  // namespace
+
+TEST_F(Test_DividendCheckpoint, plan_is_cut_into_batches)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+    plan(checkpoint);
+    const auto& batches = checkpoint.Batches();
+
+    ASSERT_TRUE(checkpoint.Planned());
+    ASSERT_EQ(3u, batches.size());
+    ASSERT_EQ(256u, batches.at(0).size());
+    ASSERT_EQ(256u, batches.at(1).size());
+    ASSERT_EQ(88u, batches.at(2).size());
+    ASSERT_EQ("100000", batches.at(0).front()->first);
+    ASSERT_EQ("100599", batches.at(2).back()->first);
+}
+
+TEST_F(Test_DividendCheckpoint, header_only)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+
+    ASSERT_FALSE(checkpoint.Exists());
+    ASSERT_TRUE(checkpoint.SaveHeader());
+    ASSERT_TRUE(checkpoint.Index(shares_));
+
+    DividendCheckpoint loaded(notary_, number_);
+
+    ASSERT_TRUE(loaded.Load());
+    ASSERT_FALSE(loaded.Planned());
+    ASSERT_EQ(parameters_, loaded.Params());
+    ASSERT_TRUE(loaded.Payments().empty());
+}
+
+TEST_F(Test_DividendCheckpoint, resume_from_batches)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+    plan(checkpoint);
+    set_batch(checkpoint, 0, State::Paid);
+    ASSERT_TRUE(checkpoint.SaveBatch(0));
+    set_batch(checkpoint, 1, State::Pending);
+    ASSERT_TRUE(checkpoint.SaveBatch(1));
+
+    DividendCheckpoint loaded(notary_, number_);
+
+    ASSERT_TRUE(loaded.Load());
+    ASSERT_TRUE(loaded.Planned());
+    ASSERT_EQ(parameters_, loaded.Params());
+    ASSERT_EQ(600u, loaded.Payments().size());
+    ASSERT_EQ(3u, loaded.Batches().size());
+
+    for (const auto* it : loaded.Batches().at(0)) {
+        ASSERT_EQ(State::Paid, it->second.state_);
+        ASSERT_EQ(5000 + it->second.amount_, it->second.number_);
+    }
+
+    for (const auto* it : loaded.Batches().at(1)) {
+        ASSERT_EQ(State::Pending, it->second.state_);
+        ASSERT_EQ(5000 + it->second.amount_, it->second.number_);
+    }
+
+    for (const auto* it : loaded.Batches().at(2)) {
+        ASSERT_EQ(State::Planned, it->second.state_);
+        ASSERT_EQ(0, it->second.number_);
+    }
+}
+
+// Saving a batch writes that batch and nothing else
+TEST_F(Test_DividendCheckpoint, save_batch_is_a_delta)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+    plan(checkpoint);
+    set_batch(checkpoint, 0, State::Paid);
+    set_batch(checkpoint, 2, State::Undelivered);
+    ASSERT_TRUE(checkpoint.SaveBatch(2));
+
+    DividendCheckpoint loaded(notary_, number_);
+
+    ASSERT_TRUE(loaded.Load());
+
+    for (const auto* it : loaded.Batches().at(0)) {
+        ASSERT_EQ(State::Planned, it->second.state_);
+    }
+
+    for (const auto* it : loaded.Batches().at(2)) {
+        ASSERT_EQ(State::Undelivered, it->second.state_);
+    }
+}
+
+TEST_F(Test_DividendCheckpoint, leftover)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+    plan(checkpoint);
+    auto& leftover = checkpoint.Leftover();
+    leftover.amount_ = 42;
+    leftover.number_ = 7;
+    leftover.state_ = State::Pending;
+    ASSERT_TRUE(checkpoint.SaveHeader());
+
+    DividendCheckpoint loaded(notary_, number_);
+
+    ASSERT_TRUE(loaded.LoadHeader());
+    ASSERT_TRUE(loaded.Planned());
+    ASSERT_TRUE(loaded.Payments().empty());
+    ASSERT_EQ(42, loaded.Leftover().amount_);
+    ASSERT_EQ(7, loaded.Leftover().number_);
+    ASSERT_EQ(State::Pending, loaded.Leftover().state_);
+}
+
+TEST_F(Test_DividendCheckpoint, index_and_erase)
+{
+    DividendCheckpoint checkpoint(notary_, number_, parameters_);
+    plan(checkpoint);
+    const auto listed = DividendCheckpoint::List(notary_);
+
+    ASSERT_EQ(1u, listed.size());
+    ASSERT_EQ(String(shares_).Get(), listed.at(number_));
+    ASSERT_TRUE(checkpoint.SaveBatch(1));
+    ASSERT_TRUE(checkpoint.Erase());
+    ASSERT_FALSE(checkpoint.Exists());
+    ASSERT_TRUE(DividendCheckpoint::List(notary_).empty());
+
+    DividendCheckpoint loaded(notary_, number_);
+
+    ASSERT_FALSE(loaded.Load());
+}
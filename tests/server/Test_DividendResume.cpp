@@ -0,0 +1,212 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/DividendCheckpoint.hpp"
+#include "opentxs/server/DividendPayout.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+using namespace opentxs::server;
+
+namespace
+{
+using State = DividendCheckpoint::State;
+
+const std::size_t owners_{600};
+const std::int64_t leftover_{100};
+// Part way through the second batch
+const std::size_t crash_after_{300};
+
+struct Crash {
+};
+
+class TestServices : public DividendPayout::Services
+{
+public:
+    const Identifier notary_{Identifier::Random()};
+    std::size_t crash_after_{0};
+    mutable std::size_t delivered_{0};
+    mutable TransactionNumber next_{5000};
+    mutable std::map<std::string, std::vector<TransactionNumber>> numbers_{};
+    mutable std::map<std::string, std::int64_t> amounts_{};
+    mutable std::vector<std::string> notices_{};
+
+    const Identifier& NotaryID() const override { return notary_; }
+
+    bool IssueNumber(TransactionNumber& number) const override
+    {
+        number = next_++;
+
+        return true;
+    }
+
+    void Notify(const Identifier&, const std::string& text) const override
+    {
+        notices_.push_back(text);
+    }
+
+    bool Pay(
+        const Identifier& recipient,
+        const Identifier&,
+        const Identifier&,
+        const String&,
+        const std::int64_t amount,
+        const TransactionNumber number) const override
+    {
+        if ((0 < crash_after_) && (crash_after_ == delivered_)) {
+            throw Crash();
+        }
+
+        ++delivered_;
+        const std::string id = String(recipient).Get();
+        numbers_[id].push_back(number);
+        amounts_[id] = amount;
+
+        return true;
+    }
+
+    std::shared_ptr<const UnitDefinition> Unit(const Identifier&) const override
+    {
+        return {};
+    }
+};
+
+class Test_DividendResume : public ::testing::Test
+{
+public:
+    TestServices services_{};
+    const Identifier payer_{Identifier::Random()};
+    const Identifier shares_{Identifier::Random()};
+    const TransactionNumber number_{1000};
+    std::int64_t total_{0};
+
+    // Writes a planned payout the way Run does before paying anybody
+    void plan()
+    {
+        std::map<std::string, std::int64_t> amounts{};
+
+        for (std::size_t i = 0; i < owners_; ++i) {
+            const std::int64_t amount = i + 1;
+            amounts[String(Identifier::Random()).Get()] = amount;
+            total_ += amount;
+        }
+
+        total_ += leftover_;
+        const DividendCheckpoint::Parameters parameters{
+            {"payer", String(payer_).Get()},
+            {"shares", String(shares_).Get()},
+            {"payout", String(Identifier::Random()).Get()},
+            {"voucher_account", String(Identifier::Random()).Get()},
+            {"memo", "dividend"},
+            {"per_share", "1"},
+            {"total_cost", std::to_string(total_)}};
+        DividendCheckpoint checkpoint(
+            services_.NotaryID(), number_, parameters);
+
+        for (const auto& it : amounts) {
+            checkpoint.Payments()[it.first].amount_ = it.second;
+        }
+
+        ASSERT_TRUE(checkpoint.SaveHeader());
+        ASSERT_TRUE(checkpoint.Index(shares_));
+        ASSERT_TRUE(checkpoint.SavePlan());
+    }
+};
+}  // namespace
+
+TEST_F(Test_DividendResume, crash_then_resume)
+{
+    plan();
+    services_.crash_after_ = crash_after_;
+
+    EXPECT_THROW(DividendPayout::Resume(services_), Crash);
+    ASSERT_EQ(crash_after_, services_.delivered_);
+
+    DividendCheckpoint interrupted(services_.NotaryID(), number_);
+
+    ASSERT_TRUE(interrupted.Load());
+    ASSERT_EQ(3u, interrupted.Batches().size());
+
+    for (const auto* it : interrupted.Batches().at(0)) {
+        EXPECT_EQ(State::Paid, it->second.state_);
+    }
+
+    for (const auto* it : interrupted.Batches().at(1)) {
+        EXPECT_EQ(State::Pending, it->second.state_);
+        EXPECT_NE(0, it->second.number_);
+    }
+
+    for (const auto* it : interrupted.Batches().at(2)) {
+        EXPECT_EQ(State::Planned, it->second.state_);
+    }
+
+    services_.crash_after_ = 0;
+    DividendPayout::Resume(services_);
+
+    // Every owner and the payer were paid, and a voucher which was sent
+    // twice kept its number
+    ASSERT_EQ(owners_ + 1, services_.numbers_.size());
+
+    for (const auto& it : services_.numbers_) {
+        const std::set<TransactionNumber> unique(
+            it.second.begin(), it.second.end());
+
+        EXPECT_EQ(1u, unique.size());
+    }
+
+    for (const auto* it : interrupted.Batches().at(0)) {
+        EXPECT_EQ(1u, services_.numbers_.at(it->first).size());
+    }
+
+    EXPECT_EQ(leftover_, services_.amounts_.at(String(payer_).Get()));
+    ASSERT_FALSE(services_.notices_.empty());
+    EXPECT_NE(
+        std::string::npos, services_.notices_.back().find("is finished"));
+    EXPECT_TRUE(DividendCheckpoint::List(services_.NotaryID()).empty());
+    EXPECT_FALSE(interrupted.Exists());
+}
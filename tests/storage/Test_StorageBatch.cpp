@@ -0,0 +1,174 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/storage/Storage.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+
+#include <chrono>
+#include <future>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentxs;
+
+#define WRITER_THREADS 8
+#define WRITES_PER_THREAD 25
+
+namespace
+{
+std::string random_id() { return String(Identifier::Random()).Get(); }
+
+class Test_StorageBatch : public ::testing::Test
+{
+public:
+    const api::storage::Storage& db_{OT::App().DB()};
+    const std::string nym_{random_id()};
+
+    bool create_thread(const std::string& threadID) const
+    {
+        return db_.CreateThread(nym_, threadID, {random_id()});
+    }
+
+    std::size_t count() const { return db_.ThreadList(nym_, false).size(); }
+};
+}  // namespace
+
+TEST_F(Test_StorageBatch, changes_are_visible_inside_batch)
+{
+    db_.BeginBatch();
+
+    EXPECT_TRUE(create_thread(random_id()));
+    EXPECT_TRUE(create_thread(random_id()));
+    EXPECT_TRUE(create_thread(random_id()));
+    EXPECT_EQ(3, count());
+    EXPECT_TRUE(db_.EndBatch());
+    EXPECT_EQ(3, count());
+}
+
+TEST_F(Test_StorageBatch, nested_batches)
+{
+    db_.BeginBatch();
+
+    EXPECT_TRUE(create_thread(random_id()));
+
+    db_.BeginBatch();
+
+    EXPECT_TRUE(create_thread(random_id()));
+    EXPECT_TRUE(db_.EndBatch());
+    EXPECT_TRUE(create_thread(random_id()));
+    EXPECT_EQ(3, count());
+    EXPECT_TRUE(db_.EndBatch());
+    EXPECT_EQ(3, count());
+}
+
+TEST_F(Test_StorageBatch, scope_guard)
+{
+    const auto threadID = random_id();
+
+    {
+        api::storage::Batch batch(db_);
+
+        EXPECT_TRUE(create_thread(threadID));
+        EXPECT_TRUE(db_.SetThreadAlias(nym_, threadID, "alias"));
+    }
+
+    EXPECT_EQ(1, count());
+    EXPECT_EQ("alias", db_.ThreadAlias(nym_, threadID));
+}
+
+// A writer on another thread must not return before the batch which holds
+// its change back is committed
+TEST_F(Test_StorageBatch, writer_waits_for_open_batch)
+{
+    db_.BeginBatch();
+    auto writer = std::async(std::launch::async, [&]() -> bool {
+        return create_thread(random_id());
+    });
+
+    EXPECT_EQ(
+        std::future_status::timeout,
+        writer.wait_for(std::chrono::milliseconds(200)));
+    EXPECT_TRUE(db_.EndBatch());
+    EXPECT_TRUE(writer.get());
+    EXPECT_EQ(1, count());
+}
+
+TEST_F(Test_StorageBatch, concurrent_save)
+{
+    std::vector<std::thread> writers{};
+    std::vector<std::vector<std::string>> created(WRITER_THREADS);
+
+    for (int i = 0; i < WRITER_THREADS; ++i) {
+        writers.emplace_back([&, i]() -> void {
+            for (int n = 0; n < WRITES_PER_THREAD; ++n) {
+                const auto threadID = random_id();
+
+                if (create_thread(threadID)) {
+                    created[i].push_back(threadID);
+                }
+            }
+        });
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    EXPECT_EQ(WRITER_THREADS * WRITES_PER_THREAD, count());
+
+    std::set<std::string> listed{};
+
+    for (const auto& thread : db_.ThreadList(nym_, false)) {
+        listed.insert(thread.first);
+    }
+
+    for (const auto& ids : created) {
+        EXPECT_EQ(WRITES_PER_THREAD, ids.size());
+
+        for (const auto& threadID : ids) {
+            EXPECT_EQ(1, listed.count(threadID));
+        }
+    }
+}
@@ -0,0 +1,188 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/storage/drivers/StorageThrottle.hpp"
+#include "opentxs/storage/Plugin.hpp"
+#include "opentxs/storage/StorageConfig.hpp"
+#include "opentxs/OT.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+StorageConfig test_config_{};
+Digest test_digest_{};
+Random test_random_{};
+
+// Keeps both buckets in memory
+class MemoryPlugin : public opentxs::Plugin
+{
+public:
+    bool EmptyBucket(const bool bucket) const override
+    {
+        Lock lock(lock_);
+        buckets_[bucket].clear();
+
+        return true;
+    }
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const override
+    {
+        Lock lock(lock_);
+        const auto& objects = buckets_[bucket];
+        const auto it = objects.find(key);
+
+        if (objects.end() == it) {
+
+            return false;
+        }
+
+        value = it->second;
+
+        return true;
+    }
+    std::string LoadRoot() const override { return root_; }
+    bool StoreRoot(const bool, const std::string& hash) const override
+    {
+        root_ = hash;
+
+        return true;
+    }
+    void Cleanup() override {}
+
+    std::size_t Count(const bool bucket) const
+    {
+        Lock lock(lock_);
+
+        return buckets_[bucket].size();
+    }
+
+    MemoryPlugin(const Flag& bucket)
+        : opentxs::Plugin(
+              OT::App().DB(),
+              test_config_,
+              test_digest_,
+              test_random_,
+              bucket)
+    {
+    }
+
+private:
+    mutable std::mutex lock_{};
+    mutable std::map<std::string, std::string> buckets_[2]{};
+    mutable std::string root_{};
+
+    void store(
+        const bool,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const override
+    {
+        Lock lock(lock_);
+        buckets_[bucket][key] = value;
+        lock.unlock();
+
+        if (nullptr != promise) {
+            promise->set_value(true);
+        }
+    }
+};
+
+class Test_StorageThrottle : public ::testing::Test
+{
+public:
+    OTFlag bucket_{Flag::Factory(false)};
+    MemoryPlugin plugin_{bucket_};
+    StorageThrottle throttle_{plugin_, 0};
+};
+}  // namespace
+
+TEST_F(Test_StorageThrottle, target_is_wrapped_driver)
+{
+    ASSERT_EQ(&plugin_, &throttle_.Target());
+    ASSERT_EQ(&plugin_, &plugin_.Target());
+}
+
+// Garbage collection toggles the current bucket, migrates every live object
+// through the throttle, then empties the old bucket
+TEST_F(Test_StorageThrottle, gc_cycle_empties_old_bucket)
+{
+    const std::map<std::string, std::string> live{
+        {"one", "first"}, {"two", "second"}, {"three", "third"}};
+    const bool oldBucket{bucket_.get()};
+
+    for (const auto& it : live) {
+        ASSERT_TRUE(plugin_.Store(false, it.first, it.second, oldBucket));
+    }
+
+    ASSERT_TRUE(plugin_.Store(false, "garbage", "unreferenced", oldBucket));
+
+    // Objects written since the toggle are already in the new bucket
+    bucket_->Toggle();
+    const bool newBucket{bucket_.get()};
+    ASSERT_NE(oldBucket, newBucket);
+    ASSERT_TRUE(plugin_.Store(false, "two", "second", newBucket));
+
+    for (const auto& it : live) {
+        ASSERT_TRUE(plugin_.Migrate(it.first, throttle_));
+    }
+
+    ASSERT_FALSE(plugin_.Migrate("missing", throttle_));
+    ASSERT_TRUE(throttle_.EmptyBucket(oldBucket));
+    ASSERT_EQ(0u, plugin_.Count(oldBucket));
+    ASSERT_EQ(live.size(), plugin_.Count(newBucket));
+
+    for (const auto& it : live) {
+        std::string value{};
+
+        ASSERT_TRUE(plugin_.LoadFromBucket(it.first, value, newBucket));
+        ASSERT_EQ(it.second, value);
+        ASSERT_TRUE(plugin_.Load(it.first, false, value));
+    }
+}
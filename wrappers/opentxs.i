@@ -22,6 +22,7 @@
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
 #include "opentxs/network/zeromq/ListenCallback.hpp"
 #include "opentxs/network/zeromq/ListenCallbackSwig.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
@@ -33,6 +34,7 @@
 #include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
 #include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/network/zeromq/Socket.hpp"
 #include "opentxs/network/zeromq/SubscribeSocket.hpp"
 #include "opentxs/ui/ActivitySummary.hpp"
@@ -100,6 +102,8 @@ typedef int64_t time64_t;
 %include "../../include/opentxs/network/zeromq/ReplyCallback.hpp"
 %include "../../include/opentxs/network/zeromq/ReplySocket.hpp"
 %include "../../include/opentxs/network/zeromq/RequestSocket.hpp"
+%include "../../include/opentxs/network/zeromq/RouterSocket.hpp"
+%include "../../include/opentxs/network/zeromq/DealerSocket.hpp"
 %include "../../include/opentxs/network/zeromq/PairSocket.hpp"
 %include "../../include/opentxs/network/zeromq/Context.hpp"
 %include "../../include/opentxs/client/SwigWrap.hpp"